@@ -0,0 +1,84 @@
+#ifndef _CONFIG_STORE_H_
+#define _CONFIG_STORE_H_
+
+#include <Arduino.h>
+#include <stddef.h>
+
+// Settings record held in flash, so a site can be retuned over serial
+// without a rebuild and reflash. Shared by Flood Magnet and Flood Falcon,
+// keep the copies identical. Each sketch defines its own deviceConfig
+// and field list in DeviceConfig.h/.cpp, the #defines in its config
+// header are the defaults.
+//
+// Fields may only be added at the end of deviceConfig, bumping
+// CONFIG_VERSION. An older record is loaded over the defaults, so new
+// fields keep their default values. A blank or corrupt record is
+// ignored and the defaults are used.
+//
+// The record has two flash rows of its own at the top of the lower half
+// of flash. The sketch image sits below it and ArduinoOTA stages updates
+// in the upper half, so an OTA update never reads or erases it (see
+// FloodOTA.h). Uploading over USB erases it.
+
+#define CONFIG_MAGIC 0x46444C46UL  // "FLDF"
+#define CONFIG_DATA_LEN 248
+#define CONFIG_LINE_LEN 96
+#define FLASH_SKETCH_START 0x2000  // After the SAMD bootloader
+#define CONFIG_FLASH_LEN 512       // Two erase rows
+#define CONFIG_FLASH_ADDR (FLASH_SKETCH_START + (FLASH_SIZE - FLASH_SKETCH_START) / 2 - CONFIG_FLASH_LEN)
+
+enum config_types { CFG_STR,
+                    CFG_SECRET,  // String, not printed
+                    CFG_U16,
+                    CFG_U32 };
+
+struct configField {
+  const char* name;
+  uint8_t type;
+  uint16_t offset;
+  uint16_t size;
+};
+
+#define CONFIG_FIELD(type, member) \
+  { #member, type, offsetof(deviceConfig, member), sizeof(((deviceConfig*)0)->member) }
+
+struct configRecord {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t length;  // Bytes of data in use
+  uint32_t crc;     // CRC-32 of the data in use
+  uint8_t data[CONFIG_DATA_LEN];
+};
+
+static_assert(sizeof(configRecord) <= CONFIG_FLASH_LEN, "configRecord too big for its flash rows");
+
+uint32_t crc32(const uint8_t* data, size_t len);
+
+class ConfigStore {
+public:
+  ConfigStore(void* config, size_t len, uint16_t version, const configField* fields, size_t numFields)
+    : _config((uint8_t*)config), _len(len), _version(version), _fields(fields), _numFields(numFields){};
+  // 1 if loaded, 2 if loaded from an older version, 0 if defaults are in use
+  int load(void);
+  // False if the sketch reaches into the record's flash rows
+  bool save(void);
+  void clear(void);
+  bool set(const char* name, const char* value);
+  void print(Stream& out);
+  // Serial provisioning: "config", "set <name> <value>", "save", "clear"
+  void poll(Stream& in);
+
+private:
+  uint8_t* _config;
+  size_t _len;
+  uint16_t _version;
+  const configField* _fields;
+  size_t _numFields;
+  char _line[CONFIG_LINE_LEN];
+  uint8_t _lineLen = 0;
+
+  const configField* find(const char* name);
+  void command(Stream& out);
+};
+
+#endif
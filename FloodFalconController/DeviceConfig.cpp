@@ -0,0 +1,31 @@
+#include "DeviceConfig.h"
+
+static_assert(sizeof(deviceConfig) <= CONFIG_DATA_LEN, "deviceConfig too big for the flash record");
+
+deviceConfig config = {
+  SECRET_SSID,
+  SECRET_PASS,
+  AREA_CODE,
+  ALERT_INTERVAL,
+  DEMO_INTERVAL,
+  WINGS_START,
+  WINGS_DOWN,
+  WINGS_UP_A_BIT,
+  WINGS_UP_A_LOT,
+  OTA_KEY,
+};
+
+static const configField fields[] = {
+  CONFIG_FIELD(CFG_STR, ssid),
+  CONFIG_FIELD(CFG_SECRET, pass),
+  CONFIG_FIELD(CFG_STR, area),
+  CONFIG_FIELD(CFG_U32, alertInterval),
+  CONFIG_FIELD(CFG_U32, demoInterval),
+  CONFIG_FIELD(CFG_U16, wingsStart),
+  CONFIG_FIELD(CFG_U16, wingsDown),
+  CONFIG_FIELD(CFG_U16, wingsUpABit),
+  CONFIG_FIELD(CFG_U16, wingsUpALot),
+  CONFIG_FIELD(CFG_SECRET, otaKey),
+};
+
+ConfigStore configStore = ConfigStore(&config, sizeof(config), CONFIG_VERSION, fields, sizeof(fields) / sizeof(fields[0]));
@@ -0,0 +1,27 @@
+#ifndef _DEVICE_CONFIG_H_
+#define _DEVICE_CONFIG_H_
+
+#include "ConfigStore.h"
+#include "falcon_config.h"
+
+#define CONFIG_VERSION 2
+
+// Settings that can be changed at runtime, defaults from falcon_config.h.
+// Only add fields at the end, and bump CONFIG_VERSION when you do.
+struct deviceConfig {
+  char ssid[33];
+  char pass[64];
+  char area[24];           // Flood area code
+  uint32_t alertInterval;  // ms
+  uint32_t demoInterval;   // ms
+  uint16_t wingsStart;     // Servo pulse lengths
+  uint16_t wingsDown;
+  uint16_t wingsUpABit;
+  uint16_t wingsUpALot;
+  char otaKey[65];  // Version 2, 64 hex digits
+};
+
+extern deviceConfig config;
+extern ConfigStore configStore;
+
+#endif
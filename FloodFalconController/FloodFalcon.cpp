@@ -6,59 +6,61 @@ FloodFalcon::FloodFalcon(Adafruit_Soundboard *sfx, Adafruit_PWMServoDriver *pwm,
   _warning = warning;  
 }
 
+// Wing positions and speed for each animation
+struct flapProfile {
+  const uint16_t* up_pos;  // Pulse length in the runtime config
+  int speed_idx;
+};
+
+static const flapProfile flapProfiles[] = {
+  { &config.wingsDown, VSLOW },    // ANIM_NONE
+  { &config.wingsDown, VSLOW },    // ANIM_START
+  { &config.wingsUpABit, VSLOW },  // ANIM_BIT_VSLOW
+  { &config.wingsUpALot, VFAST },  // ANIM_LOT_VFAST
+  { &config.wingsUpABit, FAST },   // ANIM_BIT_FAST
+  { &config.wingsUpABit, SLOW },   // ANIM_BIT_SLOW
+};
+
 void FloodFalcon::init(int servo, uint16_t pos) {
   _servo = servo;
+  _pulselen = config.wingsStart;
   StartPos(pos);
   state = INIT;
+  previous_state = INIT;
 }
 
 int FloodFalcon::doAction(boolean audio) {
   Serial.println("Activating...");
   Serial.print("State: ");
   Serial.println(state);
-  switch (state) {
-    case NONE:
-      Serial.println("Wings up a bit, very slowly");
-      Tweet(NONE, audio);
-      Flap(WINGS_DOWN, WINGS_UP_A_BIT, VSLOW, 10);
-      break;
-    case SEVERE_FLOOD_WARNING:
-      Serial.println("Wings up alot, very fast");
-      Tweet(SEVERE_FLOOD_WARNING, audio);
-      Flap(WINGS_DOWN, WINGS_UP_A_LOT, VFAST, 10);      
-      break;
-    case FLOOD_WARNING:
-      Serial.println("Wings up a bit, fast");
-      Tweet(FLOOD_WARNING, audio);
-      Flap(WINGS_DOWN, WINGS_UP_A_BIT, FAST, 10);      
-      break;
-    case FLOOD_ALERT:
-      Serial.println("Wings down, wings up a bit");
-      Tweet(FLOOD_ALERT, audio);
-      Flap(WINGS_DOWN, WINGS_UP_A_BIT, SLOW, 10);      
-      break;
-    case NO_LONGER:
-      Serial.println("Wings down, wings up a bit, slowly");
-      Tweet(NO_LONGER, audio);
-      Flap(WINGS_DOWN, WINGS_UP_A_BIT, VSLOW, 10);      
-      break;
-    case INIT:
-      Serial.println("Wings down");
-      StartPos(WINGS_DOWN);
-      Tweet(INIT, audio);
-      break;
-  }
+  const stateAction& action = transition(previous_state, (warning_levels)state);
+  Tweet(action.track, audio);
+  Animate(action.animation);
   return state;
 }
 
 // Sets the rules for changing state
 int FloodFalcon::updateState() {
   Serial.println("Updating state...");
-  //_warning->severityLevel = 1;  // mock  
-  state = _warning->severityLevel;
+  //_warning->severityLevel = 1;  // mock
+  previous_state = (warning_levels)state;
+  state = toLevel(_warning->severityLevel);
   return state;
 }
 
+void FloodFalcon::Animate(uint8_t animation) {
+  switch (animation) {
+    case ANIM_NONE:
+      break;
+    case ANIM_START:
+      StartPos(config.wingsDown);
+      break;
+    default:
+      Flap(config.wingsDown, *flapProfiles[animation].up_pos, flapProfiles[animation].speed_idx, 10);
+      break;
+  }
+}
+
 void FloodFalcon::StartPos(uint16_t start_pos) {
   // Move wings to start position
   for (; _pulselen < start_pos; _pulselen++) {
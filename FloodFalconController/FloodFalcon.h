@@ -4,16 +4,18 @@
 #include <Adafruit_PWMServoDriver.h>
 #include <Adafruit_Soundboard.h>
 #include "falcon_config.h"
+#include "DeviceConfig.h"
+#include "FloodTime.h"
+#include "FloodStates.h"
+#include "SeverityFilter.h"
 
 #define DATESTR_LEN 17  // "2022-12-19T15:20:31" -> "2022-12-19 15:20"
 #define FLOOD_AREA_LEN 12 // Flood area description
 
 enum flap_speeds {VFAST = 1, FAST = 2, SLOW = 4, VSLOW = 8};
 
-enum warning_levels {NONE, SEVERE_FLOOD_WARNING, FLOOD_WARNING, FLOOD_ALERT, NO_LONGER, INIT};
-
 struct floodWarning {
-    char time_raised[DATESTR_LEN] = {'\0'};
+    uint32_t time_raised = 0;  // Seconds since 1970 UTC, 0 if not known
     int severityLevel = 0;
     char flood_area_id[FLOOD_AREA_LEN] = {'\0'};
 };
@@ -22,12 +24,13 @@ class FloodFalcon {
   public:
     floodWarning * _warning; // Flood warning data
     int state;
+    warning_levels previous_state = INIT;
     FloodFalcon(Adafruit_Soundboard *sfx, Adafruit_PWMServoDriver *pwm, floodWarning *warning);
  private:
     Adafruit_PWMServoDriver *_pwm;
     Adafruit_Soundboard *_sfx;
     int _servo = 0;  // default servo 0
-    uint16_t _pulselen = WINGS_START;
+    uint16_t _pulselen = 0;
  public:
     void init(int servo, uint16_t pos);
     int doAction(boolean audio);
@@ -37,6 +40,7 @@ class FloodFalcon {
     void PassOut(uint16_t end_pos, int speed_idx);
     void Dead(uint16_t end_pos, int speed_idx);
     void Tweet(uint8_t track, boolean audio);
+    void Animate(uint8_t animation);
 };
 
 #endif
@@ -7,6 +7,8 @@
   Evert-arias EasyButton https://github.com/evert-arias/EasyButton
   Adafruit Soundboard https://github.com/adafruit/Adafruit_Soundboard_library
   Adafruit PWM Servo Driver https://github.com/adafruit/Adafruit-PWM-Servo-Driver-Library
+  Cristian Maglie FlashStorage https://github.com/cmaglie/FlashStorage
+  Andrassy ArduinoOTA https://github.com/JAndrassy/ArduinoOTA
 
   Author: Peter Milne
   Date: 28 Nov 2022
@@ -22,6 +24,7 @@
 #include <EasyButton.h>
 #include "FloodFalcon.h"
 #include "FloodFalconDisplay.h"
+#include "FloodOTA.h"
 
 const char* soft_version = "0.2.1";
 
@@ -33,6 +36,9 @@ const char* soft_version = "0.2.1";
 // Flood warning data
 static floodWarning warning;
 
+// Debounced severity
+SeverityFilter severityFilter = SeverityFilter(DEBOUNCE_READINGS, DEBOUNCE_TIME, STALE_FAILURES);
+
 WiFiClient client;
 
 // Servo board - default address 0x40
@@ -48,6 +54,7 @@ FloodFalconDisplay epd = FloodFalconDisplay(&myFalcon);
 int status = WL_IDLE_STATUS;
 boolean updateDisplayFlag = false;
 unsigned long lastReconnectAttempt = 0;
+unsigned long lastAgeRender = 0;
 boolean playBackFlag = false;
 
 // Define pins
@@ -60,7 +67,7 @@ EasyButton rightButton(rButton);  // RH button
 EasyButton leftButton(lButton);   // LH button
 EasyButton demoButton(dButton);   // External demo button
 
-int demo_state = NONE;
+warning_levels demo_state = NONE;
 
 void setup() {
   pinMode(wifiLed, OUTPUT);
@@ -81,6 +88,9 @@ void setup() {
   Serial.print("Starting client version: ");
   Serial.println(soft_version);
 
+  // Saved settings override the config header, type "config" to list them
+  configStore.load();
+
   Serial.println("Serial1 attached");
 
   // Initialize buttons
@@ -103,7 +113,7 @@ void setup() {
   pwm.setPWMFreq(SERVO_FREQ);  // Analog servos run at ~50 Hz updates
   delay(1000);
 
-  myFalcon.init(SERVO, WINGS_DOWN);  // Set statrting posture
+  myFalcon.init(SERVO, config.wingsDown);  // Set statrting posture
   myFalcon.doAction(epd.audioOn);    // Trigger intro action
 
   leftButton.read();
@@ -120,6 +130,7 @@ void loop() {
   rightButton.read();
   leftButton.read();
   demoButton.read();
+  configStore.poll(Serial);
 
   if (!epd.demoOn) {  // Standard mode
     if (WiFi.status() != WL_CONNECTED) {
@@ -132,30 +143,62 @@ void loop() {
         digitalWrite(wifiLed, HIGH);
         epd.wifiOn = true;
         Serial.println("Wifi connected...");
+        clockSync(WiFi.getTime());  // NTP, 0 if not yet available
       }
       doUpdate();  // Initial update
+      checkOTA(true);
     }
     unsigned long now = millis();
-    if ((now - lastReconnectAttempt > ALERT_INTERVAL) || (updateDisplayFlag) || (playBackFlag)) {
+    if ((now - lastReconnectAttempt > config.alertInterval) || (updateDisplayFlag) || (playBackFlag)) {
       updateDisplayFlag = false;
       playBackFlag = false;
 
       doUpdate();
       lastReconnectAttempt = now;
     }
+
+    checkOTA(false);
+
+    // Keep the "N min ago" line current between polls
+    uint32_t ageInterval = epd.ageInterval();
+    if (ageInterval && (now - lastAgeRender > ageInterval * 1000UL)) {
+      epd.updateAge();
+      lastAgeRender = now;
+    }
   } else {  // Demo mode - reset to exit so everything re-initialises
     doDemo();
   }
 }
 
 void doUpdate() {
-  getData();
+  if (!getData()) {
+    // Hold the last level, only flag it once the failures add up
+    if (severityFilter.stale() && !epd.staleOn) {
+      epd.staleOn = true;
+      epd.updateDisplay();
+      lastAgeRender = millis();
+    }
+    return;
+  }
+  epd.staleOn = false;
   myFalcon.updateState();
   myFalcon.doAction(epd.audioOn);
   epd.updateDisplay();
+  lastAgeRender = millis();
   printData();
 }
 
+// Look for a firmware patch for this version, daily or when forced
+void checkOTA(bool force) {
+#ifdef OTA_HOST
+  static unsigned long lastCheck = 0;
+  if (WiFi.status() == WL_CONNECTED && (force || millis() - lastCheck > OTA_INTERVAL)) {
+    otaUpdate(OTA_HOST, OTA_PORT, "falcon", soft_version, config.otaKey);
+    lastCheck = millis();
+  }
+#endif
+}
+
 void doDemo() {
   warning.severityLevel = demo_state;
   myFalcon.updateState();
@@ -163,26 +206,8 @@ void doDemo() {
   myFalcon.doAction(epd.audioOn);
 
 
-  switch (demo_state) {
-    case NONE:
-      demo_state = FLOOD_ALERT;
-      break;
-    case SEVERE_FLOOD_WARNING:
-      demo_state = NO_LONGER;
-      break;
-    case FLOOD_WARNING:
-      demo_state = SEVERE_FLOOD_WARNING;
-      break;
-    case FLOOD_ALERT:
-      demo_state = FLOOD_WARNING;
-      break;
-    case NO_LONGER:
-      demo_state = NONE;
-      break;
-    default:
-      break;
-  }
-  delay(DEMO_INTERVAL);  // Delay between state change
+  demo_state = demoNext[demo_state];
+  delay(config.demoInterval);  // Delay between state change
 }
 
 int reconnectWiFi() {
@@ -196,22 +221,25 @@ int reconnectWiFi() {
 
   WiFi.disconnect();  // Force a disconnect
   delay(1000);
-  // Creds from arduino_secrets.h
-  WiFi.begin(SECRET_SSID, SECRET_PASS);
+  // Creds from the runtime config, defaults in falcon_config.h
+  WiFi.begin(config.ssid, config.pass);
   return WiFi.status();
 }
 
-void getData() {
+// Returns false if the poll failed, the warning is left as it was
+bool getData() {
   // Connect to host
   Serial.println("Connecting to environment.data.gov.uk");
   if (!client.connect("environment.data.gov.uk", 80)) {
     Serial.println("Failed to connect to server");
-    return;
+    severityFilter.failed();
+    return false;
   }
 
   // Send HTTP request
-  client.println("GET /flood-monitoring/id/floodAreas/" AREA_CODE
-                 " HTTP/1.0");
+  client.print("GET /flood-monitoring/id/floodAreas/");
+  client.print(config.area);
+  client.println(" HTTP/1.0");
   client.println("Host: environment.data.gov.uk");
   client.println("Connection: close");
   client.println();
@@ -224,11 +252,27 @@ void getData() {
     Serial.print("Unexpected HTTP status");
     Serial.println(status);
     client.stop();
-    return;
+    severityFilter.failed();
+    return false;
   }
 
-  // Skip response headers
-  client.find("\r\n\r\n");
+  // Read response headers, syncing the clock from the Date header
+  char header[64];
+  boolean partial = false;
+  while (true) {
+    size_t len = client.readBytesUntil('\n', header, sizeof(header) - 1);
+    header[len] = '\0';
+    if (!partial && len <= 1) {  // Blank line ends the headers
+      break;
+    }
+    if (!partial && strncmp(header, "Date: ", 6) == 0) {
+      uint32_t serverTime;
+      if (parseHttpDate(header + 6, &serverTime)) {
+        clockSync(serverTime);
+      }
+    }
+    partial = (len == sizeof(header) - 1);  // Rest of an overlong line follows
+  }
 
   // Stream& input;
   StaticJsonDocument<128> filter;
@@ -246,26 +290,27 @@ void getData() {
   if (error) {
     Serial.print("deserializeJson() failed: ");
     Serial.println(error.c_str());
-    return;
+    client.stop();
+    severityFilter.failed();
+    return false;
   }
 
   // Update warning struct
-  warning.severityLevel = doc["items"]["currentWarning"]["severityLevel"];                                               // 3
-                                                                                                                         //warning.severityLevel = 1; // mock level
-  if (warning.severityLevel) {                                                                                           // only update these items if the level is not zero
+  warning_levels reading = toLevel(doc["items"]["currentWarning"]["severityLevel"].as<int>());                          // 3
+                                                                                                                         //reading = SEVERE_FLOOD_WARNING; // mock level
+  warning.severityLevel = severityFilter.update(reading, millis());                                                      // debounced
+  if (reading && reading == warning.severityLevel) {                                                                     // only update these items if the level is not zero and accepted
     memcpy(warning.flood_area_id, doc["items"]["currentWarning"]["floodAreaID"].as<const char*>(), FLOOD_AREA_LEN - 1);  // "Tributaries between Dorchester and ...
 
-    memcpy(warning.time_raised, doc["items"]["currentWarning"]["timeRaised"].as<const char*>(), DATESTR_LEN - 1);  // "2022-12-19T15:20:31"
-    for (int i = 0; i < DATESTR_LEN; i++) {
-      if (warning.time_raised[i] == 'T') {
-        warning.time_raised[i] = ' ';
-      }
+    if (!parseIsoTime(doc["items"]["currentWarning"]["timeRaised"].as<const char*>(), &warning.time_raised)) {  // "2022-12-19T15:20:31"
+      warning.time_raised = 0;
     }
   }
   // Close the connection to the server
   client.stop();
 
   Serial.println("Flood data received!");
+  return true;
 }
 
 // Button callbacks
@@ -292,6 +337,18 @@ void printData() {
   Serial.print("Warning Level: ");
   Serial.println(warning.severityLevel);
 
+  char timeStr[DATESTR_LEN] = { '\0' };
+  if (warning.time_raised) {
+    formatTime(warning.time_raised, timeStr);
+  }
   Serial.print("Time Raised: ");
-  Serial.println(warning.time_raised);
+  Serial.println(timeStr);
+
+  Serial.print("Refreshes: ");
+  Serial.print(epd.refresh.fullRefreshes());
+  Serial.print(" full, ");
+  Serial.print(epd.refresh.partialRefreshes());
+  Serial.print(" partial, ");
+  Serial.print(epd.refresh.partials());
+  Serial.println(" since the last full");
 }
@@ -5,6 +5,9 @@ static char w1[5][12] = { "No Flood", "Severe", "Flood", "Flood", "Warning no" }
 static char w2[5][12] = { "Warnings", "Flood", "Warning", "Alert", "Longer in" };
 static char w3[5][12] = { "", "Warning", "", "", "Force" };
 
+// Background for each display template
+static const unsigned char* images[5] = { epd_flood_warning_removed, epd_flood_warning_severe, epd_flood_warning, epd_flood_alert, epd_flood_warning_removed };
+
 void FloodFalconDisplay::initDisplay(void) {
   if (_epd.Init() != 0) {
     return;
@@ -18,6 +21,7 @@ void FloodFalconDisplay::initDisplay(void) {
 
   _epd.SetFrameMemory_Base(RSLOGO);
   _epd.DisplayFrame();
+  refresh.fullDone(-1, millis());  // Not a severity screen, the first update is full
 }
 
 void FloodFalconDisplay::showGreeting(void) {
@@ -27,34 +31,35 @@ void FloodFalconDisplay::showGreeting(void) {
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 4, "  Flood  ", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 140, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 140, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 4, "  Falcon  ", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 4, "Concept:", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 80, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 80, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 4, "Jude Pullen", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 60, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 60, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 0, "Code:", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 20, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 20, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 0, "Pete Milne", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 0, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 0, _paint.GetWidth(), _paint.GetHeight());
 
-  _epd.DisplayFrame_Partial();
+  showStrips();
+  _overdrawn = true;
 }
 
 void FloodFalconDisplay::updateDisplay() {
   Serial.println("Updating display...");
-  int severityLevel = _falcon->_warning->severityLevel;
+  int tpl = levelTemplate(_falcon->_warning->severityLevel);
   // Index warning string based on severity level
   //int warning_idx = severityLevel ? severityLevel : 0;
   //  char single_digit[] = {'0', '\0'};
@@ -62,35 +67,21 @@ void FloodFalconDisplay::updateDisplay() {
   //  char three_digit[] = {'0', '/', '0', '\0'};
   //  char four_digit[] = {'0', '/', '0', '0',  '\0'};
   //
-  // Set background
-  if (_epd.Init() != 0) {
-    return;
-  }
-  _epd.ClearFrameMemory(0xFF);  // bit set = white, bit reset = black
-  _epd.DisplayFrame();
-
-  delay(500);
-  switch (severityLevel) {
-    case NONE:
-      _epd.SetFrameMemory_Base(epd_flood_warning_removed);
-      break;
-    case SEVERE_FLOOD_WARNING:
-      _epd.SetFrameMemory_Base(epd_flood_warning_severe);
-      break;
-    case FLOOD_WARNING:
-      _epd.SetFrameMemory_Base(epd_flood_warning);
-      break;
-    case FLOOD_ALERT:
-      _epd.SetFrameMemory_Base(epd_flood_alert);
-      break;
-    case NO_LONGER:
-      _epd.SetFrameMemory_Base(epd_flood_warning_removed);
-      break;
-    default:
-      break;
+  // Set background, in full only when the screen changes or ghosting
+  // has built up, see RefreshPolicy
+  if (refresh.fullDue(_falcon->_warning->severityLevel, millis())) {
+    if (_epd.Init() != 0) {
+      return;
+    }
+    // One full refresh drives every pixel through black and white,
+    // clearing to white first as well only doubled the flashing
+    _epd.SetFrameMemory_Base(images[tpl]);
+    _epd.DisplayFrame();
+    refresh.fullDone(_falcon->_warning->severityLevel, millis());
+  } else if (_overdrawn) {
+    writeStrip(images[tpl], 0, 0, EPD_WIDTH, EPD_HEIGHT);
   }
-
-  _epd.DisplayFrame();
+  _overdrawn = false;
 
   // Static text
   _paint.SetWidth(120);
@@ -102,16 +93,16 @@ void FloodFalconDisplay::updateDisplay() {
   // _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 140, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, w1[severityLevel], &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
+  _paint.DrawStringAt(0, 0, w1[tpl], &Font16, COLORED);
+  writeStrip(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, w2[severityLevel], &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 100, _paint.GetWidth(), _paint.GetHeight());
+  _paint.DrawStringAt(0, 0, w2[tpl], &Font16, COLORED);
+  writeStrip(_paint.GetImage(), 0, 100, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, w3[severityLevel], &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 80, _paint.GetWidth(), _paint.GetHeight());
+  _paint.DrawStringAt(0, 0, w3[tpl], &Font16, COLORED);
+  writeStrip(_paint.GetImage(), 0, 80, _paint.GetWidth(), _paint.GetHeight());
 
   // _paint.Clear(UNCOLORED);
   // _paint.DrawStringAt(0, 0, LINE_4, &Font16, COLORED);
@@ -119,11 +110,10 @@ void FloodFalconDisplay::updateDisplay() {
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 0, "Updated", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 40, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 40, _paint.GetWidth(), _paint.GetHeight());
 
-  _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, (_falcon->_warning->time_raised ? _falcon->_warning->time_raised : ""), &Font12, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 20, _paint.GetWidth(), _paint.GetHeight());
+  drawTimeRaised();
+  writeStrip(_paint.GetImage(), 0, 20, _paint.GetWidth(), _paint.GetHeight());
 
   // _paint.Clear(UNCOLORED);
   // _paint.DrawStringAt(0, 0, LINE_7, &Font16, COLORED);
@@ -137,6 +127,8 @@ void FloodFalconDisplay::updateDisplay() {
   _paint.Clear(UNCOLORED);
   if (demoOn) {
     _paint.DrawStringAt(0, 0, "Demo Mode", &Font16, COLORED);
+  } else if (staleOn) {
+    _paint.DrawStringAt(0, 0, "Data stale", &Font16, COLORED);
   } else if (audioOn && wifiOn) {
     _paint.DrawStringAt(0, 0, "Wifi Audio", &Font16, COLORED);
   } else if (wifiOn) {
@@ -146,7 +138,63 @@ void FloodFalconDisplay::updateDisplay() {
   } else {
     _paint.DrawStringAt(0, 0, "", &Font16, COLORED);
   }
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 0, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 0, _paint.GetWidth(), _paint.GetHeight());
+
+  showStrips();
+}
+
+// Timestamp and relative age, e.g. "2022-12-19 15:20" over "12 min ago"
+void FloodFalconDisplay::drawTimeRaised(void) {
+  char timeStr[DATESTR_LEN] = { '\0' };
+  char ageStr[AGE_STR_LEN] = { '\0' };
+  uint32_t raised = _falcon->_warning->time_raised;
+  if (raised) {
+    formatTime(raised, timeStr);
+    uint32_t now = clockNow();
+    if (now) {
+      formatAge(now > raised ? now - raised : 0, ageStr, sizeof(ageStr));
+    }
+  }
+  _paint.Clear(UNCOLORED);
+  _paint.DrawStringAt(0, 0, timeStr, &Font12, COLORED);
+  _paint.DrawStringAt(0, 14, ageStr, &Font12, COLORED);
+}
+
+// Re-render only the timestamp strip so the relative age stays current,
+// with the fast waveform
+void FloodFalconDisplay::updateAge(void) {
+  if (refresh.fullDue(_falcon->_warning->severityLevel, millis())) {
+    updateDisplay();  // Ghosting budget spent, redraw it all
+    return;
+  }
+  _paint.SetWidth(120);
+  _paint.SetHeight(40);
+  _paint.SetRotate(ROTATE_180);
+  _epd.SetWaveform(WAVEFORM_FAST);  // Only a line of small text changes
+
+  drawTimeRaised();
+  writeStrip(_paint.GetImage(), 0, 20, _paint.GetWidth(), _paint.GetHeight());
+  showStrips();
+  _epd.SetWaveform(WAVEFORM_PARTIAL);
+}
+
+// Seconds until the relative age shown on screen next changes
+uint32_t FloodFalconDisplay::ageInterval(void) {
+  uint32_t raised = _falcon->_warning->time_raised;
+  uint32_t now = clockNow();
+  if (!raised || !now || now < raised) {
+    return 0;
+  }
+  return ageRefreshInterval(now - raised);
+}
+
+void FloodFalconDisplay::writeStrip(const unsigned char* image, int x, int y, int width, int height) {
+  _epd.SetFrameMemory_Partial(image, x, y, width, height);
+  _stripArea += (uint32_t)width * height;
+}
 
+void FloodFalconDisplay::showStrips(void) {
   _epd.DisplayFrame_Partial();
+  refresh.partialDone(_stripArea, millis());
+  _stripArea = 0;
 }
@@ -4,6 +4,7 @@
 #include "FloodFalcon.h"
 #include "epd2in9_V2.h"
 #include "epdpaint.h"
+#include "RefreshPolicy.h"
 #include "img/rslogo.h"
 
 // Image converter https://javl.github.io/image2cpp/ 
@@ -23,15 +24,27 @@ class FloodFalconDisplay {
   bool wifiOn = false;
   bool demoOn = false;
   bool audioOn = true;
+  bool staleOn = false;  // Polls have been failing, the level shown is old
   unsigned char image[1024];
-  Epd _epd; // default reset: 8, dc: 9, cs: 10, busy: 7
+  Epd<Panel2in9> _epd;  // Pins in epdif.h
   Paint _paint = Paint(image, 0, 0);
   FloodFalcon* _falcon;
+  RefreshPolicy refresh = RefreshPolicy(REFRESH_MAX_PARTIALS, REFRESH_MAX_AREA, REFRESH_IDLE);
 
   FloodFalconDisplay(FloodFalcon* falcon) : _falcon(falcon) {};
   void initDisplay(void);
   void updateDisplay(void);
   void showGreeting(void);
+  void updateAge(void);
+  uint32_t ageInterval(void);
+
+  private:
+  bool _overdrawn = false;   // Greeting drawn over the screen
+  uint32_t _stripArea = 0;  // Pixels written since the last showStrips()
+
+  void drawTimeRaised(void);
+  void writeStrip(const unsigned char* image, int x, int y, int width, int height);
+  void showStrips(void);
 };
 
 #endif
@@ -0,0 +1,32 @@
+#ifndef _FLOOD_HMAC_H_
+#define _FLOOD_HMAC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// HMAC-SHA256 (RFC 2104, FIPS 180-4), fed a byte at a time. Shared by
+// Flood Magnet, Flood Falcon and FloodGateway's floodpatch tool, which
+// sign and check OTA patches with it. Keep the copies identical.
+
+#define HMAC_LEN 32      // Bytes of MAC
+#define HMAC_KEY_MAX 64  // Longest key, one SHA-256 block
+
+class HmacSha256 {
+public:
+  void begin(const uint8_t* key, size_t keyLen);
+  void update(uint8_t b);
+  void finish(uint8_t mac[HMAC_LEN]);
+
+private:
+  uint32_t _h[8];
+  uint8_t _block[64];
+  uint8_t _blockLen;
+  uint32_t _length;  // Bytes hashed, patches are well under 512 MB
+  uint8_t _key[HMAC_KEY_MAX];
+
+  void start(uint8_t pad);
+  void compress(void);
+  void digest(uint8_t out[HMAC_LEN]);
+};
+
+#endif
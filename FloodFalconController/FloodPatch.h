@@ -0,0 +1,101 @@
+#ifndef _FLOOD_PATCH_H_
+#define _FLOOD_PATCH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "FloodHmac.h"
+
+// Firmware delta patches, shared by Flood Magnet, Flood Falcon and
+// FloodGateway's floodpatch tool. Keep the copies identical.
+//
+// A patch rebuilds the new image from the running one. Header, little
+// endian: "FLP1", old length, old CRC-32, new length, new CRC-32. Then
+// ops, each a varint (length << 1 | type):
+//   type 0 ADD  - length literal bytes follow
+//   type 1 COPY - a zigzag varint follows, the offset in the old image
+//                 relative to the end of the previous copy
+// Fonts and images rarely change, so most of a release is COPY ops of
+// a few bytes each. The patch is applied as it streams in.
+//
+// After the ops, a 32 byte HMAC-SHA256 of everything before it, keyed
+// with the OTA key provisioned on the device. An image is only verified
+// if both its CRC and the MAC match, so only whoever holds the key can
+// make a patch a device will install.
+
+#define PATCH_MAGIC 0x31504C46UL  // "FLP1"
+#define PATCH_HEADER_LEN 20
+#define PATCH_KEY_LEN 32
+
+enum patch_ops { PATCH_ADD,
+                 PATCH_COPY };
+
+struct patchHeader {
+  uint32_t oldLen;
+  uint32_t oldCrc;
+  uint32_t newLen;
+  uint32_t newCrc;
+};
+
+// Where the running image is read from and the new one written to
+class PatchTarget {
+public:
+  virtual uint8_t readOld(uint32_t offset) = 0;
+  virtual bool write(uint8_t b) = 0;
+};
+
+class PatchApplier {
+public:
+  // The key must outlive the applier
+  PatchApplier(PatchTarget* target, const uint8_t key[PATCH_KEY_LEN]) : _target(target) {
+    _hmac.begin(key, PATCH_KEY_LEN);
+  }
+  // Feed patch bytes as they arrive, false on error
+  bool feed(const uint8_t* data, size_t len);
+  bool headerDone(void) { return _state > STATE_HEADER; }
+  const patchHeader& header(void) { return _header; }
+  uint32_t written(void) { return _written; }
+  // All of the new image written, its CRC and the patch MAC matched
+  bool verified(void) { return _state == STATE_DONE && _crc == _header.newCrc; }
+  const char* error(void) { return _error; }
+
+private:
+  enum states { STATE_HEADER,
+                STATE_CONTROL,
+                STATE_OFFSET,
+                STATE_LITERAL,
+                STATE_TAG,
+                STATE_DONE,
+                STATE_FAILED };
+  PatchTarget* _target;
+  patchHeader _header;
+  uint8_t _state = STATE_HEADER;
+  uint8_t _buf[PATCH_HEADER_LEN];
+  uint8_t _bufLen = 0;
+  uint32_t _var = 0;  // Varint being read
+  uint8_t _varShift = 0;
+  uint32_t _opLen = 0;
+  uint32_t _oldPos = 0;
+  uint32_t _written = 0;
+  uint32_t _crc = 0xFFFFFFFFUL;
+  HmacSha256 _hmac;
+  uint8_t _mac[HMAC_LEN];
+  uint8_t _tagLen = 0;
+  uint8_t _tagDiff = 0;  // Any bit set if the tag differs
+  const char* _error = NULL;
+
+  bool feedByte(uint8_t b);
+  bool readVarint(uint8_t b);
+  bool checkOld(void);
+  bool put(uint8_t b);
+  bool nextOp(void);
+  bool fail(const char* error);
+};
+
+// Running CRC-32, start from 0xFFFFFFFF and invert the result
+uint32_t patchCrc(uint32_t crc, uint8_t b);
+
+// OTA key from 64 hex digits, as floodpatch key prints it. False if it
+// is not exactly that.
+bool parseKey(const char* hex, uint8_t key[PATCH_KEY_LEN]);
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef _FLOOD_STATES_H_
+#define _FLOOD_STATES_H_
+
+#include <stdint.h>
+
+// Warning state machine shared by Flood Magnet and Flood Falcon.
+// Keep the copies in both sketch folders identical.
+
+// Severity levels as reported by the API, INIT is the power-up state.
+// The values double as audio track numbers T00.ogg - T05.ogg
+enum warning_levels { NONE,
+                      SEVERE_FLOOD_WARNING,
+                      FLOOD_WARNING,
+                      FLOOD_ALERT,
+                      NO_LONGER,
+                      INIT };
+#define NUM_LEVELS 6
+
+// Indicator LEDs, values match the colours in led.h
+enum led_actions { LED_KEEP,
+                   LED_RED,
+                   LED_AMBER,
+                   LED_GREEN };
+
+enum buzzer_actions { BUZZ_KEEP,
+                      BUZZ_ON,
+                      BUZZ_OFF };
+
+// Background image and warning text shown on the e-paper display
+enum display_templates { TPL_NO_WARNING,
+                         TPL_SEVERE,
+                         TPL_WARNING,
+                         TPL_ALERT,
+                         TPL_NO_LONGER };
+
+// Falcon wing animations
+enum animations { ANIM_NONE,
+                  ANIM_START,      // Wings down
+                  ANIM_BIT_VSLOW,  // Wings up a bit, very slowly
+                  ANIM_LOT_VFAST,  // Wings up a lot, very fast
+                  ANIM_BIT_FAST,   // Wings up a bit, fast
+                  ANIM_BIT_SLOW };  // Wings up a bit, slowly
+
+struct stateAction {
+  uint8_t led;
+  uint8_t buzzer;
+  uint8_t display;
+  uint8_t animation;
+  uint8_t track;
+};
+
+// Actions on entering a level from a different one
+constexpr stateAction enterActions[NUM_LEVELS] = {
+  { LED_KEEP, BUZZ_KEEP, TPL_NO_WARNING, ANIM_BIT_VSLOW, NONE },
+  { LED_RED, BUZZ_ON, TPL_SEVERE, ANIM_LOT_VFAST, SEVERE_FLOOD_WARNING },
+  { LED_RED, BUZZ_ON, TPL_WARNING, ANIM_BIT_FAST, FLOOD_WARNING },
+  { LED_AMBER, BUZZ_ON, TPL_ALERT, ANIM_BIT_SLOW, FLOOD_ALERT },
+  { LED_GREEN, BUZZ_KEEP, TPL_NO_LONGER, ANIM_BIT_VSLOW, NO_LONGER },
+  { LED_KEEP, BUZZ_KEEP, TPL_NO_WARNING, ANIM_START, INIT },
+};
+
+// Actions when a poll reports the level already held.
+// Indicators are left alone, the Falcon repeats its display.
+constexpr stateAction holdAction(int level) {
+  return { LED_KEEP, BUZZ_KEEP, enterActions[level].display, enterActions[level].animation, enterActions[level].track };
+}
+
+constexpr stateAction pickAction(int prev, int next) {
+  return prev == next ? holdAction(next) : enterActions[next];
+}
+
+#define TRANSITION_ROW(p) \
+  { pickAction(p, 0), pickAction(p, 1), pickAction(p, 2), pickAction(p, 3), pickAction(p, 4), pickAction(p, 5) }
+
+// Indexed [previous][next], built at compile time
+constexpr stateAction transitionTable[NUM_LEVELS][NUM_LEVELS] = {
+  TRANSITION_ROW(NONE),
+  TRANSITION_ROW(SEVERE_FLOOD_WARNING),
+  TRANSITION_ROW(FLOOD_WARNING),
+  TRANSITION_ROW(FLOOD_ALERT),
+  TRANSITION_ROW(NO_LONGER),
+  TRANSITION_ROW(INIT),
+};
+
+// Relative urgency, used to escalate immediately but debounce downgrades
+constexpr uint8_t severityRank[NUM_LEVELS] = { 0, 3, 2, 1, 0, 0 };
+
+// Demo mode cycles NONE -> ALERT -> WARNING -> SEVERE -> NO_LONGER -> NONE
+constexpr warning_levels demoNext[NUM_LEVELS] = {
+  FLOOD_ALERT, NO_LONGER, SEVERE_FLOOD_WARNING, FLOOD_WARNING, NONE, NONE
+};
+
+// Levels must be in range, sanitise API values with toLevel() first
+inline const stateAction& transition(warning_levels prev, warning_levels next) {
+  return transitionTable[prev][next];
+}
+
+// INIT is internal, the API never reports it
+constexpr warning_levels toLevel(int level) {
+  return (unsigned)level < INIT ? (warning_levels)level : NONE;
+}
+
+constexpr uint8_t levelTemplate(int level) {
+  return enterActions[toLevel(level)].display;
+}
+
+// Table checks over all 36 cells, cell = previous * NUM_LEVELS + next
+constexpr bool cellOk(int prev, int next) {
+  return transitionTable[prev][next].track == next &&
+         (prev != next || (transitionTable[prev][next].led == LED_KEEP &&
+                           transitionTable[prev][next].buzzer == BUZZ_KEEP)) &&
+         (severityRank[next] <= severityRank[prev] || transitionTable[prev][next].buzzer == BUZZ_ON) &&
+         demoNext[prev] != INIT;
+}
+
+constexpr bool tableOk(int cell = 0) {
+  return cell == NUM_LEVELS * NUM_LEVELS ||
+         (cellOk(cell / NUM_LEVELS, cell % NUM_LEVELS) && tableOk(cell + 1));
+}
+
+static_assert(NUM_LEVELS == INIT + 1, "NUM_LEVELS must cover INIT");
+static_assert(tableOk(), "every level plays its own track, a held level keeps the indicators and an escalation sounds the buzzer");
+static_assert(toLevel(-1) == NONE && toLevel(INIT) == NONE && toLevel(NO_LONGER) == NO_LONGER, "toLevel range");
+
+#endif
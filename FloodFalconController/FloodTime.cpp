@@ -0,0 +1,171 @@
+#include <Arduino.h>
+#include "FloodTime.h"
+
+static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+static uint32_t syncEpoch = 0;       // Epoch at last sync, 0 if never synced
+static unsigned long syncMillis = 0;  // millis() at last sync
+
+// Days since 1970-01-01 for a proleptic Gregorian date (y >= 1970)
+static uint32_t daysFromCivil(uint32_t y, uint32_t m, uint32_t d) {
+  y -= m <= 2;
+  uint32_t era = y / 400;
+  uint32_t yoe = y - era * 400;
+  uint32_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+// Read exactly n decimal digits
+static bool readDigits(const char*& p, int n, uint32_t* out) {
+  uint32_t v = 0;
+  for (int i = 0; i < n; i++, p++) {
+    if (*p < '0' || *p > '9') {
+      return false;
+    }
+    v = v * 10 + (*p - '0');
+  }
+  *out = v;
+  return true;
+}
+
+static bool toEpoch(uint32_t y, uint32_t mo, uint32_t d, uint32_t h, uint32_t mi, uint32_t s, uint32_t* epoch) {
+  if (y < 1970 || mo < 1 || mo > 12 || d < 1 || d > 31 || h > 23 || mi > 59 || s > 60) {
+    return false;
+  }
+  *epoch = daysFromCivil(y, mo, d) * 86400UL + h * 3600UL + mi * 60UL + s;
+  return true;
+}
+
+bool parseIsoTime(const char* str, uint32_t* epoch) {
+  const char* p = str;
+  uint32_t y, mo, d, h, mi, s;
+  if (!str
+      || !readDigits(p, 4, &y) || *p++ != '-'
+      || !readDigits(p, 2, &mo) || *p++ != '-'
+      || !readDigits(p, 2, &d)) {
+    return false;
+  }
+  if (*p != 'T' && *p != ' ') {
+    return false;
+  }
+  p++;
+  if (!readDigits(p, 2, &h) || *p++ != ':'
+      || !readDigits(p, 2, &mi) || *p++ != ':'
+      || !readDigits(p, 2, &s)) {
+    return false;
+  }
+  // Skip fractional seconds
+  if (*p == '.') {
+    do {
+      p++;
+    } while (*p >= '0' && *p <= '9');
+  }
+  if (!toEpoch(y, mo, d, h, mi, s, epoch)) {
+    return false;
+  }
+  // Zone offset, local = UTC + offset
+  if (*p == '+' || *p == '-') {
+    char sign = *p++;
+    uint32_t oh, om = 0;
+    if (!readDigits(p, 2, &oh)) {
+      return false;
+    }
+    if (*p == ':') {
+      p++;
+    }
+    readDigits(p, 2, &om);
+    uint32_t offset = oh * 3600UL + om * 60UL;
+    *epoch = (sign == '+') ? *epoch - offset : *epoch + offset;
+  }
+  return true;
+}
+
+bool parseHttpDate(const char* str, uint32_t* epoch) {
+  if (!str) {
+    return false;
+  }
+  const char* p = strchr(str, ',');
+  if (!p) {
+    return false;
+  }
+  p++;
+  while (*p == ' ') {
+    p++;
+  }
+  uint32_t y, mo = 0, d, h, mi, s;
+  if (!readDigits(p, 2, &d) || *p++ != ' ') {
+    return false;
+  }
+  for (uint32_t i = 0; i < 12; i++) {
+    if (strncmp(p, &months[i * 3], 3) == 0) {
+      mo = i + 1;
+      break;
+    }
+  }
+  p += 3;
+  if (!mo || *p++ != ' '
+      || !readDigits(p, 4, &y) || *p++ != ' '
+      || !readDigits(p, 2, &h) || *p++ != ':'
+      || !readDigits(p, 2, &mi) || *p++ != ':'
+      || !readDigits(p, 2, &s)) {
+    return false;
+  }
+  return toEpoch(y, mo, d, h, mi, s, epoch);
+}
+
+void formatTime(uint32_t epoch, char* buf) {
+  uint32_t z = epoch / 86400UL + 719468;
+  uint32_t secs = epoch % 86400UL;
+  uint32_t era = z / 146097;
+  uint32_t doe = z - era * 146097;
+  uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  uint32_t mp = (5 * doy + 2) / 153;
+  uint32_t d = doy - (153 * mp + 2) / 5 + 1;
+  uint32_t m = mp < 10 ? mp + 3 : mp - 9;
+  uint32_t y = yoe + era * 400 + (m <= 2);
+  // Every field is in range, the modulos let the compiler see the width
+  snprintf(buf, TIME_STR_LEN, "%04u-%02u-%02u %02u:%02u",
+           (unsigned)(y % 10000), (unsigned)(m % 100), (unsigned)(d % 100),
+           (unsigned)(secs / 3600 % 100), (unsigned)(secs / 60 % 60));
+}
+
+void formatAge(uint32_t age, char* buf, size_t len) {
+  if (age < 60) {
+    snprintf(buf, len, "just now");
+  } else if (age < 3600) {
+    snprintf(buf, len, "%lu min ago", (unsigned long)(age / 60));
+  } else if (age < 48 * 3600UL) {
+    snprintf(buf, len, "%lu hr ago", (unsigned long)(age / 3600));
+  } else {
+    snprintf(buf, len, "%lu days ago", (unsigned long)(age / 86400UL));
+  }
+}
+
+uint32_t ageRefreshInterval(uint32_t age) {
+  if (age < 3600) {
+    return 60;
+  } else if (age < 48 * 3600UL) {
+    return 3600;
+  }
+  return 86400UL;
+}
+
+void clockSync(uint32_t epoch) {
+  if (epoch) {
+    syncEpoch = epoch;
+    syncMillis = millis();
+  }
+}
+
+bool clockValid(void) {
+  return syncEpoch != 0;
+}
+
+uint32_t clockNow(void) {
+  if (!syncEpoch) {
+    return 0;
+  }
+  return syncEpoch + (millis() - syncMillis) / 1000;
+}
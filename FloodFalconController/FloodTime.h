@@ -0,0 +1,35 @@
+#ifndef _FLOOD_TIME_H_
+#define _FLOOD_TIME_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Timestamps are held as seconds since 1970-01-01 00:00:00 UTC.
+// 0 means "unknown", which is safe as the API never reports 1970.
+
+#define TIME_STR_LEN 17  // "2022-12-19 15:20"
+#define AGE_STR_LEN 16   // "999 days ago"
+
+// Parse "2022-12-19T15:20:31" with optional ".sss" and "Z" / "+01:00".
+// Times without a zone designator are taken as UTC.
+bool parseIsoTime(const char* str, uint32_t* epoch);
+
+// Parse an RFC 7231 HTTP-Date e.g. "Sun, 06 Nov 1994 08:49:37 GMT"
+bool parseHttpDate(const char* str, uint32_t* epoch);
+
+// Format epoch as "2022-12-19 15:20", buf must hold TIME_STR_LEN chars
+void formatTime(uint32_t epoch, char* buf);
+
+// Format an age in seconds as "just now", "12 min ago", "3 hr ago", "4 days ago"
+void formatAge(uint32_t age, char* buf, size_t len);
+
+// How long the formatted age stays unchanged, in seconds.
+// Used to decide how often the age line needs re-rendering.
+uint32_t ageRefreshInterval(uint32_t age);
+
+// Wall clock, synced from NTP or a server Date header and run on from millis()
+void clockSync(uint32_t epoch);
+bool clockValid(void);
+uint32_t clockNow(void);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef _REFRESH_POLICY_H_
+#define _REFRESH_POLICY_H_
+
+#include <stdint.h>
+
+// Decides when the e-paper needs a full refresh. Partial updates leave
+// a little ghosting wherever pixels change, so the partials and the
+// area they rewrote since the last full refresh are counted against a
+// budget. A full refresh is due when either budget runs out, when the
+// severity shown changes (a new screen) or when the panel has been
+// left alone for longer than the idle time.
+class RefreshPolicy {
+public:
+  RefreshPolicy(uint16_t maxPartials, uint32_t maxArea, unsigned long idleMs)
+    : _maxPartials(maxPartials), _maxArea(maxArea), _idleMs(idleMs) {};
+  bool fullDue(int severity, unsigned long now);
+  void fullDone(int severity, unsigned long now);
+  void partialDone(uint32_t area, unsigned long now);
+
+  // Since the last full refresh
+  uint16_t partials(void) { return _partials; }
+  uint32_t area(void) { return _area; }  // Pixels rewritten by partials
+
+  // Since start up
+  uint32_t fullRefreshes(void) { return _fullRefreshes; }
+  uint32_t partialRefreshes(void) { return _partialRefreshes; }
+
+private:
+  uint16_t _maxPartials;  // Partials allowed between full refreshes
+  uint32_t _maxArea;      // Or pixels rewritten by them
+  unsigned long _idleMs;  // Untouched this long, refresh in full
+  int _severity = -1;     // Shown by the last full refresh, -1 for none yet
+  unsigned long _lastUpdate = 0;
+  uint16_t _partials = 0;
+  uint32_t _area = 0;
+  uint32_t _fullRefreshes = 0;
+  uint32_t _partialRefreshes = 0;
+};
+
+#endif
@@ -0,0 +1,609 @@
+/**
+ *  @filename   :   epd2in9_V2_impl.h
+ *  @brief      :   Implements for e-paper library, the Epd template.
+ *                  Included by epd2in9_V2.h, so any panel and pin map
+ *                  can be instantiated where it is used.
+ *  @author     :  
+ *
+ *  Copyright (C) Waveshare     Nov 9 2020
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documnetation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to  whom the Software is
+ * furished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef EPD2IN9_V2_IMPL_H
+#define EPD2IN9_V2_IMPL_H
+
+#include <stdlib.h>
+#include <string.h>
+
+template <class Panel, class Pins>
+Epd<Panel, Pins>::~Epd() {
+};
+
+template <class Panel, class Pins>
+Epd<Panel, Pins>::Epd() {
+    temperature = TEMPERATURE_UNKNOWN;
+    memset(update_ms, 0, sizeof(update_ms));
+    update_waveform = -1;
+    shadow_saved = 0;
+    ShadowInvalidate();
+    SetWaveform(WAVEFORM_PARTIAL);
+};
+
+template <class Panel, class Pins>
+int Epd<Panel, Pins>::Init() {
+    /* this calls the peripheral hardware interface, see epdif */
+    if (IfInit(Pins::RST, Pins::DC, Pins::CS, Pins::BUSY) != 0) {
+        return -1;
+    }
+	
+	Reset();
+	
+    /* EPD hardware init start */
+	WaitUntilIdle();   
+	SendCommand(0x12);  //SWRESET
+	WaitUntilIdle();   
+	
+	SendCommand(0x01); //Driver output control      
+	SendData((Panel::HEIGHT - 1) & 0xFF);
+	SendData(((Panel::HEIGHT - 1) >> 8) & 0xFF);
+	SendData(0x00);
+	
+	SendCommand(0x11); //data entry mode       
+	SendData(0x03);
+
+	SetMemoryArea(0, 0, width-1, height-1);
+
+	SendCommand(0x21); //  Display update control
+	SendData(0x00);
+	SendData(0x80);	
+
+	SetMemoryPointer(0, 0);
+	WaitUntilIdle();
+
+    ReadTemperature();
+    SetWaveform(waveform);
+    SetLut_by_host(WS_20_30);
+    /* EPD hardware init end */
+    return 0;
+}
+
+/**
+ *  @brief: reads the panel's own temperature sensor, in whole degrees C,
+ *          or TEMPERATURE_UNKNOWN if the panel did not answer
+ */
+template <class Panel, class Pins>
+int Epd<Panel, Pins>::ReadTemperature(void) {
+    unsigned char data[2];
+
+    SendCommand(0x18);  // Internal sensor
+    SendData(0x80);
+    SendCommand(0x22);  // Clock on, load temperature, clock off
+    SendData(0xA1);
+    SendCommand(0x20);
+    WaitUntilIdle();
+    SendCommand(0x1B);  // Temperature register, 12 bits in 1/16 C
+    SpiRead(Pins::CS, data, 2);
+    /* The low 4 bits are always 0, a floating pin reads 1s */
+    if (data[1] & 0x0F) {
+        temperature = TEMPERATURE_UNKNOWN;
+    } else {
+        temperature = (signed char)data[0];
+    }
+    return temperature;
+}
+
+/**
+ *  @brief: picks the waveform for the following partial updates,
+ *          stretched or shortened for the last temperature read
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SetWaveform(int waveform) {
+    this->waveform = waveform;
+    memcpy(partial_lut, waveform == WAVEFORM_FAST ? _WF_FAST_2IN9 : _WF_PARTIAL_2IN9, sizeof(partial_lut));
+    if (temperature == TEMPERATURE_UNKNOWN) {
+        return;
+    }
+    int i = 0;
+    while (temperature >= drive_scale[i].below) {
+        i++;
+    }
+    int frames = partial_lut[LUT_FIRST_PHASE] * drive_scale[i].percent / 100;
+    partial_lut[LUT_FIRST_PHASE] = frames > 0x3F ? 0x3F : frames;
+}
+
+/**
+ *  @brief: how long the last update with a waveform took, in ms
+ */
+template <class Panel, class Pins>
+unsigned long Epd<Panel, Pins>::UpdateMs(int waveform) {
+    return waveform >= 0 && waveform < WAVEFORMS ? update_ms[waveform] : 0;
+}
+
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::StartUpdate(int waveform) {
+    update_waveform = waveform;
+    update_start = millis();
+    SendCommand(0x20);
+}
+
+/**
+ *  @brief: basic function for sending commands
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SendCommand(unsigned char command) {
+    DigitalWrite(Pins::DC, LOW);
+    DigitalWrite(Pins::CS, LOW);
+    SpiTransfer(Pins::CS, command);
+    DigitalWrite(Pins::CS, HIGH);
+}
+
+/**
+ *  @brief: basic function for sending data
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SendData(unsigned char data) {
+    DigitalWrite(Pins::DC, HIGH);
+    DigitalWrite(Pins::CS, LOW);
+    SpiTransfer(Pins::CS, data);
+    DigitalWrite(Pins::CS, HIGH);
+}
+
+/**
+ *  @brief: Wait until the busy_pin goes LOW
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::WaitUntilIdle(void) {
+	while(1) {	 //=1 BUSY
+		if(DigitalRead(Pins::BUSY)==LOW) 
+			break;
+		DelayMs(5);
+	}
+	DelayMs(5);
+}
+
+/**
+ *  @brief: module reset.
+ *          often used to awaken the module in deep sleep,
+ *          see Epd::Sleep(); the RAM shadow is forgotten, so the
+ *          next uploads after Init() are sent in full.
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::Reset(void) {
+    ShadowInvalidate();
+    DigitalWrite(Pins::RST, HIGH);
+    DelayMs(20);  
+    DigitalWrite(Pins::RST, LOW);                //module reset    
+    DelayMs(5);
+    DigitalWrite(Pins::RST, HIGH); 
+    DelayMs(20);  
+}
+
+/**
+ *  @brief: put an image buffer to the frame memory.
+ *          this won't update the display.
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SetFrameMemory(
+    const unsigned char* image_buffer,
+    int x,
+    int y,
+    int image_width,
+    int image_height
+) {
+    int x_end;
+    int y_end;
+    int first;
+    int last;
+
+    if (
+        image_buffer == NULL ||
+        x < 0 || image_width < 0 ||
+        y < 0 || image_height < 0
+    ) {
+        return;
+    }
+    /* x point must be the multiple of 8 or the last 3 bits will be ignored */
+    x &= ~7;
+    image_width &= ~7;
+    if (x + image_width >= this->width) {
+        x_end = this->width - 1;
+    } else {
+        x_end = x + image_width - 1;
+    }
+    if (y + image_height >= this->height) {
+        y_end = this->height - 1;
+    } else {
+        y_end = y + image_height - 1;
+    }
+    /* only the rows the panel does not already hold */
+    if (!ShadowRows(0x24, image_buffer, false, image_width / 8, x, x_end, y, y_end, &first, &last)) {
+        return;
+    }
+    image_buffer += (first - y) * (image_width / 8);
+    y = first;
+    y_end = last;
+    SetMemoryArea(x, y, x_end, y_end);
+    SetMemoryPointer(x, y);
+    SendCommand(0x24);
+    /* send the image data, as one block if the rows are contiguous */
+    if ((x_end - x + 1) / 8 == image_width / 8) {
+        DigitalWrite(Pins::DC, HIGH);
+        SpiTransferBuffer(Pins::CS, image_buffer, image_width / 8 * (y_end - y + 1));
+        return;
+    }
+    for (int j = 0; j < y_end - y + 1; j++) {
+        for (int i = 0; i < (x_end - x + 1) / 8; i++) {
+            SendData(image_buffer[i + j * (image_width / 8)]);
+        }
+    }
+}
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SetFrameMemory_Partial(
+    const unsigned char* image_buffer,
+    int x,
+    int y,
+    int image_width,
+    int image_height
+) {
+    int x_end;
+    int y_end;
+    int first;
+    int last;
+
+    if (
+        image_buffer == NULL ||
+        x < 0 || image_width < 0 ||
+        y < 0 || image_height < 0
+    ) {
+        return;
+    }
+    /* x point must be the multiple of 8 or the last 3 bits will be ignored */
+    x &= ~7;
+    image_width &= ~7;
+    if (x + image_width >= this->width) {
+        x_end = this->width - 1;
+    } else {
+        x_end = x + image_width - 1;
+    }
+    if (y + image_height >= this->height) {
+        y_end = this->height - 1;
+    } else {
+        y_end = y + image_height - 1;
+    }
+
+    DigitalWrite(Pins::RST, LOW);
+    DelayMs(2);
+    DigitalWrite(Pins::RST, HIGH);
+    DelayMs(2);
+	
+	SetLut(partial_lut);
+	SendCommand(0x37); 
+	SendData(0x00);  
+	SendData(0x00);  
+	SendData(0x00);  
+	SendData(0x00); 
+	SendData(0x00);  	
+	SendData(0x40);  
+	SendData(0x00);  
+	SendData(0x00);   
+	SendData(0x00);  
+	SendData(0x00);
+
+	SendCommand(0x3C); //BorderWavefrom
+	SendData(0x80);	
+
+	SendCommand(0x22); 
+	SendData(0xC0);   
+	SendCommand(0x20); 
+	WaitUntilIdle();  
+	
+    /* the LUT is loaded either way, for DisplayFrame_Partial */
+    if (!ShadowRows(0x24, image_buffer, false, image_width / 8, x, x_end, y, y_end, &first, &last)) {
+        return;
+    }
+    image_buffer += (first - y) * (image_width / 8);
+    y = first;
+    y_end = last;
+    SetMemoryArea(x, y, x_end, y_end);
+    SetMemoryPointer(x, y);
+    SendCommand(0x24);
+    /* send the image data, as one block if the rows are contiguous */
+    if ((x_end - x + 1) / 8 == image_width / 8) {
+        DigitalWrite(Pins::DC, HIGH);
+        SpiTransferBuffer(Pins::CS, image_buffer, image_width / 8 * (y_end - y + 1));
+        return;
+    }
+    for (int j = 0; j < y_end - y + 1; j++) {
+        for (int i = 0; i < (x_end - x + 1) / 8; i++) {
+            SendData(image_buffer[i + j * (image_width / 8)]);
+        }
+    }
+}
+
+/**
+ *  @brief: put an image buffer to the frame memory.
+ *          this won't update the display.
+ *
+ *          Question: When do you use this function instead of 
+ *          void SetFrameMemory(
+ *              const unsigned char* image_buffer,
+ *              int x,
+ *              int y,
+ *              int image_width,
+ *              int image_height
+ *          );
+ *          Answer: SetFrameMemory with parameters only reads image data
+ *          from the RAM but not from the flash in AVR chips (for AVR chips,
+ *          you have to use the function pgm_read_byte to read buffers 
+ *          from the flash).
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SetFrameMemory(const unsigned char* image_buffer) {
+    int first;
+    int last;
+
+    if (!ShadowRows(0x24, image_buffer, true, this->width / 8, 0, this->width - 1, 0, this->height - 1, &first, &last)) {
+        return;
+    }
+    SetMemoryArea(0, 0, this->width - 1, this->height - 1);
+    SetMemoryPointer(0, first);
+    SendCommand(0x24);
+    /* send the image data */
+    for (int i = first * this->width / 8; i < (last + 1) * this->width / 8; i++) {
+        SendData(pgm_read_byte(&image_buffer[i]));
+    }
+}
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SetFrameMemory_Base(const unsigned char* image_buffer) {
+    int first;
+    int last;
+
+    SetMemoryArea(0, 0, this->width - 1, this->height - 1);
+    if (ShadowRows(0x24, image_buffer, true, this->width / 8, 0, this->width - 1, 0, this->height - 1, &first, &last)) {
+        SetMemoryPointer(0, first);
+        SendCommand(0x24);
+        /* send the image data */
+        for (int i = first * this->width / 8; i < (last + 1) * this->width / 8; i++) {
+            SendData(pgm_read_byte(&image_buffer[i]));
+        }
+    }
+    if (ShadowRows(0x26, image_buffer, true, this->width / 8, 0, this->width - 1, 0, this->height - 1, &first, &last)) {
+        SetMemoryPointer(0, first);
+        SendCommand(0x26);
+        /* send the image data */
+        for (int i = first * this->width / 8; i < (last + 1) * this->width / 8; i++) {
+            SendData(pgm_read_byte(&image_buffer[i]));
+        }
+    }
+}
+
+/**
+ *  @brief: clear the frame memory with the specified color.
+ *          this won't update the display.
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::ClearFrameMemory(unsigned char color) {
+    unsigned char row[Panel::WIDTH / 8];
+    int first;
+    int last;
+
+    memset(row, color, sizeof(row));
+    /* every row is the same one, stride 0 */
+    if (!ShadowRows(0x24, row, false, 0, 0, this->width - 1, 0, this->height - 1, &first, &last)) {
+        return;
+    }
+    SetMemoryArea(0, 0, this->width - 1, this->height - 1);
+    SetMemoryPointer(0, first);
+    SendCommand(0x24);
+    /* send the color data */
+    for (int i = first * this->width / 8; i < (last + 1) * this->width / 8; i++) {
+        SendData(color);
+    }
+}
+
+/**
+ *  @brief: update the display
+ *          there are 2 memory areas embedded in the e-paper display
+ *          but once this function is called,
+ *          the the next action of SetFrameMemory or ClearFrame will 
+ *          set the other memory area.
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::DisplayFrame(void) {
+    StartFrame();
+    FinishFrame();
+}
+
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::DisplayFrame_Partial(void) {
+    StartFrame_Partial();
+    FinishFrame();
+}
+
+/**
+ *  @brief: starts a refresh and returns while the panel is still busy.
+ *          It must not be sent anything until FinishFrame().
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::StartFrame(void) {
+    SendCommand(0x22);
+    if (temperature == TEMPERATURE_UNKNOWN || (temperature >= WS_MIN_C && temperature <= WS_MAX_C)) {
+        SendData(0xc7);
+    } else {
+        SendData(0xf7);  // Also load the panel's waveform for its temperature
+    }
+    StartUpdate(WAVEFORM_FULL);
+}
+
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::StartFrame_Partial(void) {
+    SendCommand(0x22);
+    SendData(0x0F);
+    StartUpdate(waveform);
+}
+
+template <class Panel, class Pins>
+bool Epd<Panel, Pins>::Busy(void) {
+    return DigitalRead(Pins::BUSY) == HIGH;
+}
+
+/**
+ *  @brief: waits for a started refresh and notes how long it took
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::FinishFrame(void) {
+    WaitUntilIdle();
+    if (update_waveform >= 0) {
+        update_ms[update_waveform] = millis() - update_start;
+        update_waveform = -1;
+    }
+}
+
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SetLut(unsigned char *lut) {       
+	unsigned char count;
+	SendCommand(0x32);
+	for(count=0; count<153; count++) 
+		SendData(lut[count]); 
+	WaitUntilIdle();
+}
+
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SetLut_by_host(unsigned char *lut) {
+    SetLut((unsigned char *)lut);
+	SendCommand(0x3f);
+	SendData(*(lut+153));
+	SendCommand(0x03);	// gate voltage
+	SendData(*(lut+154));
+	SendCommand(0x04);	// source voltage
+	SendData(*(lut+155));	// VSH
+	SendData(*(lut+156));	// VSH2
+	SendData(*(lut+157));	// VSL
+	SendCommand(0x2c);		// VCOM
+	SendData(*(lut+158));
+}
+
+/**
+ *  @brief: private function to specify the memory area for data R/W
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SetMemoryArea(int x_start, int y_start, int x_end, int y_end) {
+    SendCommand(0x44);
+    /* x point must be the multiple of 8 or the last 3 bits will be ignored */
+    SendData((x_start >> 3) & 0xFF);
+    SendData((x_end >> 3) & 0xFF);
+    SendCommand(0x45);
+    SendData(y_start & 0xFF);
+    SendData((y_start >> 8) & 0xFF);
+    SendData(y_end & 0xFF);
+    SendData((y_end >> 8) & 0xFF);
+}
+
+/**
+ *  @brief: private function to specify the start point for data R/W
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::SetMemoryPointer(int x, int y) {
+    SendCommand(0x4E);
+    /* x point must be the multiple of 8 or the last 3 bits will be ignored */
+    SendData((x >> 3) & 0xFF);
+    SendCommand(0x4F);
+    SendData(y & 0xFF);
+    SendData((y >> 8) & 0xFF);
+    WaitUntilIdle();
+}
+
+/**
+ *  @brief: After this command is transmitted, the chip would enter the 
+ *          deep-sleep mode to save power. 
+ *          The deep sleep mode would return to standby by hardware reset. 
+ *          You can use Epd::Init() to awaken
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::Sleep() {
+    SendCommand(0x10);
+    SendData(0x01);
+    ShadowInvalidate();
+    // WaitUntilIdle();
+}
+
+/**
+ *  @brief: forgets what the panel RAM holds, after anything that may
+ *          have lost or changed it
+ */
+template <class Panel, class Pins>
+void Epd<Panel, Pins>::ShadowInvalidate(void) {
+    memset(shadow, SHADOW_UNKNOWN, sizeof(shadow));
+}
+
+/**
+ *  @brief: private function to check an upload against the shadow of
+ *          the panel RAM. Each row of a bank is remembered as a hash of
+ *          the bytes last written to it and where they went, so a row
+ *          matches only if its last write covered the same bytes with
+ *          the same data. Returns false if every row of the window
+ *          matches and nothing need be sent, otherwise the first and
+ *          last rows that differ. x and x_end are in pixels, stride is
+ *          the buffer's bytes per row.
+ */
+template <class Panel, class Pins>
+bool Epd<Panel, Pins>::ShadowRows(
+    unsigned char bank,
+    const unsigned char* image_buffer,
+    bool progmem,
+    int stride,
+    int x,
+    int x_end,
+    int y,
+    int y_end,
+    int* first,
+    int* last
+) {
+    unsigned long* rows = shadow[bank == 0x24 ? 0 : 1];
+    int row_bytes = (x_end - x + 1) / 8;
+
+    *first = -1;
+    *last = -1;
+    for (int j = 0; j < y_end - y + 1; j++) {
+        /* FNV-1a, seeded with the byte range */
+        unsigned long hash = (2166136261UL ^ (x >> 3)) * 16777619UL;
+        hash = (hash ^ (x_end >> 3)) * 16777619UL;
+        for (int i = 0; i < row_bytes; i++) {
+            const unsigned char* p = &image_buffer[i + j * stride];
+            hash = (hash ^ (progmem ? pgm_read_byte(p) : *p)) * 16777619UL;
+        }
+        if (hash == SHADOW_UNKNOWN) {
+            hash = 1;
+        }
+        if (hash != rows[y + j]) {
+            rows[y + j] = hash;
+            if (*first < 0) {
+                *first = y + j;
+            }
+            *last = y + j;
+        }
+    }
+    shadow_saved += (unsigned long)row_bytes * (y_end - y + 1 - (*first < 0 ? 0 : *last - *first + 1));
+    return *first >= 0;
+}
+
+#endif /* EPD2IN9_V2_IMPL_H */
+
+/* END OF FILE */
@@ -29,28 +29,106 @@
 #define EPDIF_H
 
 #include <Arduino.h>
+#include <SPI.h>
 
-// Pin definition
-//#define RST_PIN         8
-//#define DC_PIN          9
-//#define CS_PIN          10
-//#define BUSY_PIN        7
+// Pin map, the Epd template parameter, as Arduino pin numbers
+template <int Rst, int Dc, int Cs, int Busy>
+struct EpdPins {
+    static const int RST = Rst;
+    static const int DC = Dc;
+    static const int CS = Cs;
+    static const int BUSY = Busy;
+#if defined(ARDUINO_SAMD_NANO_33_IOT)
+    static_assert(Rst <= 21 && Dc <= 21 && Cs <= 21 && Busy <= 21, "EPD pins must be D0 to A7");
+#endif
+};
+
+// This board's wiring, Epd's default pin map
+typedef EpdPins<6, 7, 8, 5> EpdBoardPins;   // reset, dc, cs, busy
+
+// Optional DMA for image data, the CPU can draw the next strip while
+// the last one is clocked out. Needs the Adafruit_ZeroDMA library.
+// #define EPD_DMA
+#define EPD_DMA_BUFFER      1024            // Largest transfer sent by DMA
+#define EPD_SPI_SERCOM      SERCOM1         // SPI on the Nano 33 IoT
+#define EPD_SPI_DMAC_ID_TX  SERCOM1_DMAC_ID_TX
 
-#define RST_PIN         6
-#define DC_PIN          7
-#define CS_PIN          8
-#define BUSY_PIN        5
+/* The pins are known at compile time, so on the Nano 33 IoT each write
+   is one store to the port's OUTSET or OUTCLR register instead of a
+   digitalWrite() through the pin tables. Port group and bit of each
+   Arduino pin, D0 to A7, as the core's variant.cpp. */
+#if defined(ARDUINO_SAMD_NANO_33_IOT)
+#define EPD_PORT_IO
+static constexpr unsigned char epd_pin_port[] = {
+    1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 1
+};
+static constexpr unsigned char epd_pin_bit[] = {
+    23, 22, 10, 11, 7, 5, 4, 6, 18, 20, 21, 16, 19, 17, 2, 2, 11, 10, 8, 9, 9, 3
+};
+#elif defined(EPD_PORT_IO)
+/* Host builds, simulated by FontTools/mockpanel.cpp */
+void portWrite(int pin, int value);
+int portRead(int pin);
+#endif
 
 class EpdIf {
 public:
     EpdIf(void);
     ~EpdIf(void);
 
-    static int  IfInit(void);
-    static void DigitalWrite(int pin, int value); 
-    static int  DigitalRead(int pin);
+    static int  IfInit(int rst, int dc, int cs, int busy);
     static void DelayMs(unsigned int delaytime);
-    static void SpiTransfer(unsigned char data);
+    static void SpiTransferBuffer(int cs, const unsigned char* data, int length);
+    static void SpiRead(int cs, unsigned char* data, int length);
+
+    /* Inline, so a constant pin becomes a constant port and mask */
+    static inline void PinWrite(int pin, int value) {
+#if defined(ARDUINO_SAMD_NANO_33_IOT)
+        if (value) {
+            PORT->Group[epd_pin_port[pin]].OUTSET.reg = 1ul << epd_pin_bit[pin];
+        } else {
+            PORT->Group[epd_pin_port[pin]].OUTCLR.reg = 1ul << epd_pin_bit[pin];
+        }
+#elif defined(EPD_PORT_IO)
+        portWrite(pin, value);
+#else
+        digitalWrite(pin, value);
+#endif
+    }
+
+    static inline void DigitalWrite(int pin, int value) {
+        SpiWait();
+        PinWrite(pin, value);
+    }
+
+    static inline int DigitalRead(int pin) {
+#if defined(ARDUINO_SAMD_NANO_33_IOT)
+        return PORT->Group[epd_pin_port[pin]].IN.reg & (1ul << epd_pin_bit[pin]) ? HIGH : LOW;
+#elif defined(EPD_PORT_IO)
+        return portRead(pin);
+#else
+        return digitalRead(pin);
+#endif
+    }
+
+    static inline void SpiTransfer(int cs, unsigned char data) {
+        SpiWait();
+        PinWrite(cs, LOW);
+        SPI.transfer(data);
+        PinWrite(cs, HIGH);
+    }
+
+    /**
+     *  @brief: waits for a DMA transfer to finish
+     */
+    static inline void SpiWait(void) {
+#ifdef EPD_DMA
+        SpiWaitDma();
+#endif
+    }
+
+private:
+    static void SpiWaitDma(void);
 };
 
 #endif
@@ -25,6 +25,7 @@
  */
 
 #include <avr/pgmspace.h>
+#include <string.h>
 #include "epdpaint.h"
 
 Paint::Paint(unsigned char* image, int width, int height) {
@@ -144,6 +145,10 @@ void Paint::DrawPixel(int x, int y, int colored) {
  */
 void Paint::DrawCharAt(int x, int y, char ascii_char, sFONT* font, int colored) {
     int i, j;
+    if (font->packed) {
+        DrawPackedCharAt(x, y, ascii_char, font, colored);
+        return;
+    }
     unsigned int char_offset = (ascii_char - ' ') * font->Height * (font->Width / 8 + (font->Width % 8 ? 1 : 0));
     const unsigned char* ptr = &font->table[char_offset];
 
@@ -162,23 +167,176 @@ void Paint::DrawCharAt(int x, int y, char ascii_char, sFONT* font, int colored)
     }
 }
 
+/**
+*  @brief: draws a glyph from a packed font, each run of set
+*          pixels in a row is filled as one span
+*/
+void Paint::DrawPackedCharAt(int x, int y, char ascii_char, sFONT* font, int colored) {
+    const sGLYPH* glyph = PackedGlyph(ascii_char, font);
+    if (!glyph) {
+        return;
+    }
+    const unsigned char* bits = &font->packed->bits[pgm_read_word(&glyph->offset)];
+    int top = pgm_read_byte(&glyph->top);
+    int rows = pgm_read_byte(&glyph->rows);
+    int cols = pgm_read_byte(&glyph->cols);
+    unsigned int bit = 0;
+
+    /* Fixed width glyphs keep their place in the cell, proportional
+       ones start at the pen */
+    if (!font->packed->proportional) {
+        x += pgm_read_byte(&glyph->left);
+    }
+    for (int j = 0; j < rows; j++) {
+        int run = -1;
+        for (int i = 0; i < cols; i++, bit++) {
+            if (pgm_read_byte(&bits[bit >> 3]) & (0x80 >> (bit & 7))) {
+                if (run < 0) {
+                    run = i;
+                }
+            } else if (run >= 0) {
+                DrawHorizontalSpan(x + run, x + i - 1, y + top + j, colored);
+                run = -1;
+            }
+        }
+        if (run >= 0) {
+            DrawHorizontalSpan(x + run, x + cols - 1, y + top + j, colored);
+        }
+    }
+}
+
+/**
+*  @brief: glyph of a packed font, or NULL if the character is not in the subset
+*/
+const sGLYPH* Paint::PackedGlyph(char ascii_char, sFONT* font) {
+    unsigned int c = (unsigned char)ascii_char - ' ';
+    if (c >= 95) {
+        return 0;
+    }
+    uint8_t g = pgm_read_byte(&font->packed->index[c]);
+    return g == 0xFF ? 0 : &font->packed->glyphs[g];
+}
+
+/**
+*  @brief: pen movement after a character, including any kerning
+*          against the character that follows
+*/
+int Paint::CharAdvance(char ascii_char, char next_char, sFONT* font) {
+    if (!font->packed) {
+        return font->Width;
+    }
+    const sGLYPH* glyph = PackedGlyph(ascii_char, font);
+    if (!glyph) {
+        return 0;
+    }
+    int advance = pgm_read_byte(&glyph->advance);
+    /* Sorted by left, so stop once past it */
+    const sKERN* kern = font->packed->kerns;
+    for (int n = font->packed->numKerns; n > 0; n--, kern++) {
+        char left = pgm_read_byte(&kern->left);
+        if (left > ascii_char) {
+            break;
+        }
+        if (left == ascii_char && (char)pgm_read_byte(&kern->right) == next_char) {
+            return advance + (int8_t)pgm_read_byte(&kern->adjust);
+        }
+    }
+    return advance;
+}
+
+/**
+*  @brief: width in pixels of the first length characters of text
+*/
+int Paint::MeasureString(const char* text, int length, sFONT* font) {
+    int width = 0;
+    for (int i = 0; i < length; i++) {
+        width += CharAdvance(text[i], i + 1 < length ? text[i + 1] : 0, font);
+    }
+    return width;
+}
+
+/**
+*  @brief: length of the next line of text that fits in width, broken
+*          at a space or newline, or mid word if one word is too long.
+*          next is set to the start of the following line.
+*/
+int Paint::WrapLine(const char* text, int width, sFONT* font, const char** next) {
+    int line = 0;
+    int fit = -1;
+    int i;
+    for (i = 0; text[i] && text[i] != '\n'; i++) {
+        if (text[i] == ' ') {
+            fit = i;
+            continue;  /* Spaces may hang past the edge */
+        }
+        line += CharAdvance(text[i], text[i + 1], font);
+        if (line > width) {
+            break;
+        }
+    }
+    if (!text[i] || text[i] == '\n') {
+        fit = i;
+    } else if (fit <= 0) {
+        fit = i > 0 ? i : 1;
+    }
+    *next = text + fit;
+    while (**next == ' ') {
+        (*next)++;
+    }
+    if (**next == '\n') {
+        (*next)++;
+    }
+    return fit;
+}
+
+/**
+*  @brief: number of lines DrawStringCentred will use
+*/
+int Paint::CountLines(const char* text, sFONT* font, int width) {
+    int lines = 0;
+    while (*text) {
+        WrapLine(text, width, font, &text);
+        lines++;
+    }
+    return lines;
+}
+
+/**
+*  @brief: word wraps text to width and centres each line in it,
+*          returns the number of lines drawn
+*/
+int Paint::DrawStringCentred(int x, int y, int width, const char* text, sFONT* font, int colored) {
+    int lines = 0;
+    while (*text) {
+        const char* next;
+        int length = WrapLine(text, width, font, &next);
+        DrawStringRun(x + (width - MeasureString(text, length, font)) / 2, y, text, length, font, colored);
+        y += font->Height + LINE_SPACING;
+        text = next;
+        lines++;
+    }
+    return lines;
+}
+
 /**
 *  @brief: this displays a string on the frame buffer but not refresh
 */
 void Paint::DrawStringAt(int x, int y, const char* text, sFONT* font, int colored) {
-    const char* p_text = text;
-    unsigned int counter = 0;
+    DrawStringRun(x, y, text, strlen(text), font, colored);
+}
+
+/**
+*  @brief: draws the first length characters of text
+*/
+void Paint::DrawStringRun(int x, int y, const char* text, int length, sFONT* font, int colored) {
     int refcolumn = x;
-    
+
     /* Send the string character by character on EPD */
-    while (*p_text != 0) {
+    for (int i = 0; i < length; i++) {
         /* Display one character on EPD */
-        DrawCharAt(refcolumn, y, *p_text, font, colored);
-        /* Decrement the column position by 16 */
-        refcolumn += font->Width;
-        /* Point on the next character */
-        p_text++;
-        counter++;
+        DrawCharAt(refcolumn, y, text[i], font, colored);
+        /* Move on by its advance, kerned against the next */
+        refcolumn += CharAdvance(text[i], i + 1 < length ? text[i + 1] : 0, font);
     }
 }
 
@@ -226,6 +384,123 @@ void Paint::DrawVerticalLine(int x, int y, int line_height, int colored) {
     }
 }
 
+/**
+*  @brief: this draws a vertical span from y0 to y1 inclusive.
+*          unlike DrawVerticalLine it writes whole bytes / masks
+*          directly instead of going through DrawPixel per point.
+*/
+void Paint::DrawVerticalSpan(int x, int y0, int y1, int colored) {
+    int temp;
+    if (y0 > y1) {
+        temp = y0;
+        y0 = y1;
+        y1 = temp;
+    }
+    if (this->rotate == ROTATE_0 || this->rotate == ROTATE_180) {
+        if (x < 0 || x >= this->width || y1 < 0 || y0 >= this->height) {
+            return;
+        }
+        y0 = y0 < 0 ? 0 : y0;
+        y1 = y1 >= this->height ? this->height - 1 : y1;
+        if (this->rotate == ROTATE_0) {
+            FillAbsoluteColumn(x, y0, y1, colored);
+        } else {
+            FillAbsoluteColumn(this->width - x, this->height - y1, this->height - y0, colored);
+        }
+    } else {
+        if (x < 0 || x >= this->height || y1 < 0 || y0 >= this->width) {
+            return;
+        }
+        y0 = y0 < 0 ? 0 : y0;
+        y1 = y1 >= this->width ? this->width - 1 : y1;
+        if (this->rotate == ROTATE_90) {
+            FillAbsoluteRow(x, this->width - y1, this->width - y0, colored);
+        } else {
+            FillAbsoluteRow(this->height - x, y0, y1, colored);
+        }
+    }
+}
+
+/**
+*  @brief: this draws a horizontal span from x0 to x1 inclusive,
+*          filled a byte at a time like DrawVerticalSpan
+*/
+void Paint::DrawHorizontalSpan(int x0, int x1, int y, int colored) {
+    int temp;
+    if (x0 > x1) {
+        temp = x0;
+        x0 = x1;
+        x1 = temp;
+    }
+    if (this->rotate == ROTATE_0 || this->rotate == ROTATE_180) {
+        if (y < 0 || y >= this->height || x1 < 0 || x0 >= this->width) {
+            return;
+        }
+        x0 = x0 < 0 ? 0 : x0;
+        x1 = x1 >= this->width ? this->width - 1 : x1;
+        if (this->rotate == ROTATE_0) {
+            FillAbsoluteRow(y, x0, x1, colored);
+        } else {
+            FillAbsoluteRow(this->height - y, this->width - x1, this->width - x0, colored);
+        }
+    } else {
+        if (y < 0 || y >= this->width || x1 < 0 || x0 >= this->height) {
+            return;
+        }
+        x0 = x0 < 0 ? 0 : x0;
+        x1 = x1 >= this->height ? this->height - 1 : x1;
+        if (this->rotate == ROTATE_90) {
+            FillAbsoluteColumn(this->width - y, x0, x1, colored);
+        } else {
+            FillAbsoluteColumn(y, this->height - x1, this->height - x0, colored);
+        }
+    }
+}
+
+/**
+*  @brief: fill part of one column of the buffer, absolute coordinates
+*/
+void Paint::FillAbsoluteColumn(int x, int y0, int y1, int colored) {
+    if (x < 0 || x >= this->width) {
+        return;
+    }
+    y1 = y1 >= this->height ? this->height - 1 : y1;
+    int stride = this->width / 8;
+    unsigned char mask = 0x80 >> (x % 8);
+    unsigned char* p = &image[x / 8 + y0 * stride];
+    bool set = IF_INVERT_COLOR ? colored : !colored;
+    for (int y = y0; y <= y1; y++, p += stride) {
+        if (set) {
+            *p |= mask;
+        } else {
+            *p &= ~mask;
+        }
+    }
+}
+
+/**
+*  @brief: fill part of one row of the buffer, absolute coordinates
+*/
+void Paint::FillAbsoluteRow(int y, int x0, int x1, int colored) {
+    if (y < 0 || y >= this->height) {
+        return;
+    }
+    x1 = x1 >= this->width ? this->width - 1 : x1;
+    unsigned char* row = &image[y * (this->width / 8)];
+    bool set = IF_INVERT_COLOR ? colored : !colored;
+    while (x0 <= x1) {
+        /* last pixel of this span within the current byte */
+        int last = (x0 | 7) < x1 ? (x0 | 7) : x1;
+        unsigned char mask = (0xFF >> (x0 % 8)) & (0xFF << (7 - last % 8));
+        if (set) {
+            row[x0 / 8] |= mask;
+        } else {
+            row[x0 / 8] &= ~mask;
+        }
+        x0 = last + 1;
+    }
+}
+
 /**
 *  @brief: this draws a rectangle
 */
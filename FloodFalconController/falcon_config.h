@@ -1,3 +1,6 @@
+// WiFi, AREA_CODE, the intervals and wing positions are defaults.
+// They can be changed over serial without a rebuild, see README.
+
 // Your WiFi settings
 #define SECRET_SSID "your-ssid"
 #define SECRET_PASS "your-wifi-password"
@@ -5,6 +8,21 @@
 // Your flood area code from Gov.co.uk Flood Warning Service
 #define AREA_CODE "065WAF441"
 
+// Optional over the air updates from a local HTTP server, see README
+// #define OTA_HOST "192.168.1.10"
+// #define OTA_PORT 8000
+#define OTA_INTERVAL 24 * 60 * 60 * 1000UL  // Check daily
+// Key that patches are signed with, 64 hex digits from "floodpatch key".
+// Better left empty here and set over serial with "set otaKey", see README
+#define OTA_KEY ""
+
+// Full refreshes, which flash the screen, are only done for a new
+// severity, after this many partial updates or pixels rewritten by
+// them (ghosting builds up), or when the screen has been idle this long
+#define REFRESH_MAX_PARTIALS 300
+#define REFRESH_MAX_AREA 20 * 128 * 296UL   // 20 screens
+#define REFRESH_IDLE 24 * 60 * 60 * 1000UL  // 1 day
+
 // Your serveo / wing positions - adjust as required
 // If the servo is chattering at the end positions,
 // adjust the min or max value by 5 ish
@@ -17,6 +35,12 @@
 #define ALERT_INTERVAL 15 * 60 * 1000  // 15 mins
 #define DEMO_INTERVAL 10 * 1000        // 10 sec
 
+// Severity debounce - downgrades need this many consistent readings
+// or this long, escalations are shown at once
+#define DEBOUNCE_READINGS 3
+#define DEBOUNCE_TIME 30 * 60 * 1000  // 30 mins
+#define STALE_FAILURES 3              // Failed polls before data is stale
+
 // Audio track numbers
 // #define NONE 0                   // T00.ogg
 // #define SEVERE_FLOOD_WARNING 1   // T01.ogg
@@ -1,1385 +1,137 @@
-/**
-  ******************************************************************************
-  * @file    Font12.cpp
-  * @author  MCD Application Team
-  * @version V1.0.0
-  * @date    18-February-2014
-  * @brief   This file provides text Font12. 
-  ******************************************************************************
-  * @attention
-  *
-  * <h2><center>&copy; COPYRIGHT(c) 2014 STMicroelectronics</center></h2>
-  *
-  * Redistribution and use in source and binary forms, with or without modification,
-  * are permitted provided that the following conditions are met:
-  *   1. Redistributions of source code must retain the above copyright notice,
-  *      this list of conditions and the following disclaimer.
-  *   2. Redistributions in binary form must reproduce the above copyright notice,
-  *      this list of conditions and the following disclaimer in the documentation
-  *      and/or other materials provided with the distribution.
-  *   3. Neither the name of STMicroelectronics nor the names of its contributors
-  *      may be used to endorse or promote products derived from this software
-  *      without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
-  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
-  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
-  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
-  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
-  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
-  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
-  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
-  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  ******************************************************************************
-  */
+// Generated by FontTools/fontpack from font12.cpp, do not edit.
+// Subset of the characters used by the sketch, see fonts.h for the format.
 
-/* Includes ------------------------------------------------------------------*/
 #include "fonts.h"
 #include <avr/pgmspace.h>
 
-// 
-//  Font data for Courier New 12pt
-// 
-
-const uint8_t Font12_Table[] PROGMEM = 
-{
-	// @0 ' ' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @12 '!' (7 pixels wide)
-	0x00, //        
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x00, //        
-	0x00, //        
-	0x10, //    #   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @24 '"' (7 pixels wide)
-	0x00, //        
-	0x6C, //  ## ## 
-	0x48, //  #  #  
-	0x48, //  #  #  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @36 '#' (7 pixels wide)
-	0x00, //        
-	0x14, //    # # 
-	0x14, //    # # 
-	0x28, //   # #  
-	0x7C, //  ##### 
-	0x28, //   # #  
-	0x7C, //  ##### 
-	0x28, //   # #  
-	0x50, //  # #   
-	0x50, //  # #   
-	0x00, //        
-	0x00, //        
-
-	// @48 '$' (7 pixels wide)
-	0x00, //        
-	0x10, //    #   
-	0x38, //   ###  
-	0x40, //  #     
-	0x40, //  #     
-	0x38, //   ###  
-	0x48, //  #  #  
-	0x70, //  ###   
-	0x10, //    #   
-	0x10, //    #   
-	0x00, //        
-	0x00, //        
-
-	// @60 '%' (7 pixels wide)
-	0x00, //        
-	0x20, //   #    
-	0x50, //  # #   
-	0x20, //   #    
-	0x0C, //     ## 
-	0x70, //  ###   
-	0x08, //     #  
-	0x14, //    # # 
-	0x08, //     #  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @72 '&' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x18, //    ##  
-	0x20, //   #    
-	0x20, //   #    
-	0x54, //  # # # 
-	0x48, //  #  #  
-	0x34, //   ## # 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @84 ''' (7 pixels wide)
-	0x00, //        
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @96 '(' (7 pixels wide)
-	0x00, //        
-	0x08, //     #  
-	0x08, //     #  
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x08, //     #  
-	0x08, //     #  
-	0x00, //        
-
-	// @108 ')' (7 pixels wide)
-	0x00, //        
-	0x20, //   #    
-	0x20, //   #    
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x20, //   #    
-	0x20, //   #    
-	0x00, //        
-
-	// @120 '*' (7 pixels wide)
-	0x00, //        
-	0x10, //    #   
-	0x7C, //  ##### 
-	0x10, //    #   
-	0x28, //   # #  
-	0x28, //   # #  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @132 '+' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0xFE, // #######
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @144 ',' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x18, //    ##  
-	0x10, //    #   
-	0x30, //   ##   
-	0x20, //   #    
-	0x00, //        
-
-	// @156 '-' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @168 '.' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x30, //   ##   
-	0x30, //   ##   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @180 '/' (7 pixels wide)
-	0x00, //        
-	0x04, //      # 
-	0x04, //      # 
-	0x08, //     #  
-	0x08, //     #  
-	0x10, //    #   
-	0x10, //    #   
-	0x20, //   #    
-	0x20, //   #    
-	0x40, //  #     
-	0x00, //        
-	0x00, //        
-
-	// @192 '0' (7 pixels wide)
-	0x00, //        
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @204 '1' (7 pixels wide)
-	0x00, //        
-	0x30, //   ##   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @216 '2' (7 pixels wide)
-	0x00, //        
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x04, //      # 
-	0x08, //     #  
-	0x10, //    #   
-	0x20, //   #    
-	0x44, //  #   # 
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @228 '3' (7 pixels wide)
-	0x00, //        
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x04, //      # 
-	0x18, //    ##  
-	0x04, //      # 
-	0x04, //      # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @240 '4' (7 pixels wide)
-	0x00, //        
-	0x0C, //     ## 
-	0x14, //    # # 
-	0x14, //    # # 
-	0x24, //   #  # 
-	0x44, //  #   # 
-	0x7E, //  ######
-	0x04, //      # 
-	0x0E, //     ###
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @252 '5' (7 pixels wide)
-	0x00, //        
-	0x3C, //   #### 
-	0x20, //   #    
-	0x20, //   #    
-	0x38, //   ###  
-	0x04, //      # 
-	0x04, //      # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @264 '6' (7 pixels wide)
-	0x00, //        
-	0x1C, //    ### 
-	0x20, //   #    
-	0x40, //  #     
-	0x78, //  ####  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @276 '7' (7 pixels wide)
-	0x00, //        
-	0x7C, //  ##### 
-	0x44, //  #   # 
-	0x04, //      # 
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x10, //    #   
-	0x10, //    #   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @288 '8' (7 pixels wide)
-	0x00, //        
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @300 '9' (7 pixels wide)
-	0x00, //        
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x3C, //   #### 
-	0x04, //      # 
-	0x08, //     #  
-	0x70, //  ###   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @312 ':' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x30, //   ##   
-	0x30, //   ##   
-	0x00, //        
-	0x00, //        
-	0x30, //   ##   
-	0x30, //   ##   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @324 ';' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x18, //    ##  
-	0x18, //    ##  
-	0x00, //        
-	0x00, //        
-	0x18, //    ##  
-	0x30, //   ##   
-	0x20, //   #    
-	0x00, //        
-	0x00, //        
-
-	// @336 '<' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x0C, //     ## 
-	0x10, //    #   
-	0x60, //  ##    
-	0x80, // #      
-	0x60, //  ##    
-	0x10, //    #   
-	0x0C, //     ## 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @348 '=' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x7C, //  ##### 
-	0x00, //        
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @360 '>' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0xC0, // ##     
-	0x20, //   #    
-	0x18, //    ##  
-	0x04, //      # 
-	0x18, //    ##  
-	0x20, //   #    
-	0xC0, // ##     
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @372 '?' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x18, //    ##  
-	0x24, //   #  # 
-	0x04, //      # 
-	0x08, //     #  
-	0x10, //    #   
-	0x00, //        
-	0x30, //   ##   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @384 '@' (7 pixels wide)
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x4C, //  #  ## 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x4C, //  #  ## 
-	0x40, //  #     
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-
-	// @396 'A' (7 pixels wide)
-	0x00, //        
-	0x30, //   ##   
-	0x10, //    #   
-	0x28, //   # #  
-	0x28, //   # #  
-	0x28, //   # #  
-	0x7C, //  ##### 
-	0x44, //  #   # 
-	0xEE, // ### ###
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @408 'B' (7 pixels wide)
-	0x00, //        
-	0xF8, // #####  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x78, //  ####  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0xF8, // #####  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @420 'C' (7 pixels wide)
-	0x00, //        
-	0x3C, //   #### 
-	0x44, //  #   # 
-	0x40, //  #     
-	0x40, //  #     
-	0x40, //  #     
-	0x40, //  #     
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @432 'D' (7 pixels wide)
-	0x00, //        
-	0xF0, // ####   
-	0x48, //  #  #  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x48, //  #  #  
-	0xF0, // ####   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @444 'E' (7 pixels wide)
-	0x00, //        
-	0xFC, // ###### 
-	0x44, //  #   # 
-	0x50, //  # #   
-	0x70, //  ###   
-	0x50, //  # #   
-	0x40, //  #     
-	0x44, //  #   # 
-	0xFC, // ###### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @456 'F' (7 pixels wide)
-	0x00, //        
-	0x7E, //  ######
-	0x22, //   #   #
-	0x28, //   # #  
-	0x38, //   ###  
-	0x28, //   # #  
-	0x20, //   #    
-	0x20, //   #    
-	0x70, //  ###   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @468 'G' (7 pixels wide)
-	0x00, //        
-	0x3C, //   #### 
-	0x44, //  #   # 
-	0x40, //  #     
-	0x40, //  #     
-	0x4E, //  #  ###
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @480 'H' (7 pixels wide)
-	0x00, //        
-	0xEE, // ### ###
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x7C, //  ##### 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0xEE, // ### ###
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @492 'I' (7 pixels wide)
-	0x00, //        
-	0x7C, //  ##### 
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @504 'J' (7 pixels wide)
-	0x00, //        
-	0x3C, //   #### 
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x48, //  #  #  
-	0x48, //  #  #  
-	0x48, //  #  #  
-	0x30, //   ##   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @516 'K' (7 pixels wide)
-	0x00, //        
-	0xEE, // ### ###
-	0x44, //  #   # 
-	0x48, //  #  #  
-	0x50, //  # #   
-	0x70, //  ###   
-	0x48, //  #  #  
-	0x44, //  #   # 
-	0xE6, // ###  ##
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @528 'L' (7 pixels wide)
-	0x00, //        
-	0x70, //  ###   
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x24, //   #  # 
-	0x24, //   #  # 
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @540 'M' (7 pixels wide)
-	0x00, //        
-	0xEE, // ### ###
-	0x6C, //  ## ## 
-	0x6C, //  ## ## 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0xEE, // ### ###
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @552 'N' (7 pixels wide)
-	0x00, //        
-	0xEE, // ### ###
-	0x64, //  ##  # 
-	0x64, //  ##  # 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x4C, //  #  ## 
-	0xEC, // ### ## 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @564 'O' (7 pixels wide)
-	0x00, //        
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @576 'P' (7 pixels wide)
-	0x00, //        
-	0x78, //  ####  
-	0x24, //   #  # 
-	0x24, //   #  # 
-	0x24, //   #  # 
-	0x38, //   ###  
-	0x20, //   #    
-	0x20, //   #    
-	0x70, //  ###   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @588 'Q' (7 pixels wide)
-	0x00, //        
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x1C, //    ### 
-	0x00, //        
-	0x00, //        
-
-	// @600 'R' (7 pixels wide)
-	0x00, //        
-	0xF8, // #####  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x78, //  ####  
-	0x48, //  #  #  
-	0x44, //  #   # 
-	0xE2, // ###   #
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @612 'S' (7 pixels wide)
-	0x00, //        
-	0x34, //   ## # 
-	0x4C, //  #  ## 
-	0x40, //  #     
-	0x38, //   ###  
-	0x04, //      # 
-	0x04, //      # 
-	0x64, //  ##  # 
-	0x58, //  # ##  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @624 'T' (7 pixels wide)
-	0x00, //        
-	0xFE, // #######
-	0x92, // #  #  #
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @636 'U' (7 pixels wide)
-	0x00, //        
-	0xEE, // ### ###
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @648 'V' (7 pixels wide)
-	0x00, //        
-	0xEE, // ### ###
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x28, //   # #  
-	0x28, //   # #  
-	0x28, //   # #  
-	0x10, //    #   
-	0x10, //    #   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @660 'W' (7 pixels wide)
-	0x00, //        
-	0xEE, // ### ###
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x28, //   # #  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @672 'X' (7 pixels wide)
-	0x00, //        
-	0xC6, // ##   ##
-	0x44, //  #   # 
-	0x28, //   # #  
-	0x10, //    #   
-	0x10, //    #   
-	0x28, //   # #  
-	0x44, //  #   # 
-	0xC6, // ##   ##
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @684 'Y' (7 pixels wide)
-	0x00, //        
-	0xEE, // ### ###
-	0x44, //  #   # 
-	0x28, //   # #  
-	0x28, //   # #  
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @696 'Z' (7 pixels wide)
-	0x00, //        
-	0x7C, //  ##### 
-	0x44, //  #   # 
-	0x08, //     #  
-	0x10, //    #   
-	0x10, //    #   
-	0x20, //   #    
-	0x44, //  #   # 
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @708 '[' (7 pixels wide)
-	0x00, //        
-	0x38, //   ###  
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x38, //   ###  
-	0x00, //        
-
-	// @720 '\' (7 pixels wide)
-	0x00, //        
-	0x40, //  #     
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x10, //    #   
-	0x10, //    #   
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x00, //        
-	0x00, //        
-
-	// @732 ']' (7 pixels wide)
-	0x00, //        
-	0x38, //   ###  
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x38, //   ###  
-	0x00, //        
-
-	// @744 '^' (7 pixels wide)
-	0x00, //        
-	0x10, //    #   
-	0x10, //    #   
-	0x28, //   # #  
-	0x44, //  #   # 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @756 '_' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0xFE, // #######
-
-	// @768 '`' (7 pixels wide)
-	0x00, //        
-	0x10, //    #   
-	0x08, //     #  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @780 'a' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x3C, //   #### 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x3E, //   #####
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @792 'b' (7 pixels wide)
-	0x00, //        
-	0xC0, // ##     
-	0x40, //  #     
-	0x58, //  # ##  
-	0x64, //  ##  # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0xF8, // #####  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @804 'c' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x3C, //   #### 
-	0x44, //  #   # 
-	0x40, //  #     
-	0x40, //  #     
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @816 'd' (7 pixels wide)
-	0x00, //        
-	0x0C, //     ## 
-	0x04, //      # 
-	0x34, //   ## # 
-	0x4C, //  #  ## 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x3E, //   #####
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @828 'e' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x7C, //  ##### 
-	0x40, //  #     
-	0x40, //  #     
-	0x3C, //   #### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @840 'f' (7 pixels wide)
-	0x00, //        
-	0x1C, //    ### 
-	0x20, //   #    
-	0x7C, //  ##### 
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @852 'g' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x36, //   ## ##
-	0x4C, //  #  ## 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x3C, //   #### 
-	0x04, //      # 
-	0x38, //   ###  
-	0x00, //        
-
-	// @864 'h' (7 pixels wide)
-	0x00, //        
-	0xC0, // ##     
-	0x40, //  #     
-	0x58, //  # ##  
-	0x64, //  ##  # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0xEE, // ### ###
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @876 'i' (7 pixels wide)
-	0x00, //        
-	0x10, //    #   
-	0x00, //        
-	0x70, //  ###   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @888 'j' (7 pixels wide)
-	0x00, //        
-	0x10, //    #   
-	0x00, //        
-	0x78, //  ####  
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x08, //     #  
-	0x70, //  ###   
-	0x00, //        
-
-	// @900 'k' (7 pixels wide)
-	0x00, //        
-	0xC0, // ##     
-	0x40, //  #     
-	0x5C, //  # ### 
-	0x48, //  #  #  
-	0x70, //  ###   
-	0x50, //  # #   
-	0x48, //  #  #  
-	0xDC, // ## ### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @912 'l' (7 pixels wide)
-	0x00, //        
-	0x30, //   ##   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @924 'm' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0xE8, // ### #  
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0xFE, // #######
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @936 'n' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0xD8, // ## ##  
-	0x64, //  ##  # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0xEE, // ### ###
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @948 'o' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x38, //   ###  
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @960 'p' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0xD8, // ## ##  
-	0x64, //  ##  # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x78, //  ####  
-	0x40, //  #     
-	0xE0, // ###    
-	0x00, //        
-
-	// @972 'q' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x36, //   ## ##
-	0x4C, //  #  ## 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x3C, //   #### 
-	0x04, //      # 
-	0x0E, //     ###
-	0x00, //        
-
-	// @984 'r' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x6C, //  ## ## 
-	0x30, //   ##   
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @996 's' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x3C, //   #### 
-	0x44, //  #   # 
-	0x38, //   ###  
-	0x04, //      # 
-	0x44, //  #   # 
-	0x78, //  ####  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @1008 't' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x20, //   #    
-	0x7C, //  ##### 
-	0x20, //   #    
-	0x20, //   #    
-	0x20, //   #    
-	0x22, //   #   #
-	0x1C, //    ### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @1020 'u' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0xCC, // ##  ## 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x4C, //  #  ## 
-	0x36, //   ## ##
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @1032 'v' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0xEE, // ### ###
-	0x44, //  #   # 
-	0x44, //  #   # 
-	0x28, //   # #  
-	0x28, //   # #  
-	0x10, //    #   
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @1044 'w' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0xEE, // ### ###
-	0x44, //  #   # 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x54, //  # # # 
-	0x28, //   # #  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @1056 'x' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0xCC, // ##  ## 
-	0x48, //  #  #  
-	0x30, //   ##   
-	0x30, //   ##   
-	0x48, //  #  #  
-	0xCC, // ##  ## 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @1068 'y' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0xEE, // ### ###
-	0x44, //  #   # 
-	0x24, //   #  # 
-	0x28, //   # #  
-	0x18, //    ##  
-	0x10, //    #   
-	0x10, //    #   
-	0x78, //  ####  
-	0x00, //        
-
-	// @1080 'z' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x7C, //  ##### 
-	0x48, //  #  #  
-	0x10, //    #   
-	0x20, //   #    
-	0x44, //  #   # 
-	0x7C, //  ##### 
-	0x00, //        
-	0x00, //        
-	0x00, //        
-
-	// @1092 '{' (7 pixels wide)
-	0x00, //        
-	0x08, //     #  
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x20, //   #    
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x08, //     #  
-	0x00, //        
-
-	// @1104 '|' (7 pixels wide)
-	0x00, //        
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x00, //        
-	0x00, //        
+static const uint8_t Font12_Bits[] PROGMEM = {
+   // ' '
+  0x45, 0x10, 0x3E, 0x08, 0xA2,  // '%'
+  0x10, 0x20, 0x47, 0xF1, 0x02, 0x04, 0x00,  // '+'
+  0x6B, 0x40,  // ','
+  0xF8,  // '-'
+  0xF0,  // '.'
+  0x74, 0x63, 0x18, 0xC6, 0x2E,  // '0'
+  0x61, 0x08, 0x42, 0x10, 0x9F,  // '1'
+  0x74, 0x42, 0x22, 0x22, 0x3F,  // '2'
+  0x74, 0x42, 0x60, 0x86, 0x2E,  // '3'
+  0x18, 0xA2, 0x92, 0x8B, 0xF0, 0x87,  // '4'
+  0x7A, 0x10, 0xE0, 0x86, 0x2E,  // '5'
+  0x3A, 0x21, 0xE8, 0xC6, 0x2E,  // '6'
+  0xFC, 0x42, 0x21, 0x08, 0x84,  // '7'
+  0x74, 0x62, 0xE8, 0xC6, 0x2E,  // '8'
+  0x74, 0x63, 0x17, 0x84, 0x5C,  // '9'
+  0xF0, 0xF0,  // ':'
+  0x30, 0x20, 0xA1, 0x42, 0x8F, 0x91, 0x77,  // 'A'
+  0x7C, 0x61, 0x08, 0x42, 0x2E,  // 'C'
+  0xF1, 0x24, 0x51, 0x45, 0x14, 0xBC,  // 'D'
+  0xFD, 0x15, 0x1C, 0x51, 0x04, 0x7F,  // 'E'
+  0xFD, 0x15, 0x1C, 0x51, 0x04, 0x38,  // 'F'
+  0x78, 0x84, 0x29, 0x4A, 0x4C,  // 'J'
+  0xE2, 0x10, 0x84, 0x25, 0x3F,  // 'L'
+  0xEE, 0xD9, 0xB2, 0xA5, 0x48, 0x91, 0x77,  // 'M'
+  0xEE, 0xC9, 0x92, 0xA5, 0x4A, 0x93, 0x76,  // 'N'
+  0x74, 0x63, 0x18, 0xC6, 0x2E,  // 'O'
+  0xF2, 0x52, 0x97, 0x21, 0x1C,  // 'P'
+  0x6C, 0xE0, 0xE0, 0x87, 0x36,  // 'S'
+  0xFF, 0x24, 0x40, 0x81, 0x02, 0x04, 0x1C,  // 'T'
+  0xEE, 0x89, 0x12, 0x24, 0x48, 0x91, 0x1C,  // 'U'
+  0xEE, 0x89, 0x12, 0xA5, 0x4A, 0x95, 0x14,  // 'W'
+  0x72, 0x27, 0xA2, 0x89, 0xF0,  // 'a'
+  0xC1, 0x05, 0x99, 0x45, 0x14, 0x7E,  // 'b'
+  0x7C, 0x61, 0x08, 0xB8,  // 'c'
+  0x18, 0x26, 0xA6, 0x8A, 0x28, 0x9F,  // 'd'
+  0x74, 0x7F, 0x08, 0x3C,  // 'e'
+  0x3A, 0x3E, 0x84, 0x21, 0x1F,  // 'f'
+  0x6E, 0x68, 0xA2, 0x89, 0xE0, 0x9C,  // 'g'
+  0xC0, 0x81, 0x63, 0x24, 0x48, 0x91, 0x77,  // 'h'
+  0x20, 0x38, 0x42, 0x10, 0x9F,  // 'i'
+  0x20, 0xF1, 0x11, 0x11, 0x1E,  // 'j'
+  0x61, 0x08, 0x42, 0x10, 0x9F,  // 'l'
+  0xE8, 0xA9, 0x52, 0xA5, 0x5F, 0xC0,  // 'm'
+  0xD8, 0xC9, 0x12, 0x24, 0x5D, 0xC0,  // 'n'
+  0x74, 0x63, 0x18, 0xB8,  // 'o'
+  0xD9, 0x94, 0x51, 0x45, 0xE4, 0x38,  // 'p'
+  0xDB, 0x10, 0x84, 0x7C,  // 'r'
+  0x7C, 0x5C, 0x18, 0xF8,  // 's'
+  0x43, 0xE4, 0x10, 0x41, 0x13, 0x80,  // 't'
+  0xCC, 0x89, 0x12, 0x24, 0xC6, 0xC0,  // 'u'
+  0xEE, 0x89, 0x11, 0x42, 0x82, 0x00,  // 'v'
+  0xEE, 0x89, 0x52, 0xA5, 0x45, 0x00,  // 'w'
+  0xEE, 0x88, 0x91, 0x41, 0x82, 0x04, 0x3C,  // 'y'
+};
 
-	// @1116 '}' (7 pixels wide)
-	0x00, //        
-	0x20, //   #    
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x08, //     #  
-	0x10, //    #   
-	0x10, //    #   
-	0x10, //    #   
-	0x20, //   #    
-	0x00, //        
+static const sGLYPH Font12_Glyphs[] PROGMEM = {
+  { 0, 0, 0, 0, 0, 7 },  // ' '
+  { 0, 1, 8, 1, 5, 7 },  // '%'
+  { 5, 2, 7, 0, 7, 7 },  // '+'
+  { 12, 7, 4, 2, 3, 7 },  // ','
+  { 14, 5, 1, 1, 5, 7 },  // '-'
+  { 15, 7, 2, 2, 2, 7 },  // '.'
+  { 16, 1, 8, 1, 5, 7 },  // '0'
+  { 21, 1, 8, 1, 5, 7 },  // '1'
+  { 26, 1, 8, 1, 5, 7 },  // '2'
+  { 31, 1, 8, 1, 5, 7 },  // '3'
+  { 36, 1, 8, 1, 6, 7 },  // '4'
+  { 42, 1, 8, 1, 5, 7 },  // '5'
+  { 47, 1, 8, 1, 5, 7 },  // '6'
+  { 52, 1, 8, 1, 5, 7 },  // '7'
+  { 57, 1, 8, 1, 5, 7 },  // '8'
+  { 62, 1, 8, 1, 5, 7 },  // '9'
+  { 67, 3, 6, 2, 2, 7 },  // ':'
+  { 69, 1, 8, 0, 7, 7 },  // 'A'
+  { 76, 1, 8, 1, 5, 7 },  // 'C'
+  { 81, 1, 8, 0, 6, 7 },  // 'D'
+  { 87, 1, 8, 0, 6, 7 },  // 'E'
+  { 93, 1, 8, 1, 6, 7 },  // 'F'
+  { 99, 1, 8, 1, 5, 7 },  // 'J'
+  { 104, 1, 8, 1, 5, 7 },  // 'L'
+  { 109, 1, 8, 0, 7, 7 },  // 'M'
+  { 116, 1, 8, 0, 7, 7 },  // 'N'
+  { 123, 1, 8, 1, 5, 7 },  // 'O'
+  { 128, 1, 8, 1, 5, 7 },  // 'P'
+  { 133, 1, 8, 1, 5, 7 },  // 'S'
+  { 138, 1, 8, 0, 7, 7 },  // 'T'
+  { 145, 1, 8, 0, 7, 7 },  // 'U'
+  { 152, 1, 8, 0, 7, 7 },  // 'W'
+  { 159, 3, 6, 1, 6, 7 },  // 'a'
+  { 164, 1, 8, 0, 6, 7 },  // 'b'
+  { 170, 3, 6, 1, 5, 7 },  // 'c'
+  { 174, 1, 8, 1, 6, 7 },  // 'd'
+  { 180, 3, 6, 1, 5, 7 },  // 'e'
+  { 184, 1, 8, 1, 5, 7 },  // 'f'
+  { 189, 3, 8, 1, 6, 7 },  // 'g'
+  { 195, 1, 8, 0, 7, 7 },  // 'h'
+  { 202, 1, 8, 1, 5, 7 },  // 'i'
+  { 207, 1, 10, 1, 4, 7 },  // 'j'
+  { 212, 1, 8, 1, 5, 7 },  // 'l'
+  { 217, 3, 6, 0, 7, 7 },  // 'm'
+  { 223, 3, 6, 0, 7, 7 },  // 'n'
+  { 229, 3, 6, 1, 5, 7 },  // 'o'
+  { 233, 3, 8, 0, 6, 7 },  // 'p'
+  { 239, 3, 6, 1, 5, 7 },  // 'r'
+  { 243, 3, 6, 1, 5, 7 },  // 's'
+  { 247, 2, 7, 1, 6, 7 },  // 't'
+  { 253, 3, 6, 0, 7, 7 },  // 'u'
+  { 259, 3, 6, 0, 7, 7 },  // 'v'
+  { 265, 3, 6, 0, 7, 7 },  // 'w'
+  { 271, 3, 8, 0, 7, 7 },  // 'y'
+};
 
-	// @1128 '~' (7 pixels wide)
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x24, //   #  # 
-	0x58, //  # ##  
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
-	0x00, //        
+static const uint8_t Font12_Index[] PROGMEM = {
+  0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0xFF,
+  0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x11, 0xFF, 0x12, 0x13, 0x14, 0x15, 0xFF, 0xFF, 0xFF, 0x16, 0xFF, 0x17, 0x18, 0x19, 0x1A,
+  0x1B, 0xFF, 0xFF, 0x1C, 0x1D, 0x1E, 0xFF, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0xFF, 0x2A, 0x2B, 0x2C, 0x2D,
+  0x2E, 0xFF, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x34, 0xFF, 0x35, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
 };
 
+static const sPACKED Font12_Packed = { Font12_Bits, Font12_Glyphs, Font12_Index, 0, 0, 0 };
+
 sFONT Font12 = {
-  Font12_Table,
+  0, /* Packed, no full table */
   7, /* Width */
   12, /* Height */
+  &Font12_Packed,
 };
-
-/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
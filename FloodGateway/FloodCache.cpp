@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <string.h>
+#include "FloodCache.h"
+
+FloodCache::FloodCache(const std::vector<std::string>& areas)
+  : _areas(areas), _entries(areas.size()) {
+  for (size_t i = 0; i < areas.size(); i++) {
+    _entries[i].area = areas[i];
+    _entries[i].body = renderWarning(_entries[i].warning);
+  }
+}
+
+bool FloodCache::update(const std::string& area, const floodWarning& warning) {
+  std::lock_guard<std::mutex> guard(_lock);
+  for (cacheEntry& entry : _entries) {
+    if (entry.area != area) {
+      continue;
+    }
+    bool changed = !entry.valid
+                   || entry.warning.severityLevel != warning.severityLevel
+                   || strcmp(entry.warning.time_raised, warning.time_raised) != 0
+                   || strcmp(entry.warning.flood_area_id, warning.flood_area_id) != 0;
+    entry.valid = true;
+    if (changed) {
+      entry.warning = warning;
+      entry.etag++;
+      entry.body = renderWarning(warning);
+    }
+    return changed;
+  }
+  return false;
+}
+
+bool FloodCache::lookup(const std::string& area, cacheEntry* entry) {
+  std::lock_guard<std::mutex> guard(_lock);
+  for (const cacheEntry& e : _entries) {
+    if (e.area == area) {
+      *entry = e;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string renderWarning(const floodWarning& warning) {
+  char body[160];
+  if (warning.severityLevel) {
+    snprintf(body, sizeof(body),
+             "{\"items\":{\"currentWarning\":{\"severityLevel\":%d,\"floodAreaID\":\"%s\",\"timeRaised\":\"%s\"}}}",
+             warning.severityLevel, warning.flood_area_id, warning.time_raised);
+  } else {
+    snprintf(body, sizeof(body), "{\"items\":{}}");
+  }
+  return body;
+}
@@ -0,0 +1,46 @@
+#ifndef _FLOOD_CACHE_H_
+#define _FLOOD_CACHE_H_
+
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define DATESTR_LEN 20     // "2022-12-19T15:20:31"
+#define FLOOD_AREA_LEN 20  // Flood area description
+
+// Parsed currentWarning for one flood area, as held by the devices
+struct floodWarning {
+  char time_raised[DATESTR_LEN] = { '\0' };
+  int severityLevel = 0;
+  char flood_area_id[FLOOD_AREA_LEN] = { '\0' };
+};
+
+struct cacheEntry {
+  std::string area;
+  floodWarning warning;
+  uint32_t etag = 0;     // Bumped whenever the warning changes
+  bool valid = false;    // At least one successful upstream poll
+  std::string body;      // Pre-rendered response body
+};
+
+// Latest warning per area, written by the poller and read by the server
+class FloodCache {
+public:
+  explicit FloodCache(const std::vector<std::string>& areas);
+  const std::vector<std::string>& areas(void) const { return _areas; }
+  // Returns true if the stored warning changed
+  bool update(const std::string& area, const floodWarning& warning);
+  // Copies the entry out under the lock, false if the area is not served
+  bool lookup(const std::string& area, cacheEntry* entry);
+
+private:
+  std::vector<std::string> _areas;
+  std::vector<cacheEntry> _entries;
+  std::mutex _lock;
+};
+
+// Same shape as the filtered EA response so devices parse it unchanged
+std::string renderWarning(const floodWarning& warning);
+
+#endif
@@ -0,0 +1,238 @@
+/*
+  Local caching gateway for Flood Magnet and Flood Falcon devices
+
+  Polls the Environment Agency flood-monitoring API once per flood area
+  and serves the cached currentWarning to any number of devices on the
+  LAN, using the same request path as the EA API. Responses carry an
+  ETag so devices can poll with If-None-Match and get a 304 when
+  nothing has changed.
+
+  Changes are also pushed to devices as UDP notifications (FloodNotify.h)
+  as soon as they are seen upstream, and repeated every poll cycle in
+  case a packet is lost.
+
+  Usage: floodgateway [-p port] [-u host[:port]] [-i secs] [-t threads]
+                      [-b broadcast] [-n notify_port] AREA_CODE...
+
+  "this uses Environment Agency flood and river level data from the real-time data API (Beta)"
+
+  Copyright 2022 Peter Milne
+  Released under GNU GENERAL PUBLIC LICENSE
+  Version 3, 29 June 2007
+*/
+
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FloodCache.h"
+#include "FloodNotify.h"
+#include "Notifier.h"
+#include "Upstream.h"
+
+#define DEFAULT_PORT 8080
+#define DEFAULT_UPSTREAM "environment.data.gov.uk"
+#define DEFAULT_INTERVAL 5 * 60  // 5 mins, shared by every device
+#define DEFAULT_THREADS 4
+#define DEFAULT_BROADCAST "255.255.255.255"
+#define REQUEST_LEN 1024
+#define CLIENT_TIMEOUT 5  // Seconds before a slow device is dropped
+
+#define AREA_PATH "/flood-monitoring/id/floodAreas/"
+
+static long startTime;  // Mixed into ETags so a restart invalidates them
+
+static void pollUpstream(FloodCache* cache, Notifier* notifier, std::string host, int port, int interval) {
+  cacheEntry entry;
+  while (true) {
+    for (const std::string& area : cache->areas()) {
+      floodWarning warning;
+      if (fetchWarning(host, port, area, &warning)) {
+        if (cache->update(area, warning) && cache->lookup(area, &entry)) {
+          printf("%s: level %d raised %s\n", area.c_str(), warning.severityLevel, warning.time_raised);
+          notifier->send(entry);
+        }
+      } else {
+        fprintf(stderr, "%s: upstream poll failed\n", area.c_str());
+      }
+    }
+    // Repeat the current state, UDP is not reliable
+    for (const std::string& area : cache->areas()) {
+      if (cache->lookup(area, &entry) && entry.valid) {
+        notifier->send(entry);
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(interval));
+  }
+}
+
+static void sendAll(int fd, const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n <= 0) {
+      return;
+    }
+    sent += n;
+  }
+}
+
+static std::string statusOnly(const char* status) {
+  return std::string("HTTP/1.1 ") + status + "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+}
+
+// One request per connection, matching the devices' "Connection: close"
+static void handleClient(int fd, FloodCache* cache) {
+  char request[REQUEST_LEN + 1];
+  size_t len = 0;
+  while (len < REQUEST_LEN) {
+    ssize_t n = recv(fd, request + len, REQUEST_LEN - len, 0);
+    if (n <= 0) {
+      return;
+    }
+    len += n;
+    request[len] = '\0';
+    if (strstr(request, "\r\n\r\n")) {
+      break;
+    }
+  }
+  request[len] = '\0';
+
+  if (strncmp(request, "GET " AREA_PATH, 4 + strlen(AREA_PATH)) != 0) {
+    sendAll(fd, statusOnly("400 Bad Request"));
+    return;
+  }
+  const char* area = request + 4 + strlen(AREA_PATH);
+  std::string code(area, strcspn(area, " ?\r\n"));
+
+  cacheEntry entry;
+  if (!cache->lookup(code, &entry)) {
+    sendAll(fd, statusOnly("404 Not Found"));
+    return;
+  }
+  if (!entry.valid) {
+    sendAll(fd, statusOnly("503 Service Unavailable"));
+    return;
+  }
+
+  char etag[32];
+  snprintf(etag, sizeof(etag), "\"%lx-%u\"", startTime, entry.etag);
+  char date[40];
+  time_t now = time(NULL);
+  struct tm gmt;
+  strftime(date, sizeof(date), "%a, %d %b %Y %H:%M:%S GMT", gmtime_r(&now, &gmt));
+
+  const char* match = strstr(request, "If-None-Match: ");
+  std::string headers = std::string("Date: ") + date + "\r\nETag: " + etag + "\r\nConnection: close\r\n";
+  if (match && strncmp(match + 15, etag, strlen(etag)) == 0) {
+    sendAll(fd, "HTTP/1.1 304 Not Modified\r\n" + headers + "\r\n");
+    return;
+  }
+  sendAll(fd, "HTTP/1.1 200 OK\r\n" + headers
+                + "Content-Type: application/json\r\nContent-Length: " + std::to_string(entry.body.size())
+                + "\r\n\r\n" + entry.body);
+}
+
+static void serve(int listener, FloodCache* cache) {
+  while (true) {
+    int fd = accept(listener, NULL, NULL);
+    if (fd < 0) {
+      continue;
+    }
+    struct timeval tv = { CLIENT_TIMEOUT, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    handleClient(fd, cache);
+    close(fd);
+  }
+}
+
+static void usage(const char* name) {
+  fprintf(stderr, "Usage: %s [-p port] [-u host[:port]] [-i secs] [-t threads] [-b broadcast] [-n notify_port] AREA_CODE...\n", name);
+  exit(1);
+}
+
+int main(int argc, char* argv[]) {
+  int port = DEFAULT_PORT;
+  std::string upstream = DEFAULT_UPSTREAM;
+  int upstreamPort = 80;
+  int interval = DEFAULT_INTERVAL;
+  int threads = DEFAULT_THREADS;
+  const char* broadcast = DEFAULT_BROADCAST;
+  int notifyPort = NOTIFY_PORT;
+  int opt;
+  while ((opt = getopt(argc, argv, "p:u:i:t:b:n:")) != -1) {
+    switch (opt) {
+      case 'p':
+        port = atoi(optarg);
+        break;
+      case 'u': {
+        upstream = optarg;
+        size_t colon = upstream.rfind(':');
+        if (colon != std::string::npos) {
+          upstreamPort = atoi(upstream.c_str() + colon + 1);
+          upstream.resize(colon);
+        }
+        break;
+      }
+      case 'i':
+        interval = atoi(optarg);
+        break;
+      case 't':
+        threads = atoi(optarg);
+        break;
+      case 'b':
+        broadcast = optarg;
+        break;
+      case 'n':
+        notifyPort = atoi(optarg);
+        break;
+      default:
+        usage(argv[0]);
+    }
+  }
+  if (optind >= argc || threads < 1 || interval < 1) {
+    usage(argv[0]);
+  }
+  signal(SIGPIPE, SIG_IGN);
+  setvbuf(stdout, NULL, _IOLBF, 0);
+  startTime = (long)time(NULL);
+
+  FloodCache cache(std::vector<std::string>(argv + optind, argv + argc));
+
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  int on = 1;
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (bind(listener, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, 128) != 0) {
+    perror("listen");
+    return 1;
+  }
+  printf("Serving %zu areas on port %d from %s:%d\n", cache.areas().size(), port, upstream.c_str(), upstreamPort);
+
+  Notifier notifier;
+  if (notifyPort && !notifier.begin(broadcast, notifyPort)) {
+    fprintf(stderr, "Notifications disabled, bad address %s\n", broadcast);
+  }
+
+  std::thread poller(pollUpstream, &cache, &notifier, upstream, upstreamPort, interval);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; i++) {
+    workers.emplace_back(serve, listener, &cache);
+  }
+  poller.join();
+  return 0;
+}
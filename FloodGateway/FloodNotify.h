@@ -0,0 +1,72 @@
+#ifndef _FLOOD_NOTIFY_H_
+#define _FLOOD_NOTIFY_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// UDP change notification sent by FloodGateway to devices on the LAN.
+// Shared by the gateway and the sketches, keep all copies identical.
+//
+// 32 bytes, multi-byte fields big endian:
+//   0  'F' 'N'      magic
+//   2  version      NOTIFY_VERSION
+//   3  severity     warning_levels value
+//   4  time_raised  seconds since 1970 UTC, 0 if unknown
+//   8  seq          bumped by the gateway whenever the area changes
+//   12 area         flood area code, NUL padded
+
+#define NOTIFY_PORT 4210
+#define NOTIFY_VERSION 1
+#define NOTIFY_LEN 32
+#define NOTIFY_AREA_LEN 20
+
+struct floodNotify {
+  uint8_t severity = 0;
+  uint32_t time_raised = 0;
+  uint32_t seq = 0;
+  char area[NOTIFY_AREA_LEN + 1] = { '\0' };
+};
+
+inline void putU32(uint8_t* p, uint32_t v) {
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+inline uint32_t getU32(const uint8_t* p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+inline void encodeNotify(const floodNotify& n, uint8_t* buf) {
+  memset(buf, 0, NOTIFY_LEN);
+  buf[0] = 'F';
+  buf[1] = 'N';
+  buf[2] = NOTIFY_VERSION;
+  buf[3] = n.severity;
+  putU32(buf + 4, n.time_raised);
+  putU32(buf + 8, n.seq);
+  size_t areaLen = strlen(n.area);
+  memcpy(buf + 12, n.area, areaLen < NOTIFY_AREA_LEN ? areaLen : NOTIFY_AREA_LEN);
+}
+
+inline bool decodeNotify(const uint8_t* buf, size_t len, floodNotify* n) {
+  if (len < NOTIFY_LEN || buf[0] != 'F' || buf[1] != 'N' || buf[2] != NOTIFY_VERSION) {
+    return false;
+  }
+  n->severity = buf[3];
+  n->time_raised = getU32(buf + 4);
+  n->seq = getU32(buf + 8);
+  memcpy(n->area, buf + 12, NOTIFY_AREA_LEN);
+  n->area[NOTIFY_AREA_LEN] = '\0';
+  return true;
+}
+
+// Only notifications for the area a device watches are applied.
+// A code longer than the packet holds never matches.
+inline bool notifyFor(const floodNotify& n, const char* area) {
+  return strlen(area) <= NOTIFY_AREA_LEN && strcmp(n.area, area) == 0;
+}
+
+#endif
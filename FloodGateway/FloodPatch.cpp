@@ -0,0 +1,165 @@
+#include "FloodPatch.h"
+
+uint32_t patchCrc(uint32_t crc, uint8_t b) {
+  crc ^= b;
+  for (int bit = 0; bit < 8; bit++) {
+    crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1));
+  }
+  return crc;
+}
+
+static int hexDigit(char c) {
+  return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+}
+
+bool parseKey(const char* hex, uint8_t key[PATCH_KEY_LEN]) {
+  for (int i = 0; i < PATCH_KEY_LEN; i++) {
+    int hi = hexDigit(hex[2 * i]);
+    int lo = hi < 0 ? -1 : hexDigit(hex[2 * i + 1]);
+    if (lo < 0) {
+      return false;
+    }
+    key[i] = hi << 4 | lo;
+  }
+  return hex[2 * PATCH_KEY_LEN] == '\0';
+}
+
+static uint32_t getLE(const uint8_t* p) {
+  return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+bool PatchApplier::fail(const char* error) {
+  _error = error;
+  _state = STATE_FAILED;
+  return false;
+}
+
+bool PatchApplier::feed(const uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (_state < STATE_TAG) {
+      _hmac.update(data[i]);
+    }
+    if (!feedByte(data[i])) {
+      return false;
+    }
+  }
+  return _state != STATE_FAILED;
+}
+
+// True once a whole varint is in _var
+bool PatchApplier::readVarint(uint8_t b) {
+  _var |= (uint32_t)(b & 0x7F) << _varShift;
+  _varShift += 7;
+  return !(b & 0x80) || _varShift >= 35;
+}
+
+// Only patch the image the patch was made from
+bool PatchApplier::checkOld(void) {
+  uint32_t crc = 0xFFFFFFFFUL;
+  for (uint32_t i = 0; i < _header.oldLen; i++) {
+    crc = patchCrc(crc, _target->readOld(i));
+  }
+  return ~crc == _header.oldCrc;
+}
+
+bool PatchApplier::put(uint8_t b) {
+  if (_written >= _header.newLen) {
+    return fail("Patch runs past the new image");
+  }
+  if (!_target->write(b)) {
+    return fail("Write failed");
+  }
+  _crc = patchCrc(_crc, b);
+  _written++;
+  return true;
+}
+
+// Finish an op, the ops end when the new image is complete
+bool PatchApplier::nextOp(void) {
+  _var = 0;
+  _varShift = 0;
+  if (_written == _header.newLen) {
+    _crc = ~_crc;
+    _hmac.finish(_mac);
+    _state = STATE_TAG;
+  } else {
+    _state = STATE_CONTROL;
+  }
+  return true;
+}
+
+bool PatchApplier::feedByte(uint8_t b) {
+  switch (_state) {
+    case STATE_HEADER:
+      _buf[_bufLen++] = b;
+      if (_bufLen < PATCH_HEADER_LEN) {
+        return true;
+      }
+      if (getLE(_buf) != PATCH_MAGIC) {
+        return fail("Not a patch");
+      }
+      _header.oldLen = getLE(_buf + 4);
+      _header.oldCrc = getLE(_buf + 8);
+      _header.newLen = getLE(_buf + 12);
+      _header.newCrc = getLE(_buf + 16);
+      if (!checkOld()) {
+        return fail("Patch is for a different image");
+      }
+      return nextOp();
+
+    case STATE_CONTROL:
+      if (!readVarint(b)) {
+        return true;
+      }
+      _opLen = _var >> 1;
+      if (_opLen == 0) {
+        return fail("Empty op");
+      }
+      _state = (_var & 1) == PATCH_COPY ? STATE_OFFSET : STATE_LITERAL;
+      _var = 0;
+      _varShift = 0;
+      return true;
+
+    case STATE_OFFSET: {
+      if (!readVarint(b)) {
+        return true;
+      }
+      int32_t delta = (int32_t)(_var >> 1) ^ -(int32_t)(_var & 1);
+      _oldPos += delta;
+      if (_oldPos > _header.oldLen || _opLen > _header.oldLen - _oldPos) {
+        return fail("Copy outside the old image");
+      }
+      for (uint32_t i = 0; i < _opLen; i++) {
+        if (!put(_target->readOld(_oldPos++))) {
+          return false;
+        }
+      }
+      return nextOp();
+    }
+
+    case STATE_LITERAL:
+      if (!put(b)) {
+        return false;
+      }
+      if (--_opLen == 0) {
+        return nextOp();
+      }
+      return true;
+
+    // Compared in full, so the time taken gives nothing away
+    case STATE_TAG:
+      _tagDiff |= b ^ _mac[_tagLen++];
+      if (_tagLen < HMAC_LEN) {
+        return true;
+      }
+      if (_tagDiff) {
+        return fail("Patch not signed with this device's key");
+      }
+      _state = STATE_DONE;
+      return true;
+
+    case STATE_DONE:
+      return true;  // Ignore trailing bytes
+  }
+  return false;
+}
@@ -0,0 +1,42 @@
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "FloodNotify.h"
+#include "Notifier.h"
+#include "Upstream.h"
+
+bool Notifier::begin(const char* address, int port) {
+  _fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (_fd < 0) {
+    return false;
+  }
+  int on = 1;
+  setsockopt(_fd, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+  memset(&_dest, 0, sizeof(_dest));
+  _dest.sin_family = AF_INET;
+  _dest.sin_port = htons(port);
+  if (inet_pton(AF_INET, address, &_dest.sin_addr) != 1) {
+    close(_fd);
+    _fd = -1;
+    return false;
+  }
+  return true;
+}
+
+void Notifier::send(const cacheEntry& entry) {
+  if (_fd < 0) {
+    return;
+  }
+  floodNotify n;
+  n.severity = entry.warning.severityLevel;
+  n.time_raised = parseTimeRaised(entry.warning.time_raised);
+  n.seq = entry.etag;
+  strncpy(n.area, entry.area.c_str(), NOTIFY_AREA_LEN);
+  uint8_t buf[NOTIFY_LEN];
+  encodeNotify(n, buf);
+  if (sendto(_fd, buf, sizeof(buf), 0, (struct sockaddr*)&_dest, sizeof(_dest)) != sizeof(buf)) {
+    perror("notify");
+  }
+}
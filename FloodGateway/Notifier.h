@@ -0,0 +1,18 @@
+#ifndef _NOTIFIER_H_
+#define _NOTIFIER_H_
+
+#include <netinet/in.h>
+#include "FloodCache.h"
+
+// Broadcasts FloodNotify packets to devices on the LAN
+class Notifier {
+public:
+  bool begin(const char* address, int port);
+  void send(const cacheEntry& entry);
+
+private:
+  int _fd = -1;
+  struct sockaddr_in _dest;
+};
+
+#endif
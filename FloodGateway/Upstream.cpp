@@ -0,0 +1,135 @@
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include "Upstream.h"
+
+#define UPSTREAM_TIMEOUT 10  // Seconds per connect / read
+
+static int connectTo(const std::string& host, int port) {
+  struct addrinfo hints;
+  struct addrinfo* res;
+  char service[8];
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  snprintf(service, sizeof(service), "%d", port);
+  if (getaddrinfo(host.c_str(), service, &hints, &res) != 0) {
+    return -1;
+  }
+  int fd = -1;
+  for (struct addrinfo* ai = res; ai; ai = ai->ai_next) {
+    fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    struct timeval tv = { UPSTREAM_TIMEOUT, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+      break;
+    }
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(res);
+  return fd;
+}
+
+// Find "key" after from, leave p at the first char of its value
+static const char* findValue(const char* from, const char* key) {
+  char quoted[40];
+  snprintf(quoted, sizeof(quoted), "\"%s\"", key);
+  const char* p = strstr(from, quoted);
+  if (!p) {
+    return NULL;
+  }
+  p += strlen(quoted);
+  while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' || *p == ':') {
+    p++;
+  }
+  return p;
+}
+
+static void copyString(const char* p, char* out, size_t len) {
+  size_t i = 0;
+  if (p && *p == '"') {
+    p++;
+    while (*p && *p != '"' && i < len - 1) {
+      out[i++] = *p++;
+    }
+  }
+  out[i] = '\0';
+}
+
+bool parseWarning(const char* body, floodWarning* warning) {
+  if (!strstr(body, "\"items\"")) {
+    return false;
+  }
+  floodWarning parsed;
+  const char* current = strstr(body, "\"currentWarning\"");
+  if (current) {  // No currentWarning means no warning in force
+    const char* p = findValue(current, "severityLevel");
+    if (!p) {
+      return false;
+    }
+    parsed.severityLevel = atoi(p);
+    copyString(findValue(current, "floodAreaID"), parsed.flood_area_id, FLOOD_AREA_LEN);
+    copyString(findValue(current, "timeRaised"), parsed.time_raised, DATESTR_LEN);
+  }
+  *warning = parsed;
+  return true;
+}
+
+int httpGet(const std::string& host, int port, const std::string& path) {
+  int fd = connectTo(host, port);
+  if (fd < 0) {
+    return -1;
+  }
+  std::string request = "GET " + path + " HTTP/1.0\r\n"
+                        "Host: " + host + "\r\n"
+                        "Connection: close\r\n\r\n";
+  if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != (ssize_t)request.size()) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+bool fetchWarning(const std::string& host, int port, const std::string& area, floodWarning* warning) {
+  int fd = httpGet(host, port, "/flood-monitoring/id/floodAreas/" + area);
+  if (fd < 0) {
+    return false;
+  }
+  std::string response;
+  char buf[4096];
+  ssize_t n;
+  while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+    response.append(buf, n);
+  }
+  close(fd);
+  // should be "HTTP/1.0 200 OK"
+  if (n < 0 || response.size() < 12 || response.compare(9, 3, "200") != 0) {
+    return false;
+  }
+  size_t body = response.find("\r\n\r\n");
+  if (body == std::string::npos) {
+    return false;
+  }
+  return parseWarning(response.c_str() + body + 4, warning);
+}
+
+uint32_t parseTimeRaised(const char* str) {
+  struct tm t;
+  memset(&t, 0, sizeof(t));
+  if (sscanf(str, "%4d-%2d-%2dT%2d:%2d:%2d", &t.tm_year, &t.tm_mon, &t.tm_mday, &t.tm_hour, &t.tm_min, &t.tm_sec) != 6) {
+    return 0;
+  }
+  t.tm_year -= 1900;
+  t.tm_mon -= 1;
+  return (uint32_t)timegm(&t);
+}
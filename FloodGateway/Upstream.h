@@ -0,0 +1,22 @@
+#ifndef _UPSTREAM_H_
+#define _UPSTREAM_H_
+
+#include <string>
+#include "FloodCache.h"
+
+// Connect and send a plain HTTP/1.0 GET for path, returns the socket
+// to read the response from or -1 on error
+int httpGet(const std::string& host, int port, const std::string& path);
+
+// Fetch /flood-monitoring/id/floodAreas/<area> over plain HTTP and
+// extract items.currentWarning. Returns false on any network, HTTP or
+// parse error, leaving warning untouched.
+bool fetchWarning(const std::string& host, int port, const std::string& area, floodWarning* warning);
+
+// Extract currentWarning fields from a floodArea JSON body
+bool parseWarning(const char* body, floodWarning* warning);
+
+// "2022-12-19T15:20:31" to seconds since 1970 UTC, 0 if unparseable
+uint32_t parseTimeRaised(const char* str);
+
+#endif
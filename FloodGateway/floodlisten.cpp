@@ -0,0 +1,64 @@
+/*
+  Simulated device for FloodGateway push notifications
+
+  Listens for FloodNotify packets and prints each new change with the
+  delay between the change being raised and the packet arriving.
+
+  Usage: floodlisten [-n notify_port] [AREA_CODE]
+*/
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "FloodNotify.h"
+
+int main(int argc, char* argv[]) {
+  int port = NOTIFY_PORT;
+  int opt;
+  while ((opt = getopt(argc, argv, "n:")) != -1) {
+    if (opt == 'n') {
+      port = atoi(optarg);
+    } else {
+      fprintf(stderr, "Usage: %s [-n notify_port] [AREA_CODE]\n", argv[0]);
+      return 1;
+    }
+  }
+  const char* area = optind < argc ? argv[optind] : NULL;
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  int on = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+    perror("bind");
+    return 1;
+  }
+  setvbuf(stdout, NULL, _IOLBF, 0);
+
+  uint32_t lastSeq = 0;
+  uint8_t buf[64];
+  while (true) {
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    floodNotify notify;
+    if (n < 0 || !decodeNotify(buf, n, &notify)) {
+      continue;
+    }
+    if ((area && !notifyFor(notify, area)) || notify.seq == lastSeq) {
+      continue;  // Other area or a repeat
+    }
+    lastSeq = notify.seq;
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    printf("%ld.%03ld %s level %u raised %u seq %u\n", (long)now.tv_sec, (long)(now.tv_usec / 1000),
+           notify.area, notify.severity, notify.time_raised, notify.seq);
+  }
+}
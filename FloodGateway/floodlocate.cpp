@@ -0,0 +1,188 @@
+/*
+  Find the flood areas that contain a site
+
+  Lists the flood areas near a lat / long from the EA API, then streams
+  each area's polygon through PolygonLocator to check whether the site
+  actually lies inside it. Polygons are never held in memory, so large
+  areas cost no more than small ones. Bytes parsed and the parse rate
+  are shown for each area.
+
+  Usage: floodlocate [-u host[:port]] [-d dist_km] LAT LONG
+
+  "this uses Environment Agency flood and river level data from the real-time data API (Beta)"
+
+  Copyright 2022 Peter Milne
+  Released under GNU GENERAL PUBLIC LICENSE
+  Version 3, 29 June 2007
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "FloodPolygon.h"
+#include "Upstream.h"
+
+#define DEFAULT_UPSTREAM "environment.data.gov.uk"
+#define DEFAULT_DIST "1"
+
+#define AREA_PATH "/flood-monitoring/id/floodAreas"
+
+struct candidate {
+  std::string code;
+  std::string label;
+};
+
+static double elapsed(const struct timeval& start) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return (now.tv_sec - start.tv_sec) + (now.tv_usec - start.tv_usec) / 1e6;
+}
+
+static geoPoint toMicroDegrees(double lat, double lon) {
+  geoPoint p = { (int32_t)(lat * 1e6 + (lat < 0 ? -0.5 : 0.5)), (int32_t)(lon * 1e6 + (lon < 0 ? -0.5 : 0.5)) };
+  return p;
+}
+
+// Read the response status and headers, false unless 200
+static bool skipHeaders(int fd, std::string* rest) {
+  std::string head;
+  char buf[1024];
+  ssize_t n;
+  while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+    head.append(buf, n);
+    size_t end = head.find("\r\n\r\n");
+    if (end != std::string::npos) {
+      *rest = head.substr(end + 4);
+      // should be "HTTP/1.0 200 OK"
+      return head.size() >= 12 && head.compare(9, 3, "200") == 0;
+    }
+  }
+  return false;
+}
+
+// Value of each "key" : "value" pair in a small JSON body
+static std::vector<std::string> findStrings(const std::string& body, const char* key) {
+  std::vector<std::string> values;
+  std::string quoted = std::string("\"") + key + "\"";
+  size_t pos = 0;
+  while ((pos = body.find(quoted, pos)) != std::string::npos) {
+    size_t start = body.find('"', body.find(':', pos) + 1);
+    size_t end = body.find('"', start + 1);
+    if (start == std::string::npos || end == std::string::npos) {
+      break;
+    }
+    values.push_back(body.substr(start + 1, end - start - 1));
+    pos = end;
+  }
+  return values;
+}
+
+static bool fetchCandidates(const std::string& host, int port, const char* lat, const char* lon, const char* dist, std::vector<candidate>* areas) {
+  int fd = httpGet(host, port, std::string(AREA_PATH "?lat=") + lat + "&long=" + lon + "&dist=" + dist);
+  if (fd < 0) {
+    return false;
+  }
+  std::string body;
+  bool ok = skipHeaders(fd, &body);
+  char buf[4096];
+  ssize_t n;
+  while (ok && (n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+    body.append(buf, n);
+  }
+  close(fd);
+  if (!ok) {
+    return false;
+  }
+  std::vector<std::string> codes = findStrings(body, "fwdCode");
+  std::vector<std::string> labels = findStrings(body, "label");
+  for (size_t i = 0; i < codes.size(); i++) {
+    areas->push_back({ codes[i], i < labels.size() ? labels[i] : "" });
+  }
+  return true;
+}
+
+static bool locate(const std::string& host, int port, const std::string& area, PolygonLocator* locator) {
+  int fd = httpGet(host, port, AREA_PATH "/" + area + "/polygon");
+  if (fd < 0) {
+    return false;
+  }
+  std::string rest;
+  bool ok = skipHeaders(fd, &rest);
+  locator->feed(rest.data(), rest.size());
+  char buf[4096];
+  ssize_t n;
+  while (ok && (n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+    locator->feed(buf, n);
+  }
+  close(fd);
+  return ok && locator->valid();
+}
+
+static void usage(const char* name) {
+  fprintf(stderr, "Usage: %s [-u host[:port]] [-d dist_km] LAT LONG\n", name);
+}
+
+int main(int argc, char* argv[]) {
+  std::string upstream = DEFAULT_UPSTREAM;
+  int upstreamPort = 80;
+  const char* dist = DEFAULT_DIST;
+  int opt;
+  // "+" stops at LAT so a negative LONG is not taken as an option
+  while ((opt = getopt(argc, argv, "+u:d:")) != -1) {
+    switch (opt) {
+      case 'u': {
+        upstream = optarg;
+        size_t colon = upstream.rfind(':');
+        if (colon != std::string::npos) {
+          upstreamPort = atoi(upstream.c_str() + colon + 1);
+          upstream.resize(colon);
+        }
+        break;
+      }
+      case 'd':
+        dist = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        return 1;
+    }
+  }
+  if (argc - optind != 2) {
+    usage(argv[0]);
+    return 1;
+  }
+  const char* lat = argv[optind];
+  const char* lon = argv[optind + 1];
+  geoPoint site = toMicroDegrees(atof(lat), atof(lon));
+
+  std::vector<candidate> areas;
+  if (!fetchCandidates(upstream, upstreamPort, lat, lon, dist, &areas)) {
+    fprintf(stderr, "Failed to list flood areas\n");
+    return 1;
+  }
+  printf("%zu flood areas within %s km, parser state %zu bytes\n", areas.size(), dist, sizeof(PolygonLocator));
+
+  int found = 0;
+  for (const candidate& area : areas) {
+    PolygonLocator locator;
+    locator.begin(site);
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    bool ok = locate(upstream, upstreamPort, area.code, &locator);
+    double secs = elapsed(start);
+    if (!ok) {
+      printf("%-20s  error    %s\n", area.code.c_str(), area.label.c_str());
+      continue;
+    }
+    found += locator.contains();
+    printf("%-20s  %-7s  %s\n", area.code.c_str(), locator.contains() ? "inside" : "outside", area.label.c_str());
+    printf("%22s%u points, %u bytes in %.2fs (%.0f kB/s)\n", "", locator.points(), locator.bytes(), secs,
+           secs > 0 ? locator.bytes() / secs / 1000 : 0);
+  }
+  return found ? 0 : 2;
+}
@@ -0,0 +1,263 @@
+/*
+  Make and test firmware delta patches for over the air updates
+
+  key prints a new random OTA key. Keep it in a file off the OTA
+  server, and set it on each device with "set otaKey" over serial.
+
+  diff builds a patch (see FloodPatch.h) that turns the OLD .bin into
+  the NEW one, signed with the key in KEYFILE. Put it on the OTA server
+  as firmware/<name>-<old version>.patch, devices running that version
+  fetch it and apply it.
+
+  apply rebuilds NEW from OLD and PATCH with the same streaming code as
+  the devices, fed in small chunks into a simulated flash, and checks
+  the result and the signature. A failed patch leaves OUT unwritten, as
+  a device keeps its running image.
+
+  Usage: floodpatch key > KEYFILE
+         floodpatch diff KEYFILE OLD NEW PATCH
+         floodpatch apply KEYFILE OLD PATCH OUT
+
+  Copyright 2022 Peter Milne
+  Released under GNU GENERAL PUBLIC LICENSE
+  Version 3, 29 June 2007
+*/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "FloodPatch.h"
+
+#define MATCH_KEY 8      // Bytes hashed to find copy candidates
+#define MIN_MATCH 12     // Shorter matches cost more than a literal
+#define MAX_CANDIDATES 32
+#define DEVICE_CHUNK 64  // Bytes per read on the devices
+
+typedef std::vector<uint8_t> bytes;
+
+static bool readFile(const char* path, bytes* data) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    data->insert(data->end(), buf, buf + n);
+  }
+  fclose(f);
+  return true;
+}
+
+static bool writeFile(const char* path, const bytes& data) {
+  FILE* f = fopen(path, "wb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+  return fclose(f) == 0 && ok;
+}
+
+static uint32_t crc32(const bytes& data) {
+  uint32_t crc = 0xFFFFFFFFUL;
+  for (uint8_t b : data) {
+    crc = patchCrc(crc, b);
+  }
+  return ~crc;
+}
+
+static void putLE(bytes* out, uint32_t v) {
+  for (int i = 0; i < 4; i++) {
+    out->push_back(v >> (8 * i));
+  }
+}
+
+static void putVarint(bytes* out, uint32_t v) {
+  while (v >= 0x80) {
+    out->push_back((v & 0x7F) | 0x80);
+    v >>= 7;
+  }
+  out->push_back(v);
+}
+
+static uint64_t matchKey(const bytes& data, size_t pos) {
+  uint64_t k;
+  memcpy(&k, &data[pos], MATCH_KEY);
+  return k;
+}
+
+static size_t matchLen(const bytes& a, size_t ap, const bytes& b, size_t bp) {
+  size_t n = 0;
+  while (ap + n < a.size() && bp + n < b.size() && a[ap + n] == b[bp + n]) {
+    n++;
+  }
+  return n;
+}
+
+static void flushLiteral(bytes* patch, const bytes& data, size_t from, size_t to) {
+  if (to > from) {
+    putVarint(patch, (to - from) << 1 | PATCH_ADD);
+    patch->insert(patch->end(), data.begin() + from, data.begin() + to);
+  }
+}
+
+// 64 hex digits, trailing whitespace allowed
+static bool readKey(const char* path, uint8_t key[PATCH_KEY_LEN]) {
+  bytes text;
+  if (!readFile(path, &text)) {
+    return false;
+  }
+  while (!text.empty() && isspace(text.back())) {
+    text.pop_back();
+  }
+  text.push_back('\0');
+  if (!parseKey((const char*)text.data(), key)) {
+    fprintf(stderr, "%s: not a key, make one with floodpatch key\n", path);
+    return false;
+  }
+  return true;
+}
+
+static int newKey(void) {
+  uint8_t key[PATCH_KEY_LEN];
+  FILE* f = fopen("/dev/urandom", "rb");
+  if (!f || fread(key, 1, sizeof(key), f) != sizeof(key)) {
+    perror("/dev/urandom");
+    return 1;
+  }
+  fclose(f);
+  for (uint8_t b : key) {
+    printf("%02x", b);
+  }
+  printf("\n");
+  return 0;
+}
+
+// Greedy longest match against an index of the old image
+static bytes makePatch(const bytes& oldImg, const bytes& newImg, const uint8_t key[PATCH_KEY_LEN]) {
+  std::unordered_map<uint64_t, std::vector<uint32_t>> index;
+  for (size_t i = 0; i + MATCH_KEY <= oldImg.size(); i++) {
+    std::vector<uint32_t>& at = index[matchKey(oldImg, i)];
+    if (at.size() < MAX_CANDIDATES) {
+      at.push_back(i);
+    }
+  }
+
+  bytes patch;
+  putLE(&patch, PATCH_MAGIC);
+  putLE(&patch, oldImg.size());
+  putLE(&patch, crc32(oldImg));
+  putLE(&patch, newImg.size());
+  putLE(&patch, crc32(newImg));
+
+  size_t pos = 0;
+  size_t literal = 0;
+  uint32_t oldPos = 0;  // End of the last copy
+  while (pos < newImg.size()) {
+    // Code that only moved usually carries on where the last copy ended
+    size_t bestLen = matchLen(oldImg, oldPos, newImg, pos);
+    size_t bestAt = oldPos;
+    if (bestLen < MIN_MATCH && pos + MATCH_KEY <= newImg.size()) {
+      auto found = index.find(matchKey(newImg, pos));
+      if (found != index.end()) {
+        for (uint32_t at : found->second) {
+          size_t len = matchLen(oldImg, at, newImg, pos);
+          if (len > bestLen) {
+            bestLen = len;
+            bestAt = at;
+          }
+        }
+      }
+    }
+    if (bestLen < MIN_MATCH) {
+      pos++;
+      continue;
+    }
+    flushLiteral(&patch, newImg, literal, pos);
+    int32_t delta = (int32_t)bestAt - (int32_t)oldPos;
+    putVarint(&patch, bestLen << 1 | PATCH_COPY);
+    putVarint(&patch, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+    oldPos = bestAt + bestLen;
+    pos += bestLen;
+    literal = pos;
+  }
+  flushLiteral(&patch, newImg, literal, pos);
+
+  HmacSha256 hmac;
+  uint8_t mac[HMAC_LEN];
+  hmac.begin(key, PATCH_KEY_LEN);
+  for (uint8_t b : patch) {
+    hmac.update(b);
+  }
+  hmac.finish(mac);
+  patch.insert(patch.end(), mac, mac + HMAC_LEN);
+  return patch;
+}
+
+// Simulated device flash, the running image and the inactive half
+class SimFlash : public PatchTarget {
+public:
+  SimFlash(const bytes& running) : _running(running){};
+  uint8_t readOld(uint32_t offset) { return _running[offset]; }
+  bool write(uint8_t b) {
+    staging.push_back(b);
+    return true;
+  }
+  bytes staging;
+
+private:
+  const bytes& _running;
+};
+
+static int applyPatch(const bytes& oldImg, const bytes& patch, const uint8_t key[PATCH_KEY_LEN], const char* outPath) {
+  SimFlash flash(oldImg);
+  PatchApplier applier(&flash, key);
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  for (size_t pos = 0; pos < patch.size(); pos += DEVICE_CHUNK) {
+    size_t len = patch.size() - pos < DEVICE_CHUNK ? patch.size() - pos : DEVICE_CHUNK;
+    if (!applier.feed(&patch[pos], len)) {
+      fprintf(stderr, "Patch failed: %s, running image kept\n", applier.error());
+      return 1;
+    }
+  }
+  gettimeofday(&end, NULL);
+  if (!applier.verified()) {
+    fprintf(stderr, "Patch failed: %s, running image kept\n", applier.written() < applier.header().newLen || !applier.headerDone() ? "Short patch" : applier.error() ? applier.error() : "CRC mismatch or no signature");
+    return 1;
+  }
+  printf("Applied %zu byte patch, %u byte image verified in %.1f ms\n", patch.size(), applier.written(),
+         (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_usec - start.tv_usec) / 1e3);
+  return writeFile(outPath, flash.staging) ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+  bytes a, b;
+  uint8_t key[PATCH_KEY_LEN];
+  if (argc == 2 && strcmp(argv[1], "key") == 0) {
+    return newKey();
+  }
+  if (argc == 6 && strcmp(argv[1], "diff") == 0) {
+    if (!readKey(argv[2], key) || !readFile(argv[3], &a) || !readFile(argv[4], &b)) {
+      return 1;
+    }
+    bytes patch = makePatch(a, b, key);
+    printf("%zu byte image, %zu byte patch (%.1f%%)\n", b.size(), patch.size(), 100.0 * patch.size() / (b.size() ? b.size() : 1));
+    return writeFile(argv[5], patch) ? 0 : 1;
+  }
+  if (argc == 6 && strcmp(argv[1], "apply") == 0) {
+    if (!readKey(argv[2], key) || !readFile(argv[3], &a) || !readFile(argv[4], &b)) {
+      return 1;
+    }
+    return applyPatch(a, b, key, argv[5]);
+  }
+  fprintf(stderr, "Usage: %s key > KEYFILE\n       %s diff KEYFILE OLD NEW PATCH\n       %s apply KEYFILE OLD PATCH OUT\n",
+          argv[0], argv[0], argv[0]);
+  return 1;
+}
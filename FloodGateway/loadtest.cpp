@@ -0,0 +1,337 @@
+/*
+  Scripted load test for FloodGateway against a stand-in EA API
+
+  Runs ./floodgateway with a one second upstream poll against a
+  stand-in for environment.data.gov.uk on 127.0.0.1, then has a crowd
+  of simulated devices poll it as the Magnet does, with If-None-Match
+  and "Connection: close". Part way through, the stand-in raises one
+  area from an alert to a warning and starts failing another.
+
+  Checks that every device poll is answered, that the gateway's
+  upstream polls don't grow with the number of devices, that the
+  failing area keeps serving its last good warning and that devices
+  see the change within a poll interval. Reports polls/s and latency.
+
+  Usage: make loadtest
+*/
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define DEVICES 32
+#define RUN_MS 4000
+#define CHANGE_MS 1500     // When the stand-in changes its script
+#define INTERVAL 1         // Gateway upstream poll, seconds
+#define GATEWAY_THREADS 4
+#define MIN_RATE 1000      // Device polls/s
+#define MAX_P99_US 50000
+#define READY_MS 5000
+
+#define AREA_PATH "/flood-monitoring/id/floodAreas/"
+
+static const char* const areas[] = { "062WAF28UpAvon", "011FWFNC6KC", "065WAF441" };
+#define NUM_AREAS 3
+#define CHANGING 0  // Alert then warning
+#define FAILING 2   // Warning then 500s
+
+static std::atomic<bool> changed(false);
+static std::atomic<int> upstreamPolls(0);
+
+static long nowUs(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1000000L + t.tv_nsec / 1000;
+}
+
+static int listenLocal(int* port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t len = sizeof(addr);
+  if (bind(fd, (struct sockaddr*)&addr, len) != 0 || listen(fd, 128) != 0
+      || getsockname(fd, (struct sockaddr*)&addr, &len) != 0) {
+    perror("stand-in");
+    exit(1);
+  }
+  *port = ntohs(addr.sin_port);
+  return fd;
+}
+
+static int connectLocal(int port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Reads until the peer closes, false on error
+static bool readAll(int fd, std::string* out) {
+  char buf[2048];
+  ssize_t n;
+  while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+    out->append(buf, n);
+  }
+  return n == 0;
+}
+
+// The EA API as the gateway sees it, one request per connection
+static void standIn(int listener) {
+  while (true) {
+    int fd = accept(listener, NULL, NULL);
+    if (fd < 0) {
+      continue;
+    }
+    char request[1024];
+    ssize_t n = recv(fd, request, sizeof(request) - 1, 0);
+    request[n > 0 ? n : 0] = '\0';
+    upstreamPolls++;
+    int area = -1;
+    for (int i = 0; i < NUM_AREAS; i++) {
+      if (strncmp(request, "GET " AREA_PATH, 4 + strlen(AREA_PATH)) == 0
+          && strncmp(request + 4 + strlen(AREA_PATH), areas[i], strlen(areas[i])) == 0) {
+        area = i;
+      }
+    }
+    std::string response;
+    if (area < 0) {
+      response = "HTTP/1.0 404 Not Found\r\n\r\n";
+    } else if (area == FAILING && changed) {
+      response = "HTTP/1.0 500 Internal Server Error\r\n\r\n";
+    } else {
+      int level = area == CHANGING ? (changed ? 2 : 3) : 2;
+      char body[512];
+      snprintf(body, sizeof(body),
+               "{\"@context\":\"http://environment.data.gov.uk/flood-monitoring/meta/context.jsonld\",\"items\":{"
+               "\"county\":\"Wiltshire\",\"currentWarning\":{\"floodAreaID\":\"%s\",\"isTidal\":false,"
+               "\"severity\":\"Flood warning\",\"severityLevel\":%d,\"timeRaised\":\"2022-12-19T15:%02d:31\"},"
+               "\"notation\":\"%s\"}}",
+               areas[area], level, level * 10, areas[area]);
+      response = std::string("HTTP/1.0 200 OK\r\nContent-Type: application/json\r\n\r\n") + body;
+    }
+    send(fd, response.data(), response.size(), MSG_NOSIGNAL);
+    close(fd);
+  }
+}
+
+struct pollResult {
+  int status = 0;
+  int level = -1;
+  std::string etag;
+};
+
+// One device poll, as FloodAPI sends it in gateway mode
+static bool poll(int port, int area, const std::string& etag, pollResult* result) {
+  int fd = connectLocal(port);
+  if (fd < 0) {
+    return false;
+  }
+  std::string request = std::string("GET " AREA_PATH) + areas[area] + " HTTP/1.0\r\n"
+                        "Host: gateway\r\n";
+  if (!etag.empty()) {
+    request += "If-None-Match: " + etag + "\r\n";
+  }
+  request += "Connection: close\r\n\r\n";
+  std::string response;
+  bool ok = send(fd, request.data(), request.size(), MSG_NOSIGNAL) == (ssize_t)request.size()
+            && readAll(fd, &response);
+  close(fd);
+  if (!ok || response.size() < 12) {
+    return false;
+  }
+  result->status = atoi(response.c_str() + 9);
+  size_t tag = response.find("ETag: ");
+  if (tag != std::string::npos) {
+    result->etag = response.substr(tag + 6, response.find("\r\n", tag) - tag - 6);
+  }
+  size_t level = response.find("\"severityLevel\":");
+  if (level != std::string::npos) {
+    result->level = atoi(response.c_str() + level + 16);
+  }
+  return true;
+}
+
+struct deviceStats {
+  std::vector<long> latencyUs;
+  int errors = 0;
+  int notModified = 0;
+  int failingLost = 0;  // Failing area not served its last warning
+  long seenChangeUs = 0;
+};
+
+static void device(int id, int port, long startUs, long changeUs, deviceStats* stats) {
+  int area = id % NUM_AREAS;
+  std::string etag;
+  int level = -1;
+  while (nowUs() - startUs < RUN_MS * 1000L) {
+    pollResult result;
+    long t0 = nowUs();
+    bool ok = poll(port, area, etag, &result);
+    stats->latencyUs.push_back(nowUs() - t0);
+    if (!ok || (result.status != 200 && result.status != 304)) {
+      stats->errors++;
+      continue;
+    }
+    if (result.status == 304) {
+      stats->notModified++;
+    } else {
+      etag = result.etag;
+      level = result.level;
+    }
+    if (area == FAILING && level != 2) {
+      stats->failingLost++;
+    }
+    if (area == CHANGING && level == 2 && !stats->seenChangeUs) {
+      stats->seenChangeUs = nowUs() - changeUs;
+    }
+  }
+}
+
+static pid_t startGateway(int port, int upstreamPort) {
+  char portArg[8], upstreamArg[32], intervalArg[8], threadsArg[8];
+  snprintf(portArg, sizeof(portArg), "%d", port);
+  snprintf(upstreamArg, sizeof(upstreamArg), "127.0.0.1:%d", upstreamPort);
+  snprintf(intervalArg, sizeof(intervalArg), "%d", INTERVAL);
+  snprintf(threadsArg, sizeof(threadsArg), "%d", GATEWAY_THREADS);
+  pid_t pid = fork();
+  if (pid == 0) {
+    freopen("/dev/null", "w", stdout);
+    freopen("/dev/null", "w", stderr);  // The failing area is expected
+    execl("./floodgateway", "floodgateway", "-p", portArg, "-u", upstreamArg, "-i", intervalArg,
+          "-t", threadsArg, "-n", "0", areas[0], areas[1], areas[2], (char*)NULL);
+    perror("floodgateway");
+    _exit(1);
+  }
+  return pid;
+}
+
+// Every area served with a warning, or give up
+static bool waitReady(int port) {
+  long start = nowUs();
+  while (nowUs() - start < READY_MS * 1000L) {
+    int ready = 0;
+    for (int i = 0; i < NUM_AREAS; i++) {
+      pollResult result;
+      ready += poll(port, i, "", &result) && result.status == 200;
+    }
+    if (ready == NUM_AREAS) {
+      return true;
+    }
+    usleep(50000);
+  }
+  return false;
+}
+
+int main() {
+  signal(SIGPIPE, SIG_IGN);
+  int upstreamPort;
+  int listener = listenLocal(&upstreamPort);
+  std::thread(standIn, listener).detach();
+
+  // Free port for the gateway, released just before it binds
+  int port;
+  close(listenLocal(&port));
+  pid_t gateway = startGateway(port, upstreamPort);
+  if (!waitReady(port)) {
+    printf("FAIL gateway not serving on port %d\n", port);
+    kill(gateway, SIGTERM);
+    return 1;
+  }
+
+  int pollsBefore = upstreamPolls;
+  long startUs = nowUs();
+  long changeUs = startUs + CHANGE_MS * 1000L;
+  std::vector<deviceStats> stats(DEVICES);
+  std::vector<std::thread> devices;
+  for (int i = 0; i < DEVICES; i++) {
+    devices.emplace_back(device, i, port, startUs, changeUs, &stats[i]);
+  }
+  usleep(CHANGE_MS * 1000);
+  changed = true;
+  for (std::thread& t : devices) {
+    t.join();
+  }
+  long runUs = nowUs() - startUs;
+  int upstream = upstreamPolls - pollsBefore;
+  kill(gateway, SIGTERM);
+  waitpid(gateway, NULL, 0);
+
+  std::vector<long> latency;
+  int errors = 0, notModified = 0, failingLost = 0;
+  long seenChange = 0;
+  bool allSaw = true;
+  for (int i = 0; i < DEVICES; i++) {
+    const deviceStats& s = stats[i];
+    latency.insert(latency.end(), s.latencyUs.begin(), s.latencyUs.end());
+    errors += s.errors;
+    notModified += s.notModified;
+    failingLost += s.failingLost;
+    if (i % NUM_AREAS == CHANGING) {
+      allSaw = allSaw && s.seenChangeUs;
+      seenChange = std::max(seenChange, s.seenChangeUs);
+    }
+  }
+  std::sort(latency.begin(), latency.end());
+  size_t polls = latency.size();
+  double rate = polls * 1e6 / runUs;
+  long p50 = polls ? latency[polls / 2] : 0;
+  long p99 = polls ? latency[polls * 99 / 100] : 0;
+  // One poll per area per interval, plus one in flight at each end
+  int maxUpstream = NUM_AREAS * (RUN_MS / 1000 / INTERVAL + 2);
+
+  printf("Devices       %d polling %d areas for %.1f s\n", DEVICES, NUM_AREAS, runUs / 1e6);
+  printf("Device polls  %zu, %.0f/s, %d not modified, %d errors\n", polls, rate, notModified, errors);
+  printf("Latency       %.2f ms p50, %.2f ms p99, %.2f ms max\n", p50 / 1e3, p99 / 1e3,
+         polls ? latency.back() / 1e3 : 0.0);
+  printf("Upstream      %d polls, at most %d expected\n", upstream, maxUpstream);
+  printf("Change seen   %.2f s after the stand-in changed, by every device\n", seenChange / 1e6);
+  printf("Failing area  %d polls without the last good warning\n", failingLost);
+
+  int bad = 0;
+  if (errors) {
+    printf("FAIL %d device polls not answered\n", errors);
+    bad++;
+  }
+  if (rate < MIN_RATE) {
+    printf("FAIL %.0f polls/s, want at least %d\n", rate, MIN_RATE);
+    bad++;
+  }
+  if (p99 > MAX_P99_US) {
+    printf("FAIL p99 latency %.2f ms, want at most %.2f ms\n", p99 / 1e3, MAX_P99_US / 1e3);
+    bad++;
+  }
+  if (upstream > maxUpstream) {
+    printf("FAIL %d upstream polls for %d areas\n", upstream, NUM_AREAS);
+    bad++;
+  }
+  if (!allSaw || seenChange > (INTERVAL + 1) * 1000000L) {
+    printf("FAIL change not seen within %d s by every device\n", INTERVAL + 1);
+    bad++;
+  }
+  if (failingLost) {
+    printf("FAIL failing area lost its last warning\n");
+    bad++;
+  }
+  return bad ? 1 : 0;
+}
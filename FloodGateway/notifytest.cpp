@@ -0,0 +1,295 @@
+/*
+  Push notification latency, from an upstream change to a device
+
+  Runs ./floodgateway with a one second upstream poll against a
+  stand-in EA API, with notifications sent to a simulated device on
+  127.0.0.1. The stand-in changes the watched area's level a few
+  times. The device accepts packets as checkNotify() does: from the
+  gateway's address only, for its own area, and only a new sequence
+  number is a reading for the sketch's SeverityFilter. A forger on
+  127.0.0.2 sends packets for the same area throughout, and the gateway
+  also serves a second area.
+
+  For each change it reports the time from the stand-in serving the new
+  level to the device handling the packet, and from the change to the
+  device handling it. It fails if a change is missed or slow, or if a
+  forged or other-area packet would have been applied.
+
+  The last change is a downgrade, which the filter holds back until
+  DEBOUNCE_READINGS readings agree. The gateway then repeats it for
+  more than that many polls. The level must hold through the repeats,
+  and they must clear the stale flag left by failed polls.
+
+  Usage: make notifytest
+*/
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FloodNotify.h"
+#include "magnet_config.h"
+#include "SeverityFilter.h"
+
+#define INTERVAL 1              // Gateway upstream poll, seconds
+#define CHANGE_WAIT_MS 3000     // Give up on a change after this
+#define MAX_NOTIFY_US 50000     // Served to handled
+#define MAX_CHANGE_US (INTERVAL * 1000000L + 250000)  // Changed to handled
+#define FORGE_INTERVAL_US 20000
+#define REPEAT_WAIT_US ((DEBOUNCE_READINGS + 1) * INTERVAL * 1000000L + 500000)
+
+#define AREA_PATH "/flood-monitoring/id/floodAreas/"
+#define AREA "062WAF28UpAvon"
+#define OTHER_AREA "011FWFNC6KC"
+
+static const int levels[] = { 3, 2, 1, 2, 4, 3 };
+#define NUM_CHANGES (int)(sizeof(levels) / sizeof(levels[0]))
+
+static std::atomic<int> level(levels[0]);
+static std::atomic<long> servedUs(0);  // First time the current level was served
+static std::atomic<bool> running(true);
+
+static long nowUs(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1000000L + t.tv_nsec / 1000;
+}
+
+static int bindLocal(int type, const char* address, int* port) {
+  int fd = socket(AF_INET, type, 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  inet_pton(AF_INET, address, &addr.sin_addr);
+  socklen_t len = sizeof(addr);
+  if (bind(fd, (struct sockaddr*)&addr, len) != 0 || (type == SOCK_STREAM && listen(fd, 16) != 0)
+      || getsockname(fd, (struct sockaddr*)&addr, &len) != 0) {
+    perror(address);
+    exit(1);
+  }
+  *port = ntohs(addr.sin_port);
+  return fd;
+}
+
+// The EA API as the gateway sees it, one request per connection
+static void standIn(int listener) {
+  int lastServed = -1;
+  while (true) {
+    int fd = accept(listener, NULL, NULL);
+    if (fd < 0) {
+      continue;
+    }
+    char request[1024];
+    ssize_t n = recv(fd, request, sizeof(request) - 1, 0);
+    request[n > 0 ? n : 0] = '\0';
+    const char* area = strncmp(request, "GET " AREA_PATH, 4 + strlen(AREA_PATH)) == 0
+                       ? request + 4 + strlen(AREA_PATH) : "";
+    bool watched = strncmp(area, AREA " ", strlen(AREA) + 1) == 0;
+    int current = watched ? (int)level : 1;
+    char body[256];
+    snprintf(body, sizeof(body),
+             "{\"items\":{\"currentWarning\":{\"floodAreaID\":\"%s\",\"severityLevel\":%d,"
+             "\"timeRaised\":\"2022-12-19T15:%02d:31\"}}}",
+             watched ? AREA : OTHER_AREA, current, current * 10);
+    std::string response = std::string("HTTP/1.0 200 OK\r\nContent-Type: application/json\r\n\r\n") + body;
+    if (watched && current != lastServed) {
+      servedUs = nowUs();
+      lastServed = current;
+    }
+    send(fd, response.data(), response.size(), MSG_NOSIGNAL);
+    close(fd);
+  }
+}
+
+// Someone else on the LAN sending for our area
+static void forger(int notifyPort) {
+  int port;
+  int fd = bindLocal(SOCK_DGRAM, "127.0.0.2", &port);
+  struct sockaddr_in dest;
+  memset(&dest, 0, sizeof(dest));
+  dest.sin_family = AF_INET;
+  dest.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  dest.sin_port = htons(notifyPort);
+  floodNotify n;
+  n.severity = 1;
+  strcpy(n.area, AREA);
+  while (running) {
+    uint8_t buf[NOTIFY_LEN];
+    n.seq++;
+    encodeNotify(n, buf);
+    sendto(fd, buf, sizeof(buf), 0, (struct sockaddr*)&dest, sizeof(dest));
+    usleep(FORGE_INTERVAL_US);
+  }
+  close(fd);
+}
+
+static pid_t startGateway(int port, int upstreamPort, int notifyPort) {
+  char portArg[8], upstreamArg[32], intervalArg[8], notifyArg[8];
+  snprintf(portArg, sizeof(portArg), "%d", port);
+  snprintf(upstreamArg, sizeof(upstreamArg), "127.0.0.1:%d", upstreamPort);
+  snprintf(intervalArg, sizeof(intervalArg), "%d", INTERVAL);
+  snprintf(notifyArg, sizeof(notifyArg), "%d", notifyPort);
+  pid_t pid = fork();
+  if (pid == 0) {
+    freopen("/dev/null", "w", stdout);
+    execl("./floodgateway", "floodgateway", "-p", portArg, "-u", upstreamArg, "-i", intervalArg,
+          "-b", "127.0.0.1", "-n", notifyArg, AREA, OTHER_AREA, (char*)NULL);
+    perror("floodgateway");
+    _exit(1);
+  }
+  return pid;
+}
+
+struct deviceStats {
+  int forged = 0;     // Dropped, not from the gateway
+  int otherArea = 0;  // Dropped, not our area
+  int repeats = 0;    // Dropped, sequence already applied
+  int wrong = 0;      // Applied but not the level the stand-in serves
+};
+
+// Wait for the device to handle a notification carrying want, as
+// checkNotify() would. Returns the time it was handled, 0 on timeout.
+// A want of -1 waits out the whole time.
+static long handle(int fd, int want, long waitUs, uint32_t* lastSeq, SeverityFilter* filter, deviceStats* stats) {
+  long deadline = nowUs() + waitUs;
+  struct in_addr gateway;
+  gateway.s_addr = htonl(INADDR_LOOPBACK);
+  while (nowUs() < deadline) {
+    uint8_t buf[64];
+    struct sockaddr_in from;
+    socklen_t fromLen = sizeof(from);
+    ssize_t n = recvfrom(fd, buf, sizeof(buf), 0, (struct sockaddr*)&from, &fromLen);
+    floodNotify notify;
+    if (n < 0) {
+      continue;  // Receive timeout, check the deadline
+    }
+    if (from.sin_addr.s_addr != gateway.s_addr) {
+      stats->forged++;
+      continue;
+    }
+    if (!decodeNotify(buf, n, &notify) || !notifyFor(notify, AREA)) {
+      stats->otherArea++;
+      continue;
+    }
+    if (notify.seq == *lastSeq) {
+      filter->heard();
+      stats->repeats++;
+      continue;
+    }
+    *lastSeq = notify.seq;
+    long handled = nowUs();
+    filter->update(toLevel(notify.severity), handled / 1000);
+    if (notify.severity != want) {
+      stats->wrong++;
+      continue;
+    }
+    return handled;
+  }
+  return 0;
+}
+
+int main() {
+  signal(SIGPIPE, SIG_IGN);
+  int upstreamPort, notifyPort, port;
+  int listener = bindLocal(SOCK_STREAM, "127.0.0.1", &upstreamPort);
+  std::thread(standIn, listener).detach();
+  int device = bindLocal(SOCK_DGRAM, "127.0.0.1", &notifyPort);
+  struct timeval tv = { 0, 100000 };
+  setsockopt(device, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  close(bindLocal(SOCK_STREAM, "127.0.0.1", &port));  // Free port for the gateway
+
+  std::thread forge(forger, notifyPort);
+  pid_t gateway = startGateway(port, upstreamPort, notifyPort);
+
+  deviceStats stats;
+  SeverityFilter filter(DEBOUNCE_READINGS, DEBOUNCE_TIME, STALE_FAILURES);
+  filter.reset(INIT);
+  uint32_t lastSeq = 0;
+  std::vector<long> notifyUs, changeUs;
+  int missed = 0;
+  for (int i = 0; i < NUM_CHANGES; i++) {
+    long changed = nowUs();
+    level = levels[i];
+    long handled = handle(device, levels[i], CHANGE_WAIT_MS * 1000L, &lastSeq, &filter, &stats);
+    if (!handled) {
+      printf("FAIL level %d not handled within %d ms\n", levels[i], CHANGE_WAIT_MS);
+      missed++;
+      continue;
+    }
+    notifyUs.push_back(handled - servedUs);
+    if (i > 0) {  // The first waits for the gateway to start
+      changeUs.push_back(handled - changed);
+    }
+  }
+
+  // The gateway repeats the last change, a downgrade still pending
+  warning_levels held = filter.level();
+  int repeatsBefore = stats.repeats;
+  for (int i = 0; i < STALE_FAILURES; i++) {
+    filter.failed();
+  }
+  handle(device, -1, REPEAT_WAIT_US, &lastSeq, &filter, &stats);
+  int repeats = stats.repeats - repeatsBefore;
+  running = false;
+  forge.join();
+  kill(gateway, SIGTERM);
+  waitpid(gateway, NULL, 0);
+
+  std::sort(notifyUs.begin(), notifyUs.end());
+  std::sort(changeUs.begin(), changeUs.end());
+  long notifyMax = notifyUs.empty() ? 0 : notifyUs.back();
+  long changeMax = changeUs.empty() ? 0 : changeUs.back();
+  printf("Changes       %d of %d handled\n", NUM_CHANGES - missed, NUM_CHANGES);
+  if (!notifyUs.empty()) {
+    printf("Notify        %.2f ms median, %.2f ms max, served upstream to handled\n",
+           notifyUs[notifyUs.size() / 2] / 1e3, notifyMax / 1e3);
+  }
+  if (!changeUs.empty()) {
+    printf("Change        %.0f ms median, %.0f ms max, changed upstream to handled, %d s poll\n",
+           changeUs[changeUs.size() / 2] / 1e3, changeMax / 1e3, INTERVAL);
+  }
+  printf("Dropped       %d forged, %d other area, %d repeats\n", stats.forged, stats.otherArea, stats.repeats);
+  printf("Repeats       %d of level %d, held at %d, %s\n", repeats, levels[NUM_CHANGES - 1], filter.level(),
+         filter.stale() ? "stale" : "not stale");
+
+  int bad = missed;
+  if (notifyMax > MAX_NOTIFY_US) {
+    printf("FAIL notify to handled %.2f ms, want at most %.2f ms\n", notifyMax / 1e3, MAX_NOTIFY_US / 1e3);
+    bad++;
+  }
+  if (changeMax > MAX_CHANGE_US) {
+    printf("FAIL change to handled %.0f ms, over one poll interval\n", changeMax / 1e3);
+    bad++;
+  }
+  if (stats.wrong) {
+    printf("FAIL %d packets applied with the wrong level\n", stats.wrong);
+    bad++;
+  }
+  if (!stats.forged || !stats.otherArea) {
+    printf("FAIL forged and other-area packets were not both seen and dropped\n");
+    bad++;
+  }
+  if (held == toLevel(levels[NUM_CHANGES - 1]) || repeats < DEBOUNCE_READINGS) {
+    printf("FAIL the last change was not a downgrade repeated %d times\n", DEBOUNCE_READINGS);
+    bad++;
+  } else if (filter.level() != held) {
+    printf("FAIL repeats of one change downgraded the level from %d to %d\n", held, filter.level());
+    bad++;
+  }
+  if (filter.stale()) {
+    printf("FAIL repeats from the gateway did not clear stale\n");
+    bad++;
+  }
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+#include "Annunciator.h"
+#include "led.h"
+#include "buzzer.h"
+
+Annunciator annunciator;
+
+// Times in ticks of ANN_TICK_MS
+//   channels                      led            on   off  rgb    breathe cadence               repeats
+const annPattern annSeverity[NUM_LEVELS] = {
+  { ANN_LEDS,                      0,             0,   0,   0,     0,      {},                   0 },  // NONE
+  { ANN_LEDS,                      LED_RED,       25,  25,  0,     0,      {},                   0 },  // SEVERE
+  { ANN_LEDS,                      LED_RED,       100, 100, 0,     0,      {},                   0 },  // WARNING
+  { ANN_LEDS,                      LED_AMBER,     0,   0,   0,     0,      {},                   0 },  // ALERT
+  { ANN_LEDS,                      LED_GREEN,     0,   0,   0,     0,      {},                   0 },  // NO_LONGER
+  { ANN_LEDS,                      0,             0,   0,   0,     0,      {},                   0 },  // INIT
+};
+
+// Sounded on entering a level, then the severity pattern carries on alone
+const annPattern annAlarm[NUM_LEVELS] = {
+  { ANN_BUZZER,                    0,             0,   0,   0,     0,      {},                   0 },
+  { ANN_BUZZER,                    0,             0,   0,   0,     0,      { 50, 25 },           40 },  // Siren, 30 s
+  { ANN_BUZZER,                    0,             0,   0,   0,     0,      { 20, 20, 20, 100 },  10 },  // 16 s
+  { ANN_BUZZER,                    0,             0,   0,   0,     0,      { 10, 10, 10, 250 },  3 },   // 8 s
+  { ANN_BUZZER,                    0,             0,   0,   0,     0,      {},                   0 },
+  { ANN_BUZZER,                    0,             0,   0,   0,     0,      {},                   0 },
+};
+
+const annPattern annConnecting = { ANN_RGB, 0, 0, 0, RED, 200, {}, 0 };
+const annPattern annOnline = { ANN_RGB, 0, 0, 0, GREEN, 0, {}, 0 };
+const annPattern annDemo = { ANN_RGB, 0, 0, 0, RED, 0, {}, 0 };
+const annPattern annLampTest = { ANN_LEDS | ANN_RGB | ANN_BUZZER, ANN_LED_CYCLE, 50, 0, WHITE, 150, { 10, 140 }, 1 };
+const annPattern annBip = { ANN_BUZZER, 0, 0, 0, 0, 0, { 10 }, 1 };
+
+#ifdef ARDUINO_ARCH_SAMD
+void TC3_Handler(void) {
+  TC3->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
+  annunciator.tick();
+}
+#endif
+
+void Annunciator::begin(void) {
+  led_init();
+  buzzer_init();
+#ifdef ARDUINO_ARCH_SAMD
+  // TC3 from the 48 MHz GCLK0, counting to CC0 and back to 0
+  GCLK->CLKCTRL.reg = GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 | GCLK_CLKCTRL_ID_TCC2_TC3;
+  while (GCLK->STATUS.bit.SYNCBUSY) {
+  }
+  TC3->COUNT16.CTRLA.reg = TC_CTRLA_SWRST;
+  while (TC3->COUNT16.CTRLA.bit.SWRST) {
+  }
+  TC3->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_WAVEGEN_MFRQ | TC_CTRLA_PRESCALER_DIV1024;
+  TC3->COUNT16.CC[0].reg = F_CPU / 1024 * ANN_TICK_MS / 1000 - 1;
+  while (TC3->COUNT16.STATUS.bit.SYNCBUSY) {
+  }
+  TC3->COUNT16.INTENSET.reg = TC_INTENSET_MC0;
+  NVIC_SetPriority(TC3_IRQn, 3);  // Below SPI DMA and the radio
+  NVIC_EnableIRQ(TC3_IRQn);
+  TC3->COUNT16.CTRLA.reg |= TC_CTRLA_ENABLE;
+  while (TC3->COUNT16.STATUS.bit.SYNCBUSY) {
+  }
+#endif
+}
+
+// Start a pattern in a slot, from its first step. Playing the pattern
+// the slot already has leaves it running where it is.
+void Annunciator::play(uint8_t slot, const annPattern* pattern) {
+  if (_slots[slot].pattern == pattern) {
+    return;
+  }
+  uint16_t cycle = 0;
+  for (int i = 0; i < ANN_CADENCE_STEPS && pattern->cadence[i]; i++) {
+    cycle += pattern->cadence[i];
+  }
+  noInterrupts();
+  _slots[slot].ticks = 0;
+  _slots[slot].cycle = cycle;
+  _slots[slot].pattern = pattern;
+  interrupts();
+}
+
+void Annunciator::stop(uint8_t slot) {
+  noInterrupts();
+  _slots[slot].pattern = NULL;
+  interrupts();
+}
+
+// Highest slot driving a channel
+const Annunciator::annSlot* Annunciator::driver(uint8_t channel) {
+  for (int i = ANN_SLOTS - 1; i >= 0; i--) {
+    if (_slots[i].pattern && (_slots[i].pattern->channels & channel)) {
+      return &_slots[i];
+    }
+  }
+  return NULL;
+}
+
+void Annunciator::tick(void) {
+  for (annSlot& slot : _slots) {
+    if (slot.pattern && slot.pattern->repeats && slot.cycle && slot.ticks >= (uint32_t)slot.cycle * slot.pattern->repeats) {
+      slot.pattern = NULL;  // Finished, lower slots show through
+    }
+  }
+
+  // Indicators, off when nothing drives them
+  const annSlot* s = driver(ANN_LEDS);
+  int led = 0;
+  if (s) {
+    const annPattern* p = s->pattern;
+    if (p->led == ANN_LED_CYCLE) {
+      led = LED_RED + s->ticks / p->ledOn % 3;
+    } else if (!p->ledOff || s->ticks % (p->ledOn + p->ledOff) < p->ledOn) {
+      led = p->led;
+    }
+  }
+  if (led != _led) {
+    led_colour(led);
+    _led = led;
+  }
+
+  // Status LED, left as it is when nothing drives it
+  s = driver(ANN_RGB);
+  if (s) {
+    const annPattern* p = s->pattern;
+    int level = 255;
+    if (p->breathe) {  // Triangle, squared so it looks even to the eye
+      uint32_t ramp = s->ticks % p->breathe * 510 / p->breathe;
+      ramp = ramp > 255 ? 510 - ramp : ramp;
+      level = ramp * ramp / 255;
+    }
+    if (p->rgb != _rgb || level != _level) {
+      rgb_colour(p->rgb, level);
+      _rgb = p->rgb;
+      _level = level;
+    }
+  }
+
+  // Buzzer, silent when nothing drives it
+  s = driver(ANN_BUZZER);
+  int buzz = 0;
+  if (s && s->cycle) {
+    uint16_t at = s->ticks % s->cycle;
+    int step = 0;
+    while (at >= s->pattern->cadence[step]) {
+      at -= s->pattern->cadence[step++];
+    }
+    buzz = !(step & 1);  // On for the even steps
+  }
+  if (buzz != _buzzer) {
+    if (buzz) {
+      buzzer_on();
+    } else {
+      buzzer_off();
+    }
+    _buzzer = buzz;
+  }
+
+  for (annSlot& slot : _slots) {
+    if (slot.pattern) {
+      slot.ticks++;
+    }
+  }
+  if (_onTick) {
+    _onTick();
+  }
+}
@@ -0,0 +1,77 @@
+#ifndef _ANNUNCIATOR_H_
+#define _ANNUNCIATOR_H_
+
+#include <Arduino.h>
+#include "FloodStates.h"
+
+#define ANN_TICK_MS 10        // Timer interrupt period, pattern times are in ticks
+#define ANN_CADENCE_STEPS 6   // Buzzer on/off steps per pattern
+
+// Outputs a pattern drives, the others show through from lower slots
+#define ANN_LEDS 0x01    // Red, amber and green indicators
+#define ANN_RGB 0x02     // Status LED
+#define ANN_BUZZER 0x04
+
+#define ANN_LED_CYCLE 4  // Indicators step red, amber, green every ledOn ticks
+
+// Slots in rising priority. Each output comes from the highest slot
+// with a pattern driving it, so a bip or an alarm preempts the
+// severity pattern and hands back to it, at its current step, when it
+// ends or is stopped.
+enum ann_slots { ANN_SEVERITY,
+                 ANN_STATUS,    // Wifi on the RGB LED
+                 ANN_ALARM,     // Siren on entering a warning
+                 ANN_FEEDBACK,  // Button bips, lamp test
+                 ANN_SLOTS };
+
+struct annPattern {
+  uint8_t channels;  // ANN_LEDS, ANN_RGB and ANN_BUZZER driven
+  uint8_t led;       // LED_RED, LED_AMBER, LED_GREEN, ANN_LED_CYCLE or 0 for off
+  uint8_t ledOn;     // Blink, steady if ledOff is 0
+  uint8_t ledOff;
+  uint8_t rgb;       // Colour from led.h
+  uint8_t breathe;   // Breathing period, steady if 0
+  uint8_t cadence[ANN_CADENCE_STEPS];  // Buzzer on, off, on... ending at a 0
+  uint8_t repeats;   // Times through the cadence, 0 to run until stopped
+};
+
+extern const annPattern annSeverity[NUM_LEVELS];  // Indicators for each level
+extern const annPattern annAlarm[NUM_LEVELS];     // Siren for each level
+extern const annPattern annConnecting;
+extern const annPattern annOnline;
+extern const annPattern annDemo;
+extern const annPattern annLampTest;
+extern const annPattern annBip;
+
+// LED and buzzer patterns run from a timer interrupt, every ANN_TICK_MS
+// on TC3, so they cost loop() nothing and never block it. play() and
+// stop() only swap a slot's pattern. Pins are written when they change.
+class Annunciator {
+public:
+  void begin(void);
+  void play(uint8_t slot, const annPattern* pattern);
+  void stop(uint8_t slot);
+  bool playing(uint8_t slot) { return _slots[slot].pattern != NULL; }
+  void bip(void) { play(ANN_FEEDBACK, &annBip); }
+  void tick(void);  // From the timer interrupt, or a test
+  void onTick(void (*callback)(void)) { _onTick = callback; }  // Also run from the interrupt
+
+private:
+  struct annSlot {
+    const annPattern* volatile pattern;
+    uint32_t ticks;  // Since the pattern started
+    uint16_t cycle;  // Ticks through the cadence once
+  };
+  annSlot _slots[ANN_SLOTS] = {};
+  int8_t _led = -1;  // Last written, -1 before the first write
+  int8_t _rgb = -1;
+  int16_t _level = -1;
+  int8_t _buzzer = -1;
+  void (*_onTick)(void) = NULL;
+
+  const annSlot* driver(uint8_t channel);
+};
+
+extern Annunciator annunciator;
+
+#endif
@@ -0,0 +1,108 @@
+#include "ButtonEvents.h"
+
+ButtonEvents buttons;
+
+// Returns the button's index, or -1 if there are already BUTTON_COUNT_MAX
+int ButtonEvents::add(uint8_t pin, uint16_t holdMs) {
+  if (_count >= BUTTON_COUNT_MAX) {
+    return -1;
+  }
+  buttonState& b = _buttons[_count];
+  b = buttonState();
+  b.pin = pin;
+  b.holdMs = holdMs;
+  return _count++;
+}
+
+// Pull-ups on, levels read as they are and the interrupts attached
+void ButtonEvents::begin(void) {
+  uint32_t now = micros();
+  for (int i = 0; i < _count; i++) {
+    pinMode(_buttons[i].pin, INPUT_PULLUP);
+  }
+  for (int i = 0; i < _count; i++) {
+    _buttons[i].pressed = (digitalRead(_buttons[i].pin) == LOW);
+    _buttons[i].raw = _buttons[i].pressed;
+    _buttons[i].since = now;
+    _buttons[i].heldSent = true;  // Down at power up is not a hold
+    attachInterrupt(digitalPinToInterrupt(_buttons[i].pin), [] { buttons.edge(); }, CHANGE);
+  }
+}
+
+bool ButtonEvents::next(buttonEvent* event) {
+  uint8_t tail = _tail;
+  if (tail == __atomic_load_n(&_head, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+  *event = _queue[tail];
+  __atomic_store_n(&_tail, (tail + 1) & (BUTTON_QUEUE_LEN - 1), __ATOMIC_RELEASE);
+  return true;
+}
+
+void ButtonEvents::handled(const buttonEvent& event) {
+  uint32_t now = micros();
+  uint32_t latency = now - event.at;
+  uint32_t wait = now - event.queued;
+  _handled++;
+  _latencySum += latency;
+  _latencyMax = latency > _latencyMax ? latency : _latencyMax;
+  _waitMax = wait > _waitMax ? wait : _waitMax;
+}
+
+void ButtonEvents::edge(void) {
+  uint32_t now = micros();
+  for (int i = 0; i < _count; i++) {
+    buttonState& b = _buttons[i];
+    bool down = (digitalRead(b.pin) == LOW);
+    if (down != b.raw) {  // This button's edge, not another's
+      b.raw = down;
+      if (!b.bouncing) {
+        b.firstEdge = now;
+        b.bouncing = true;
+      }
+      b.lastEdge = now;
+    }
+  }
+}
+
+void ButtonEvents::tick(void) {
+  for (int i = 0; i < _count; i++) {
+    buttonState& b = _buttons[i];
+    noInterrupts();  // Edges may come in at a higher priority
+    uint32_t now = micros();
+    bool settled = b.bouncing && now - b.lastEdge >= BUTTON_DEBOUNCE_MS * 1000UL;
+    if (settled) {
+      b.bouncing = false;
+    }
+    interrupts();
+    if (settled) {
+      bool pressed = (digitalRead(b.pin) == LOW);
+      b.raw = pressed;
+      if (pressed != b.pressed) {
+        b.pressed = pressed;
+        if (pressed) {
+          b.since = b.firstEdge;
+          b.heldSent = false;
+        }
+        push(i, pressed ? BUTTON_PRESSED : BUTTON_RELEASED, b.firstEdge, now);
+      }
+    }
+    uint32_t holdAt = b.since + b.holdMs * 1000UL;
+    if (b.pressed && b.holdMs && !b.heldSent && (int32_t)(now - holdAt) >= 0) {
+      b.heldSent = true;
+      push(i, BUTTON_HELD, holdAt, now);
+    }
+  }
+}
+
+// From the timer interrupt only, a full queue drops the event
+void ButtonEvents::push(uint8_t button, uint8_t type, uint32_t at, uint32_t now) {
+  uint8_t head = _head;
+  uint8_t next = (head + 1) & (BUTTON_QUEUE_LEN - 1);
+  if (next == __atomic_load_n(&_tail, __ATOMIC_ACQUIRE)) {
+    _dropped++;
+    return;
+  }
+  _queue[head] = { button, type, at, now };
+  __atomic_store_n(&_head, next, __ATOMIC_RELEASE);
+}
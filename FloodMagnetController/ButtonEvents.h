@@ -0,0 +1,78 @@
+#ifndef _BUTTON_EVENTS_H_
+#define _BUTTON_EVENTS_H_
+
+#include <Arduino.h>
+
+#define BUTTON_COUNT_MAX 6
+#define BUTTON_QUEUE_LEN 32     // Power of two, events waiting for loop()
+#define BUTTON_DEBOUNCE_MS 20   // Quiet time after the last edge
+
+enum button_events { BUTTON_PRESSED,
+                     BUTTON_RELEASED,
+                     BUTTON_HELD };  // Still down after its holdMs
+
+struct buttonEvent {
+  uint8_t button;   // Index, in the order add()ed
+  uint8_t type;
+  uint32_t at;      // micros() of the first edge, or when the hold was reached
+  uint32_t queued;  // micros() when debounced and queued
+};
+
+// Button presses caught by pin change interrupts and debounced from a
+// timer, so none are missed while loop() is blocked in a fetch or a
+// display refresh. The edge interrupt only notes when a pin last
+// changed. tick(), from the timer, takes the level once a pin has
+// been quiet for BUTTON_DEBOUNCE_MS and queues the events. loop()
+// takes them off with next(). The queue has one producer, the timer
+// interrupt, and one consumer, loop(), so it needs no locking.
+//
+// Buttons are active low with the pull-ups on, as EasyButton. Every
+// edge samples all the buttons, as pins may share an EXTINT line.
+class ButtonEvents {
+public:
+  int add(uint8_t pin, uint16_t holdMs = 0);
+  void begin(void);
+  bool isPressed(int button) { return _buttons[button].pressed; }
+  bool next(buttonEvent* event);
+  void handled(const buttonEvent& event);  // Handler done, for the latency
+  void edge(void);                         // From the pin interrupts
+  void tick(void);                         // From the timer interrupt
+
+  // Latency from the first edge to handled(), the debounce included
+  uint32_t events(void) { return _handled; }
+  uint32_t latencyMaxUs(void) { return _latencyMax; }
+  uint32_t latencyMeanUs(void) { return _handled ? _latencySum / _handled : 0; }
+  uint32_t waitMaxUs(void) { return _waitMax; }  // Of that, time in the queue
+  uint32_t dropped(void) { return _dropped; }
+
+private:
+  struct buttonState {
+    uint8_t pin;
+    uint16_t holdMs;
+    volatile bool raw;       // Level at the last edge
+    volatile bool bouncing;  // Edges since the last debounced level
+    volatile uint32_t firstEdge;
+    volatile uint32_t lastEdge;
+    bool pressed;            // Debounced
+    bool heldSent;
+    uint32_t since;          // First edge of the press
+  };
+  buttonState _buttons[BUTTON_COUNT_MAX];
+  uint8_t _count = 0;
+
+  buttonEvent _queue[BUTTON_QUEUE_LEN];
+  uint8_t _head = 0;  // Written by the producer only
+  uint8_t _tail = 0;  // Written by the consumer only
+  volatile uint32_t _dropped = 0;
+
+  uint32_t _handled = 0;
+  uint32_t _latencyMax = 0;
+  uint64_t _latencySum = 0;
+  uint32_t _waitMax = 0;
+
+  void push(uint8_t button, uint8_t type, uint32_t at, uint32_t now);
+};
+
+extern ButtonEvents buttons;
+
+#endif
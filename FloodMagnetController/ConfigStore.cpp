@@ -0,0 +1,175 @@
+#include <FlashStorage.h>
+#include "ConfigStore.h"
+
+static FlashClass configFlash((const void*)CONFIG_FLASH_ADDR, sizeof(configRecord));
+
+#ifdef ARDUINO_ARCH_SAMD
+// End of the image from the core's linker script, .data is stored after .text
+extern "C" uint32_t __etext, __data_start__, __data_end__;
+
+static bool imageClear(void) {
+  return (uintptr_t)&__etext + ((uintptr_t)&__data_end__ - (uintptr_t)&__data_start__) <= CONFIG_FLASH_ADDR;
+}
+#else
+static bool imageClear(void) {
+  return true;
+}
+#endif
+
+uint32_t crc32(const uint8_t* data, size_t len) {
+  uint32_t crc = 0xFFFFFFFFUL;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
+
+int ConfigStore::load(void) {
+  configRecord record;
+  configFlash.read(&record);
+  if (record.magic != CONFIG_MAGIC || record.length > CONFIG_DATA_LEN
+      || crc32(record.data, record.length) != record.crc) {
+    Serial.println("No saved config, using defaults");
+    return 0;
+  }
+  memcpy(_config, record.data, record.length < _len ? record.length : _len);
+  if (record.version != _version || record.length != _len) {
+    Serial.print("Migrated config from version ");
+    Serial.println(record.version);
+    save();
+    return 2;
+  }
+  Serial.println("Loaded saved config");
+  return 1;
+}
+
+bool ConfigStore::save(void) {
+  if (!imageClear()) {
+    Serial.println("Sketch too big, it overlaps the config record");
+    return false;
+  }
+  configRecord record;
+  memset(&record, 0, sizeof(record));
+  record.magic = CONFIG_MAGIC;
+  record.version = _version;
+  record.length = _len;
+  memcpy(record.data, _config, _len);
+  record.crc = crc32(record.data, _len);
+  configFlash.erase();
+  configFlash.write(&record);
+  return true;
+}
+
+// Invalidate the saved record, defaults apply from the next reset
+void ConfigStore::clear(void) {
+  if (imageClear()) {
+    configFlash.erase();
+  }
+}
+
+const configField* ConfigStore::find(const char* name) {
+  for (size_t i = 0; i < _numFields; i++) {
+    if (strcmp(_fields[i].name, name) == 0) {
+      return &_fields[i];
+    }
+  }
+  return NULL;
+}
+
+// Set a field in RAM, save() to keep it
+bool ConfigStore::set(const char* name, const char* value) {
+  const configField* field = find(name);
+  if (!field || !value) {
+    return false;
+  }
+  uint8_t* p = _config + field->offset;
+  char* end;
+  unsigned long n = strtoul(value, &end, 10);
+  switch (field->type) {
+    case CFG_STR:
+    case CFG_SECRET:
+      if (strlen(value) >= field->size) {
+        return false;
+      }
+      strcpy((char*)p, value);
+      return true;
+    case CFG_U16:
+      if (*end || end == value || n > 0xFFFF) {
+        return false;
+      }
+      *(uint16_t*)p = n;
+      return true;
+    case CFG_U32:
+      if (*end || end == value) {
+        return false;
+      }
+      *(uint32_t*)p = n;
+      return true;
+  }
+  return false;
+}
+
+void ConfigStore::print(Stream& out) {
+  for (size_t i = 0; i < _numFields; i++) {
+    const configField* field = &_fields[i];
+    const uint8_t* p = _config + field->offset;
+    out.print(field->name);
+    out.print(" = ");
+    switch (field->type) {
+      case CFG_STR:
+        out.println((const char*)p);
+        break;
+      case CFG_SECRET:
+        out.println(*p ? "********" : "");
+        break;
+      case CFG_U16:
+        out.println(*(const uint16_t*)p);
+        break;
+      case CFG_U32:
+        out.println((unsigned long)*(const uint32_t*)p);
+        break;
+    }
+  }
+}
+
+void ConfigStore::command(Stream& out) {
+  char* cmd = strtok(_line, " ");
+  if (!cmd) {
+    return;
+  }
+  if (strcmp(cmd, "config") == 0) {
+    print(out);
+  } else if (strcmp(cmd, "set") == 0) {
+    char* name = strtok(NULL, " ");
+    char* value = strtok(NULL, "");  // Rest of the line, may contain spaces
+    out.println(name && set(name, value ? value : "") ? "OK" : "Bad field or value");
+  } else if (strcmp(cmd, "save") == 0) {
+    if (save()) {
+      out.println("Saved");
+    }
+  } else if (strcmp(cmd, "clear") == 0) {
+    clear();
+    out.println("Cleared, defaults apply after reset");
+  } else {
+    out.println("Commands: config, set <name> <value>, save, clear");
+  }
+}
+
+// Read provisioning commands a line at a time without blocking
+void ConfigStore::poll(Stream& in) {
+  while (in.available()) {
+    char c = in.read();
+    if (c == '\r' || c == '\n') {
+      if (_lineLen) {
+        _line[_lineLen] = '\0';
+        _lineLen = 0;
+        command(in);
+      }
+    } else if (_lineLen < CONFIG_LINE_LEN - 1) {
+      _line[_lineLen++] = c;
+    }
+  }
+}
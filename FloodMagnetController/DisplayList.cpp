@@ -0,0 +1,159 @@
+#include <Arduino.h>
+#include "DisplayList.h"
+
+#define BACKGROUND 1  // UNCOLORED, bits set are white
+
+DisplayList::displayItem* DisplayList::add(uint8_t type, int x, int y, int width, int height, int colored) {
+  if (_count >= DISPLAY_LIST_ITEMS) {
+    return NULL;
+  }
+  displayItem* item = &_items[_count++];
+  item->type = type;
+  item->colored = colored;
+  item->x = x;
+  item->y = y;
+  item->width = width;
+  item->height = height;
+  return item;
+}
+
+bool DisplayList::bitmap(int x, int y, int width, int height, const unsigned char* image) {
+  displayItem* item = add(ITEM_BITMAP, x, y, width, height, 0);
+  if (!item) {
+    return false;
+  }
+  item->data = image;
+  return true;
+}
+
+bool DisplayList::text(int x, int y, const char* text, sFONT* font, int colored) {
+  Paint measure(NULL, 0, 0);
+  displayItem* item = add(ITEM_TEXT, x, y, measure.MeasureString(text, strlen(text), font), font->Height, colored);
+  if (!item) {
+    return false;
+  }
+  item->data = text;
+  item->font = font;
+  return true;
+}
+
+bool DisplayList::line(int x0, int y0, int x1, int y1, int colored) {
+  // Kept as its ends, render() takes the rows between them
+  displayItem* item = add(ITEM_LINE, x0, y0, 0, 0, colored);
+  if (!item) {
+    return false;
+  }
+  item->a = x1;
+  item->b = y1;
+  return true;
+}
+
+// Samples scaled to fill the box, oldest on the left
+bool DisplayList::chart(int x, int y, int width, int height, const int16_t* samples, int count, int colored) {
+  displayItem* item = add(ITEM_CHART, x, y, width, height, colored);
+  if (!item) {
+    return false;
+  }
+  item->data = samples;
+  item->a = count;
+  item->b = item->c = count ? samples[0] : 0;
+  for (int i = 1; i < count; i++) {
+    if (samples[i] < item->b) {
+      item->b = samples[i];
+    }
+    if (samples[i] > item->c) {
+      item->c = samples[i];
+    }
+  }
+  return true;
+}
+
+// Returns the number of bands sent
+int DisplayList::render(StripTarget* target, unsigned char* band, int bandBytes) {
+  int rowBytes = (_width + 7) / 8;
+  int bandRows = bandBytes / rowBytes;
+  int bands = 0;
+  for (int top = 0; top < _height; top += bandRows) {
+    int rows = _height - top < bandRows ? _height - top : bandRows;
+    Paint paint(band, _width, rows);
+    paint.Clear(BACKGROUND);
+    for (int i = 0; i < _count; i++) {
+      const displayItem& item = _items[i];
+      int y0 = item.y;
+      int y1 = item.y + item.height;
+      if (item.type == ITEM_LINE) {
+        y0 = item.y < item.b ? item.y : item.b;
+        y1 = (item.y < item.b ? item.b : item.y) + 1;
+      }
+      if (y1 <= top || y0 >= top + rows) {
+        continue;
+      }
+      switch (item.type) {
+        case ITEM_BITMAP:
+          drawBitmap(item, band, top, rows);
+          break;
+        case ITEM_TEXT:
+          paint.DrawStringAt(item.x, item.y - top, (const char*)item.data, item.font, item.colored);
+          break;
+        case ITEM_LINE:
+          paint.DrawLine(item.x, item.y - top, item.a, item.b - top, item.colored);
+          break;
+        case ITEM_CHART:
+          drawChart(item, &paint, top);
+          break;
+      }
+    }
+    target->writeStrip(band, 0, top, _width, rows);
+    bands++;
+  }
+  return bands;
+}
+
+// Rows of the bitmap inside the band, a byte at a time where aligned
+void DisplayList::drawBitmap(const displayItem& item, unsigned char* band, int top, int rows) {
+  const unsigned char* image = (const unsigned char*)item.data;
+  int rowBytes = (_width + 7) / 8;
+  int imageBytes = (item.width + 7) / 8;
+  int first = item.y > top ? item.y : top;
+  int last = item.y + item.height < top + rows ? item.y + item.height : top + rows;
+  for (int y = first; y < last; y++) {
+    const unsigned char* src = &image[(y - item.y) * imageBytes];
+    unsigned char* dst = &band[(y - top) * rowBytes];
+    for (int i = 0; i < imageBytes; i++) {
+      unsigned char bits = pgm_read_byte(&src[i]);
+      int x = item.x + i * 8;
+      if (x % 8 == 0 && x >= 0 && x + 8 <= _width) {
+        dst[x / 8] = bits;
+        continue;
+      }
+      for (int b = 0; b < 8 && i * 8 + b < item.width; b++) {
+        int px = x + b;
+        if (px < 0 || px >= _width) {
+          continue;
+        }
+        if (bits & (0x80 >> b)) {
+          dst[px / 8] |= 0x80 >> (px % 8);
+        } else {
+          dst[px / 8] &= ~(0x80 >> (px % 8));
+        }
+      }
+    }
+  }
+}
+
+void DisplayList::drawChart(const displayItem& item, Paint* paint, int top) {
+  const int16_t* samples = (const int16_t*)item.data;
+  int count = item.a;
+  int range = item.c > item.b ? item.c - item.b : 1;
+  int lastX = 0;
+  int lastY = 0;
+  for (int i = 0; i < count; i++) {
+    int x = item.x + (count > 1 ? (long)i * (item.width - 1) / (count - 1) : 0);
+    int y = item.y + item.height - 1 - (long)(samples[i] - item.b) * (item.height - 1) / range;
+    if (i) {
+      paint->DrawLine(lastX, lastY - top, x, y - top, item.colored);
+    }
+    lastX = x;
+    lastY = y;
+  }
+}
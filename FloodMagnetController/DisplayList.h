@@ -0,0 +1,64 @@
+#ifndef _DISPLAY_LIST_H_
+#define _DISPLAY_LIST_H_
+
+#include <stdint.h>
+#include "EpdFrame.h"
+#include "epdpaint.h"
+
+#define DISPLAY_LIST_ITEMS 32
+#define BAND_BYTES 1024  // Same as the strip canvas
+
+// A screen recorded as draw commands, for panels whose frame would not
+// fit in RAM (a 4.2" needs 15 KB, a 7.5" 48 KB). Nothing is drawn when
+// a command is added. render() rasterises the whole list one band of
+// rows at a time into a small buffer, sending each band to the panel
+// before starting on the next. Strings, bitmaps and samples are
+// referenced, not copied, so they must outlive the list. Coordinates
+// are panel RAM pixels, unrotated.
+class DisplayList {
+public:
+  DisplayList(int width, int height) : _width(width), _height(height) {};
+  void clear(void) { _count = 0; }
+  bool bitmap(int x, int y, int width, int height, const unsigned char* image);  // In flash
+  bool text(int x, int y, const char* text, sFONT* font, int colored);
+  bool line(int x0, int y0, int x1, int y1, int colored);
+  bool chart(int x, int y, int width, int height, const int16_t* samples, int count, int colored);
+  int count(void) { return _count; }
+  int render(StripTarget* target, unsigned char* band, int bandBytes);
+
+private:
+  enum { ITEM_BITMAP, ITEM_TEXT, ITEM_LINE, ITEM_CHART };
+
+  struct displayItem {
+    uint8_t type;
+    uint8_t colored;
+    int16_t x, y, width, height;  // Bounds, bands outside them skip the item
+    const void* data;             // Bitmap, string or samples
+    sFONT* font;
+    int16_t a, b, c;              // Line end x, y. Chart sample count, min, max
+  };
+
+  int _width;
+  int _height;
+  displayItem _items[DISPLAY_LIST_ITEMS];
+  int _count = 0;
+
+  displayItem* add(uint8_t type, int x, int y, int width, int height, int colored);
+  void drawBitmap(const displayItem& item, unsigned char* band, int top, int rows);
+  void drawChart(const displayItem& item, Paint* paint, int top);
+};
+
+// Bands straight into an Epd's RAM, the shadow skips any it already holds
+template <class Panel>
+class EpdBands : public StripTarget {
+public:
+  EpdBands(Epd<Panel>* epd) : _epd(epd) {};
+  void writeStrip(const unsigned char* image, int x, int y, int width, int height) {
+    _epd->SetFrameMemory(image, x, y, width, height);
+  }
+
+private:
+  Epd<Panel>* _epd;
+};
+
+#endif
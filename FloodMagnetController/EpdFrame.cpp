@@ -0,0 +1,65 @@
+#include <Arduino.h>
+#include "EpdFrame.h"
+
+// Take a base image from flash the caller has sent with
+// SetFrameMemory_Base, so the panel already holds every row
+void EpdFrame::load(const unsigned char* image) {
+  for (int i = 0; i < FRAME_BYTES; i++) {
+    _frame[i] = pgm_read_byte(&image[i]);
+  }
+  for (int y = 0; y < EPD_HEIGHT; y++) {
+    _shown[y] = rowHash(y);
+  }
+}
+
+// Copy a strip in as SetFrameMemory_Partial would write it to the panel
+void EpdFrame::writeStrip(const unsigned char* image, int x, int y, int width, int height) {
+  if (image == NULL || x < 0 || width < 0 || y < 0 || height < 0) {
+    return;
+  }
+  x &= 0xF8;
+  width &= 0xF8;
+  int bytes = (x + width >= EPD_WIDTH ? EPD_WIDTH - x : width) / 8;
+  int rows = y + height >= EPD_HEIGHT ? EPD_HEIGHT - y : height;
+  for (int j = 0; j < rows; j++) {
+    memcpy(&_frame[(y + j) * FRAME_ROW_BYTES + x / 8], &image[j * (width / 8)], bytes);
+  }
+}
+
+// FNV-1a of one row
+uint32_t EpdFrame::rowHash(int y) {
+  uint32_t hash = 2166136261UL;
+  const unsigned char* row = &_frame[y * FRAME_ROW_BYTES];
+  for (int i = 0; i < FRAME_ROW_BYTES; i++) {
+    hash = (hash ^ row[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+// Send the changed rows, joining runs split by only a few unchanged
+// rows as each window costs a controller reset and LUT load.
+// Returns the number of rows sent.
+int EpdFrame::flush(Epd<Panel2in9>* epd) {
+  int sent = 0;
+  int y = 0;
+  while (y < EPD_HEIGHT) {
+    if (!changed(y)) {
+      y++;
+      continue;
+    }
+    int start = y;
+    int end = y + 1;  // One past the last changed row
+    for (y = end; y < EPD_HEIGHT && y < end + FRAME_RUN_GAP; y++) {
+      if (changed(y)) {
+        end = y + 1;
+      }
+    }
+    epd->SetFrameMemory_Partial(&_frame[start * FRAME_ROW_BYTES], 0, start, EPD_WIDTH, end - start);
+    for (int r = start; r < end; r++) {
+      _shown[r] = rowHash(r);
+    }
+    sent += end - start;
+    y = end;
+  }
+  return sent;
+}
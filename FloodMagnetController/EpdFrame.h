@@ -0,0 +1,38 @@
+#ifndef _EPD_FRAME_H_
+#define _EPD_FRAME_H_
+
+#include <stdint.h>
+#include "epd2in9_V2.h"
+
+#define FRAME_ROW_BYTES (EPD_WIDTH / 8)
+#define FRAME_BYTES (FRAME_ROW_BYTES * EPD_HEIGHT)
+#define FRAME_RUN_GAP 12  // Unchanged rows cheaper to resend than opening a new window
+
+// Somewhere strips drawn with Paint go, at panel coordinates as for
+// Epd::SetFrameMemory_Partial
+class StripTarget {
+public:
+  virtual void writeStrip(const unsigned char* image, int x, int y, int width, int height) = 0;
+};
+
+// Full frame held in RAM, for FULL_FRAME builds. Strips are composited
+// into it and flush() sends only the rows that changed since the last
+// upload, one partial window per run of changed rows, instead of one
+// window per strip. Each row's last upload is kept as a hash, not a
+// second copy of the frame.
+class EpdFrame : public StripTarget {
+public:
+  void load(const unsigned char* image);
+  void writeStrip(const unsigned char* image, int x, int y, int width, int height);
+  int flush(Epd<Panel2in9>* epd);
+  unsigned char* getImage(void) { return _frame; }
+
+private:
+  unsigned char _frame[FRAME_BYTES];
+  uint32_t _shown[EPD_HEIGHT];  // Hash of each row as the panel holds it
+
+  uint32_t rowHash(int y);
+  bool changed(int y) { return rowHash(y) != _shown[y]; }
+};
+
+#endif
@@ -0,0 +1,58 @@
+#include <Arduino.h>
+#include "EpdGroup.h"
+
+bool EpdGroup::add(EpdRefresh* panel) {
+  if (_count >= EPD_GROUP_PANELS) {
+    return false;
+  }
+  _panels[_count] = panel;
+  _started[_count] = false;
+  _count++;
+  return true;
+}
+
+void EpdGroup::wait(int panel) {
+  if (_started[panel]) {
+    _panels[panel]->FinishFrame();
+    _started[panel] = false;
+  }
+}
+
+void EpdGroup::start(int panel, bool partial) {
+  wait(panel);
+  if (partial) {
+    _panels[panel]->StartFrame_Partial();
+  } else {
+    _panels[panel]->StartFrame();
+  }
+  _started[panel] = true;
+}
+
+bool EpdGroup::busy(void) {
+  bool any = false;
+  for (int i = 0; i < _count; i++) {
+    if (!_started[i]) {
+      continue;
+    }
+    if (_panels[i]->Busy()) {
+      any = true;
+    } else {
+      wait(i);
+    }
+  }
+  return any;
+}
+
+// Panels finish in any order, each is let go as soon as it is idle
+void EpdGroup::finish(void) {
+  while (busy()) {
+    delay(5);
+  }
+}
+
+void EpdGroup::refresh(bool partial) {
+  for (int i = 0; i < _count; i++) {
+    start(i, partial);
+  }
+  finish();
+}
@@ -0,0 +1,30 @@
+#ifndef _EPD_GROUP_H_
+#define _EPD_GROUP_H_
+
+#include "epd2in9_V2.h"
+
+#define EPD_GROUP_PANELS 4
+
+// Several panels sharing the SPI bus and DC, each an Epd with its own
+// reset, CS and BUSY pins. A refresh keeps a panel busy for seconds
+// without the bus, so each panel's refresh is started as soon as its
+// RAM is written and the next panel is written meanwhile. A round of
+// updates takes about as long as the slowest refresh plus the SPI
+// time, not the sum of the refreshes.
+class EpdGroup {
+public:
+  bool add(EpdRefresh* panel);
+  int count(void) { return _count; }
+  void wait(int panel);                 // Before writing a panel's RAM
+  void start(int panel, bool partial);  // Once its RAM is written
+  bool busy(void);                      // Any still refreshing, finishing those done
+  void finish(void);                    // Waits for every panel started
+  void refresh(bool partial);           // Every panel at once, RAM already written
+
+private:
+  EpdRefresh* _panels[EPD_GROUP_PANELS];
+  bool _started[EPD_GROUP_PANELS];
+  int _count = 0;
+};
+
+#endif
@@ -7,130 +7,250 @@ FloodAPI::FloodAPI() {
 
 void FloodAPI::init() {
   state = INIT;
+  previous_state = INIT;
+  severityFilter.reset(INIT);
 }
 
+// Apply the actions for the transition from the previous state
 int FloodAPI::updateState(warning_levels state) {
-  static warning_levels previous_state = INIT;
-  // static warning_levels previous_state = NONE;
-  if (state != previous_state) {
-    previous_state = state;
-    switch (state) {
-      // case NONE:
-      case INIT:
-        // led_colour(GREEN);
-        break;
-      case SEVERE_FLOOD_WARNING:
-        led_colour(RED);
-        buzzer_on();
-        break;
-      case FLOOD_WARNING:
-        led_colour(RED);
-        buzzer_on();
-        break;
-      case FLOOD_ALERT:
-        led_colour(AMBER);
-        buzzer_on();
-        break;
-      case NO_LONGER:
-        led_colour(GREEN);
-        break;
-      default:
-        break;
-    }
+  // The indicators may run ahead of the official warning
+  warning_levels indicated = state;
+  if (severityRank[earlyWarning] > severityRank[state]) {
+    indicated = earlyWarning;
+  } else if (earlyShown && state == NONE) {
+    indicated = NO_LONGER;  // Prediction withdrawn
+  }
+  earlyShown = (severityRank[indicated] > severityRank[state]);
+
+  const stateAction& action = transition(previous_state, indicated);
+  bool alarm = (action.buzzer == BUZZ_ON);
+#ifndef TREND_BUZZER
+  // A prediction is shown on the LEDs only, the alarm is held back
+  // until the official warning reaches the same level
+  if (earlyShown) {
+    alarmOwed = alarmOwed || alarm;
+    alarm = false;
+  } else {
+    alarm = alarm || (alarmOwed && indicated == previous_state && enterActions[indicated].buzzer == BUZZ_ON);
+    alarmOwed = false;
+  }
+#endif
+  previous_state = indicated;
+  this->state = state;
+  if (action.led != LED_KEEP) {
+    annunciator.play(ANN_SEVERITY, &annSeverity[indicated]);
+  }
+  if (alarm) {
+    annunciator.play(ANN_ALARM, &annAlarm[indicated]);
+  } else if (action.buzzer == BUZZ_OFF) {
+    annunciator.stop(ANN_ALARM);
   }
   return state;
 }
 
 // Advance through states and wrap around
 void FloodAPI::demo(modes m) {
-  // Inject mock timestamp
-  memcpy(warning.time_raised, "2023-01-01 00:01:00", DATESTR_LEN - 1);
+  // Inject mock timestamp, 2023-01-01 00:01:00
+  warning.time_raised = 1672531260UL;
   static warning_levels state = NONE;
   warning.severityLevel = state;
   Serial.println(warning.severityLevel);
   updateState(warning.severityLevel);
-  switch (state) {
-    case NONE:
-      state = FLOOD_ALERT;
-      break;
-    case SEVERE_FLOOD_WARNING:
-      state = NO_LONGER;
-      break;
-    case FLOOD_WARNING:
-      state = SEVERE_FLOOD_WARNING;
-      break;
-    case FLOOD_ALERT:
-      state = FLOOD_WARNING;
-      break;
-    case NO_LONGER:
-      state = NONE;
-      break;
+  state = demoNext[state];
+}
+
+// Debounce a reading and update the warning struct
+void FloodAPI::applyReading(warning_levels reading, const char* area_id, uint32_t time_raised) {
+  lastReading = reading;
+  warning.severityLevel = severityFilter.update(reading, millis());
+  if (reading && reading == warning.severityLevel) {  // only update these items if the level is not zero and accepted
+    if (area_id) {
+      strncpy(warning.flood_area_id, area_id, FLOOD_AREA_LEN - 1);
+    }
+    warning.time_raised = time_raised;
   }
 }
 
+// Listen for change notifications pushed by the gateway
+void FloodAPI::beginNotify() {
+#ifdef GATEWAY_HOST
+  // Anyone on the LAN can send to the port, only the gateway is heard
+  notifyOn = WiFi.hostByName(GATEWAY_HOST, gatewayIP) == 1 && udp.begin(NOTIFY_PORT);
+#endif
+}
+
+// Apply a pushed notification from the gateway for our area, returns 1
+// if one arrived.
+// The gateway repeats the current state every poll. Only a new sequence
+// number is a reading for the severity filter, so repeats can't run
+// down the downgrade debounce. A repeat still shows the gateway is
+// there and the data current.
+int FloodAPI::checkNotify() {
+  if (!notifyOn || udp.parsePacket() <= 0) {
+    return 0;
+  }
+  if (!(udp.remoteIP() == gatewayIP)) {
+    return 0;
+  }
+  uint8_t buf[NOTIFY_LEN];
+  int len = udp.read(buf, sizeof(buf));
+  floodNotify notify;
+  if (len <= 0 || !decodeNotify(buf, len, &notify) || !notifyFor(notify, config.area)) {
+    return 0;
+  }
+  if (notify.seq == notifySeq) {
+    severityFilter.heard();
+    return 1;
+  }
+  notifySeq = notify.seq;
+  etag[0] = '\0';  // Cached response is out of date
+  applyReading(toLevel(notify.severity), notify.area, notify.time_raised);
+  return 1;
+}
+
+// Fetch the warning, blocking until it is in. Returns 1 on success.
 int FloodAPI::getData() {
-  WiFiSSLClient client;
+  if (!startData()) {
+    return 0;
+  }
+  int result;
+  while ((result = pollData()) < 0) {
+  }
+  return result;
+}
+
+// Send off the request for the warning, pollData() reads the response
+bool FloodAPI::startData() {
+  char request[HTTP_REQUEST_LEN];
+  int len = snprintf(request, sizeof(request),
+                     "GET /flood-monitoring/id/floodAreas/%s HTTP/1.1\r\n"
+                     "Host: environment.data.gov.uk\r\n",
+                     config.area);
+  if (etag[0]) {  // Conditional request, 304 if unchanged
+    len += snprintf(&request[len], sizeof(request) - len, "If-None-Match: %s\r\n", etag);
+  }
+  snprintf(&request[len], sizeof(request) - len, "Connection: close\r\n\r\n");
+  scanner.begin();
+#ifdef GATEWAY_HOST
+  // Connect to local gateway
+  Serial.println("Connecting to gateway " GATEWAY_HOST);
+  bool started = fetch.begin(GATEWAY_HOST, GATEWAY_PORT, request, this, millis());
+#else
   // Connect to host
   Serial.println("Connecting to environment.data.gov.uk");
+  bool started = fetch.begin("environment.data.gov.uk", 443, request, this, millis());
+#endif
+  if (!started) {
+    Serial.println("Request too long");
+    severityFilter.failed();
+  }
+  return started;
+}
+
+// Move the fetch on by one step. Returns -1 while it is still running
+// or none is, then once 1 when the warning has been applied or 0 on
+// failure.
+int FloodAPI::pollData() {
+  if (!fetch.busy()) {
+    return -1;
+  }
+  fetch.step(millis());
+  if (fetch.busy()) {
+    return -1;
+  }
+  int result = 0;
+  if (fetch.phase() == HTTP_FAILED) {
+    Serial.print(fetch.timedOut() ? "Timed out in phase " : "Failed in phase ");
+    Serial.println(fetch.failedIn());
+  } else if (fetch.status() == 304) {  // Unchanged since the last poll, repeat the last reading
+    warning.severityLevel = severityFilter.update(lastReading, millis());
+    Serial.println("Flood data not modified");
+    result = 1;
+  } else if (fetch.status() != 200) {
+    Serial.print("Unexpected HTTP status ");
+    Serial.println(fetch.status());
+  } else if (!scanner.complete()) {
+    Serial.println("Flood data incomplete");
+  } else {
+    // Update warning struct with the debounced level
+    uint32_t time_raised = 0;
+    parseIsoTime(scanner.timeRaised(), &time_raised);  // "2022-12-19T15:20:31"
+    applyReading(toLevel(scanner.severity()), scanner.areaId(), time_raised);
+    Serial.println("Flood data received!");
+    result = 1;
+  }
+  if (!result) {
+    severityFilter.failed();
+  }
+  fetch.stop();  // Reported, back to idle
+  return result;
+}
+
+// Sync the clock from the Date header and keep the ETag for the next
+// conditional request
+void FloodAPI::header(const char* line) {
+  if (strncmp(line, "Date: ", 6) == 0) {
+    uint32_t serverTime;
+    if (parseHttpDate(line + 6, &serverTime)) {
+      clockSync(serverTime);
+    }
+  } else if (strncmp(line, "ETag: ", 6) == 0 && (fetch.status() == 200 || fetch.status() == 304)
+             && strlen(line + 6) < sizeof(etag)) {
+    strcpy(etag, line + 6);
+  }
+}
+
+bool FloodAPI::body(const uint8_t* data, size_t len) {
+  scanner.feed((const char*)data, len);
+  return true;
+}
+#ifdef SITE_LAT
+// Stream the flood area polygon and check it contains the site.
+// Returns 1 if inside, 0 if outside or -1 on error.
+int FloodAPI::checkArea() {
+  WiFiSSLClient client;
+  Serial.print("Checking site is in flood area ");
+  Serial.println(config.area);
   if (!client.connect("environment.data.gov.uk", 443)) {
     Serial.println("Failed to connect to server");
-    return 1;
+    return -1;
   }
-
-  // Send HTTP request
-  client.println("GET /flood-monitoring/id/floodAreas/" AREA_CODE " HTTP/1.1");
+  client.print("GET /flood-monitoring/id/floodAreas/");
+  client.print(config.area);
+  client.println("/polygon HTTP/1.1");
   client.println("Host: environment.data.gov.uk");
   client.println("Connection: close");
   client.println();
 
-  // Check status code
   char status[32] = { 0 };
   client.readBytesUntil('\r', status, sizeof(status));
-  // should be "HTTP/1.0 200 OK"
-  Serial.println(status);
   if (memcmp(status + 9, "200 OK", 6) != 0) {
     Serial.print("Unexpected HTTP status");
     Serial.println(status);
     client.stop();
-    return 0;
-  }
-
-  // Skip response headers
-  client.find("\r\n\r\n");
-
-  // Stream& input;
-  StaticJsonDocument<128> filter;
-
-  // Filter data objects so the response fits into memory
-  JsonObject filter_items = filter.createNestedObject("items");
-  filter_items["currentWarning"]["severityLevel"] = true;
-  filter_items["currentWarning"]["floodAreaID"] = true;
-  filter_items["currentWarning"]["timeRaised"] = true;
-
-  StaticJsonDocument<1024> doc;
-
-  DeserializationError error = deserializeJson(doc, client, DeserializationOption::Filter(filter));
-
-  if (error) {
-    Serial.print("deserializeJson() failed: ");
-    Serial.println(error.c_str());
     return -1;
   }
+  client.find("\r\n\r\n");
 
-  // Update warning struct
-  warning.severityLevel = doc["items"]["currentWarning"]["severityLevel"];                                               // 3
-  if (warning.severityLevel) {                                                                                           // only update these items if the level is not zero
-    memcpy(warning.flood_area_id, doc["items"]["currentWarning"]["floodAreaID"].as<const char*>(), FLOOD_AREA_LEN - 1);  // "Tributaries between Dorchester and ...
-
-    memcpy(warning.time_raised, doc["items"]["currentWarning"]["timeRaised"].as<const char*>(), DATESTR_LEN - 1);  // "2022-12-19T15:20:31"
-    for (int i = 0; i < DATESTR_LEN; i++) {
-      if (warning.time_raised[i] == 'T') {
-        warning.time_raised[i] = ' ';
-      }
-    }
+  // Polygons can be megabytes, parse as they arrive
+  PolygonLocator locator;
+  geoPoint site = { (int32_t)lround(SITE_LAT * 1e6), (int32_t)lround(SITE_LONG * 1e6) };
+  locator.begin(site);
+  char buf[64];
+  size_t len;
+  while ((len = client.readBytes(buf, sizeof(buf))) > 0) {
+    locator.feed(buf, len);
   }
-  // Close the connection to the server
   client.stop();
 
-  Serial.println("Flood data received!");
-}
\ No newline at end of file
+  if (!locator.valid()) {
+    Serial.println("No polygon found");
+    return -1;
+  }
+  Serial.print(locator.bytes());
+  Serial.print(" bytes, ");
+  Serial.print(locator.points());
+  Serial.println(locator.contains() ? " points, site is inside the area" : " points, site is OUTSIDE the area");
+  return locator.contains();
+}
+#endif
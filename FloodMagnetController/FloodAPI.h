@@ -2,40 +2,69 @@
 #define _FLOOD_API_H_
 
 #include <WiFiNINA.h>
-#include <ArduinoJson.h>
 #include "magnet_config.h"
-#include "led.h"
-#include "buzzer.h"
+#include "DeviceConfig.h"
+#include "Annunciator.h"
+#include "FloodTime.h"
+#include "FloodStates.h"
+#include "SeverityFilter.h"
+#include "FloodNotify.h"
+#include "FloodPolygon.h"
+#include "HttpFetch.h"
+#include "WarningScan.h"
 
 #define DATESTR_LEN 17     // "2022-12-19T15:20:31" -> "2022-12-19 15:20"
 #define FLOOD_AREA_LEN 20  // Flood area description
+#define ETAG_LEN 24        // ETag from the gateway e.g. "6ad5a939-1"
 
-enum warning_levels { INIT = -1,
-                      NONE,
-                      SEVERE_FLOOD_WARNING,
-                      FLOOD_WARNING,
-                      FLOOD_ALERT,
-                      NO_LONGER };
 enum modes { DEMO_MODE,
              STD_MODE,
              REPLAY_MODE };
 
 struct floodWarning {
-  char time_raised[DATESTR_LEN] = { '\0' };
+  uint32_t time_raised = 0;  // Seconds since 1970 UTC, 0 if not known
   warning_levels severityLevel = NONE;
   char flood_area_id[FLOOD_AREA_LEN] = { '\0' };
 };
 
-class FloodAPI {
+class FloodAPI : public HttpConsumer {
 public:
   floodWarning warning;  // Flood warning data
   int state;
+  warning_levels previous_state = INIT;
+  warning_levels earlyWarning = NONE;  // Predicted locally from river levels
+  SeverityFilter severityFilter = SeverityFilter(DEBOUNCE_READINGS, DEBOUNCE_TIME, STALE_FAILURES);
   FloodAPI();
 public:
   void init();
   int updateState(warning_levels state);
   int getData();
+  bool startData();
+  int pollData();
+  bool fetching() { return fetch.busy(); }
+  void header(const char* line);
+  bool body(const uint8_t* data, size_t len);
+  void beginNotify();
+  int checkNotify();
+  int checkArea();
   void demo(modes m);
+private:
+  char etag[ETAG_LEN] = { '\0' };  // Last ETag seen, sent as If-None-Match
+  warning_levels lastReading = NONE;  // Raw level behind the ETag
+  WiFiUDP udp;                        // Gateway push notifications
+  bool notifyOn = false;
+  IPAddress gatewayIP;                // Notifications from anywhere else are dropped
+  uint32_t notifySeq = 0;             // Last notification applied
+  bool earlyShown = false;            // Indicators are ahead of the warning
+  bool alarmOwed = false;             // Held back for an early warning
+#ifdef GATEWAY_HOST
+  WiFiClient warningClient;
+#else
+  WiFiSSLClient warningClient;
+#endif
+  HttpFetch fetch = HttpFetch(&warningClient);  // Warning poll, run from loop()
+  WarningScanner scanner;
+  void applyReading(warning_levels reading, const char* area_id, uint32_t time_raised);
 };
 
 #endif
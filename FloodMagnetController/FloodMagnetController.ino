@@ -9,7 +9,8 @@ If you make use of this data please acknowledge this with the following attribut
   Install the following libraries using the Arduino Libary Manager:
   Arduino WiFiNINA https://github.com/arduino-libraries/WiFiNINA
   Benoît Blanchon ArduinoJson https://arduinojson.org/
-  Evert-arias EasyButton https://github.com/evert-arias/EasyButton
+  Cristian Maglie FlashStorage https://github.com/cmaglie/FlashStorage
+  Andrassy ArduinoOTA https://github.com/JAndrassy/ArduinoOTA
   Waveshare EDP2in9 https://github.com/waveshareteam/e-Paper/tree/master/Arduino/epd2in9_V2
 
   Author: Peter Milne
@@ -20,11 +21,13 @@ If you make use of this data please acknowledge this with the following attribut
   Version 3, 29 June 2007
 */
 
-#include <EasyButton.h>
+#include "DeviceConfig.h"
 #include "FloodAPI.h"
 #include "FloodMagnetDisplay.h"
-#include "led.h"
-#include "buzzer.h"
+#include "FloodReadings.h"
+#include "FloodOTA.h"
+#include "Annunciator.h"
+#include "ButtonEvents.h"
 
 // Button connections
 #define B1_PIN 21
@@ -38,22 +41,29 @@ modes mode = STD_MODE;
 
 const char* soft_version = "0.5.2";
 
+unsigned long lastAgeRender = 0;
+
 FloodAPI myFloodAPI = FloodAPI();
 
 FloodMagnetDisplay epd = FloodMagnetDisplay(&myFloodAPI);
 
+#ifdef STATION_ID
+FloodReadings myReadings = FloodReadings(STATION_ID);
+#endif
+
 // int status = WL_IDLE_STATUS;
 
-EasyButton button1(B1_PIN);
-EasyButton button2(B2_PIN);
-EasyButton button3(B3_PIN);
-EasyButton button4(B4_PIN);
-EasyButton button5(B5_PIN);
-EasyButton button6(B6_PIN);
+// Button indices, in the order added to buttons
+enum button_ids { BUTTON_B1,
+                  BUTTON_B2,
+                  BUTTON_B3,
+                  BUTTON_B4,
+                  BUTTON_B5,
+                  BUTTON_B6 };
 
 void setup() {
-  led_init();
-  buzzer_init();
+  annunciator.begin();
+  annunciator.play(ANN_FEEDBACK, &annLampTest);
 
   // Initialize Serial Port
   Serial.begin(115200);
@@ -65,21 +75,23 @@ void setup() {
   Serial.print("Starting client version: ");
   Serial.println(soft_version);
 
-  // Initialize buttons
-  button1.begin();
-  button1.onPressed(dry);
-  button2.begin();
-  button2.onPressed(rain);  // Place holder
-  button3.begin();
-  button3.onPressed(flood);  // Place holder
-  button4.begin();
-  button4.onPressed(replay);
-  button4.onPressedFor(2000, buzzer_off);  // Cancel buzzer
-  button5.begin();
-  button6.begin();
-  button6.onPressed(clock_sync_ap_mode);  // Place holder
+  // Saved settings override the config header, type "config" to list them
+  configStore.load();
+
+  // Initialize buttons, debounced from the annunciator's timer
+  buttons.add(B1_PIN);
+  buttons.add(B2_PIN);
+  buttons.add(B3_PIN);
+  buttons.add(B4_PIN, 2000);  // Held to cancel buzzer
+  buttons.add(B5_PIN);
+  buttons.add(B6_PIN);
+  buttons.begin();
+  annunciator.onTick([] { buttons.tick(); });
 
   // Setup display and show greeting
+#ifdef STATION_ID
+  epd.chart.setSeries(&myReadings.series);
+#endif
   epd.initDisplay();
   epd.showGreeting();
 
@@ -87,9 +99,9 @@ void setup() {
 
   // Hold down B5 while pressing reset to enter demo mode
   // Press reset to exit back to standard mode
-  if (button5.isPressed()) {
+  if (buttons.isPressed(BUTTON_B5)) {
     mode = DEMO_MODE;
-    rgb_colour(RED);
+    annunciator.play(ANN_STATUS, &annDemo);
     Serial.println("Starting demo mode...");
     doDemo();
   }
@@ -97,65 +109,162 @@ void setup() {
 }
 
 void loop() {
-  // Continuously update the button states
-  button1.read();
-  button2.read();
-  button3.read();
-  button4.read();
-  // button5.read(); Read only in setup
-  button6.read();
+  doButtons();
+  configStore.poll(Serial);
 
   if (WiFi.status() != WL_CONNECTED) {  // Connect wifi
     delay(5000);
-    rgb_colour(RED);
+    annunciator.play(ANN_STATUS, &annConnecting);
     epd.wifiOn = false;
     reconnectWiFi();
     if (WiFi.status() == WL_CONNECTED) {
-      rgb_colour(GREEN);
+      annunciator.play(ANN_STATUS, &annOnline);
       epd.wifiOn = true;
       Serial.println("Wifi connected...");
-      doUpdate();  // Initial update
+      clockSync(WiFi.getTime());  // NTP, 0 if not yet available
+      myFloodAPI.beginNotify();
+#ifdef SITE_LAT
+      static bool areaChecked = false;
+      if (!areaChecked) {
+        areaChecked = (myFloodAPI.checkArea() >= 0);
+      }
+#endif
+      startUpdate(true, false);  // Initial update
+      checkOTA(true);
     }
     else {
       epd.connectionError();
     }
   }
+  doNotify();
+
   unsigned long now = millis();
   static unsigned long lastApiAttemp = 0;
-  if (WiFi.status() == WL_CONNECTED)  {
-    if ((now - lastApiAttemp > ALERT_INTERVAL) || (mode == REPLAY_MODE)) {
+  if (WiFi.status() == WL_CONNECTED && !myFloodAPI.fetching())  {
+    if ((now - lastApiAttemp > config.alertInterval) || (mode == REPLAY_MODE)) {
+      bool replay = (mode == REPLAY_MODE);
       mode = STD_MODE;  // Clear replay
-      doUpdate();
+      startUpdate(replay, true);
       lastApiAttemp = now;
     }
   }
+  pollUpdate();
+
+  checkOTA(false);
+
+  // Keep the "N min ago" line current between polls
+  uint32_t ageInterval = epd.ageInterval();
+  if (ageInterval && (now - lastAgeRender > ageInterval * 1000UL)) {
+    epd.updateAge();
+    lastAgeRender = now;
+  }
+}
+
+// Warning before the poll, for showUpdate() once the response is in
+struct pendingUpdate {
+  warning_levels lastLevel;
+  uint32_t lastRaised;
+  bool force;
+  bool readings;  // River levels follow the warning
+};
+
+pendingUpdate pending;
+
+// Start polling the warning, loop() carries on while it downloads
+void startUpdate(bool force, bool readings) {
+  pending.lastLevel = myFloodAPI.warning.severityLevel;
+  pending.lastRaised = myFloodAPI.warning.time_raised;
+  pending.force = force;
+  pending.readings = readings;
+  if (!myFloodAPI.startData()) {
+    finishUpdate(0);
+  }
 }
 
-void doUpdate() {
-  int result = myFloodAPI.getData();
+void pollUpdate() {
+  int result = myFloodAPI.pollData();
+  if (result >= 0) {
+    finishUpdate(result);
+  }
+}
+
+void finishUpdate(int result) {
+  epd.staleOn = myFloodAPI.severityFilter.stale();
   if (result) {
-    myFloodAPI.updateState(myFloodAPI.warning.severityLevel);
-    epd.updateDisplay();
-    printData();
+    showUpdate(pending.lastLevel, pending.lastRaised, pending.force);
   } 
   else {
     epd.apiError();
   }
+#ifdef STATION_ID
+  if (pending.readings && myReadings.getData() > 0) {
+    epd.updateChart();
+    checkTrend();
+  }
+#endif
+}
+
+// Apply a change pushed by the gateway without polling
+void doNotify() {
+  warning_levels lastLevel = myFloodAPI.warning.severityLevel;
+  uint32_t lastRaised = myFloodAPI.warning.time_raised;
+  if (myFloodAPI.checkNotify()) {
+    epd.staleOn = false;
+    showUpdate(lastLevel, lastRaised, false);
+  }
+}
+
+// Only refresh the display if the debounced warning changed or forced
+void showUpdate(warning_levels lastLevel, uint32_t lastRaised, bool force) {
+  myFloodAPI.updateState(myFloodAPI.warning.severityLevel);
+  if (force || myFloodAPI.warning.severityLevel != lastLevel || myFloodAPI.warning.time_raised != lastRaised) {
+    epd.updateDisplay();
+    lastAgeRender = millis();
+    printData();
+  }
+}
+
+#ifdef STATION_ID
+// Raise a local Flood Alert if the river will reach LEVEL_ALERT soon
+void checkTrend() {
+  uint32_t secs;
+  warning_levels early = NONE;
+  if (LEVEL_ALERT && myReadings.trend.timeTo(LEVEL_ALERT, TREND_MIN_RATE, &secs)) {
+    Serial.print("Rising ");
+    Serial.print(myReadings.trend.rate());
+    Serial.print(" mm/hr, alert level in ");
+    Serial.print(secs / 60);
+    Serial.println(" min");
+    if (secs < TREND_HORIZON) {
+      early = FLOOD_ALERT;
+    }
+  }
+  if (early != myFloodAPI.earlyWarning) {
+    myFloodAPI.earlyWarning = early;
+    myFloodAPI.updateState(myFloodAPI.warning.severityLevel);
+  }
+}
+#endif
+
+// Look for a firmware patch for this version, daily or when forced
+void checkOTA(bool force) {
+#ifdef OTA_HOST
+  static unsigned long lastCheck = 0;
+  if (WiFi.status() == WL_CONNECTED && (force || millis() - lastCheck > OTA_INTERVAL)) {
+    otaUpdate(OTA_HOST, OTA_PORT, "magnet", soft_version, config.otaKey);
+    lastCheck = millis();
+  }
+#endif
 }
 
 void doDemo() {
   epd.demoOn = true;
   while (1) {
-    button1.read();
-    button2.read();
-    button3.read();
-    button4.read();
-    // button5.read(); Read only in setup
-    button6.read();
+    doButtons();
     unsigned long now = millis();
     static unsigned long lastUpdate = 0;
-    if (now - lastUpdate > DEMO_INTERVAL) {
-      buzzer_off();
+    if (now - lastUpdate > config.demoInterval) {
+      annunciator.stop(ANN_ALARM);
       myFloodAPI.demo(DEMO_MODE);
       epd.updateDisplay();
       lastUpdate = millis();
@@ -174,42 +283,81 @@ int reconnectWiFi() {
 
   WiFi.disconnect();  // Force a disconnect
   delay(1000);
-  WiFi.begin(SECRET_SSID, SECRET_PASS);
+  WiFi.begin(config.ssid, config.pass);
   Serial.print("Wifi status: ");
   Serial.println(WiFi.status());
   return WiFi.status();
 }
 
+// Run the handlers for the button events queued since the last call.
+// As with EasyButton, a press acts when it is released, unless it
+// was held.
+void doButtons() {
+  static bool held[BUTTON_COUNT_MAX] = { false };
+  buttonEvent event;
+  while (buttons.next(&event)) {
+    if (event.type == BUTTON_PRESSED) {
+      held[event.button] = false;
+    } else if (event.type == BUTTON_HELD) {
+      held[event.button] = true;
+      if (event.button == BUTTON_B4) {
+        buzzerOff();
+      }
+    } else if (!held[event.button]) {
+      switch (event.button) {
+        case BUTTON_B1:
+          dry();
+          break;
+        case BUTTON_B2:
+          rain();  // Place holder
+          break;
+        case BUTTON_B3:
+          flood();  // Place holder
+          break;
+        case BUTTON_B4:
+          replay();
+          break;
+        case BUTTON_B6:
+          clock_sync_ap_mode();  // Place holder
+          break;
+        default:  // B5 is read only in setup
+          break;
+      }
+    }
+    buttons.handled(event);
+  }
+}
+
 // Button callbacks
 void dry() {
   Serial.println("B1 button pressed...");
-  bip();
+  annunciator.bip();
 }
 
 void rain() {
   Serial.println("B2 button pressed...");
-  bip();
+  annunciator.bip();
 }
 
 void flood() {
   Serial.println("B3 button pressed...");
-  bip();
+  annunciator.bip();
 }
 
 void replay() {
   Serial.println("B4 button pressed...");
   mode = REPLAY_MODE;
-  bip();
+  annunciator.bip();
 }
 
 void buzzerOff() {
   Serial.println("B4 button held...");
-  buzzer_off();
+  annunciator.stop(ANN_ALARM);
 }
 
 void clock_sync_ap_mode() {
   Serial.println("B6 button pressed...");
-  bip();
+  annunciator.bip();
 }
 
 // Debug output
@@ -220,6 +368,30 @@ void printData() {
   Serial.print("Warning Level: ");
   Serial.println(myFloodAPI.warning.severityLevel);
 
+  char timeStr[DATESTR_LEN] = { '\0' };
+  if (myFloodAPI.warning.time_raised) {
+    formatTime(myFloodAPI.warning.time_raised, timeStr);
+  }
   Serial.print("Time Raised: ");
-  Serial.println(myFloodAPI.warning.time_raised);
+  Serial.println(timeStr);
+
+  Serial.print("Refreshes: ");
+  Serial.print(epd.refresh.fullRefreshes());
+  Serial.print(" full, ");
+  Serial.print(epd.refresh.partialRefreshes());
+  Serial.print(" partial, ");
+  Serial.print(epd.refresh.partials());
+  Serial.println(" since the last full");
+
+  Serial.print("Buttons: ");
+  Serial.print(buttons.events());
+  Serial.print(" events, latency mean ");
+  Serial.print(buttons.latencyMeanUs() / 1000);
+  Serial.print(" ms, max ");
+  Serial.print(buttons.latencyMaxUs() / 1000);
+  Serial.print(" ms, queued up to ");
+  Serial.print(buttons.waitMaxUs() / 1000);
+  Serial.print(" ms, ");
+  Serial.print(buttons.dropped());
+  Serial.println(" dropped");
 }
@@ -1,9 +1,8 @@
 #include "FloodMagnetDisplay.h"
 
-// Flood warning text
-static char w1[5][12] = { "No Flood", "DANGER TO", "Flooding is", "Flooding is", "Warning no" };
-static char w2[5][12] = { "Warnings", "LIFE", "Expected", "Possible", "Longer in" };
-static char w3[5][12] = { "", "", "", "", "Force" };
+// Screen for each display template, the background with the warning
+// message and "Updated" already drawn in. Only the fields below change.
+static const unsigned char* images[5] = { epd_screen_no_warnings, epd_screen_severe, epd_screen_warning, epd_screen_alert, epd_screen_removed };
 
 void FloodMagnetDisplay::initDisplay(void) {
   if (_epd.Init() != 0) {
@@ -18,6 +17,10 @@ void FloodMagnetDisplay::initDisplay(void) {
 
   _epd.SetFrameMemory_Base(RSLOGO);
   _epd.DisplayFrame();
+#ifdef FULL_FRAME
+  frame.load(RSLOGO);
+#endif
+  refresh.fullDone(-1, millis());  // Not a severity screen, the first update is full
 }
 
 void FloodMagnetDisplay::showGreeting(void) {
@@ -26,30 +29,31 @@ void FloodMagnetDisplay::showGreeting(void) {
   _paint.SetRotate(ROTATE_180);
 
   _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 4, "  Flood  ", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 140, _paint.GetWidth(), _paint.GetHeight());
+  _paint.DrawStringCentred(0, 4, _paint.GetWidth(), "Flood", &Font16, COLORED);
+  writeStrip(_paint.GetImage(), 0, 140, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 4, "  Magnet  ", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
+  _paint.DrawStringCentred(0, 4, _paint.GetWidth(), "Magnet", &Font16, COLORED);
+  writeStrip(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 4, "Concept:", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 80, _paint.GetWidth(), _paint.GetHeight());
+  _paint.DrawStringCentred(0, 4, _paint.GetWidth(), "Concept:", &Font16, COLORED);
+  writeStrip(_paint.GetImage(), 0, 80, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 4, "Jude Pullen", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 60, _paint.GetWidth(), _paint.GetHeight());
+  _paint.DrawStringCentred(0, 4, _paint.GetWidth(), "Jude Pullen", &Font16, COLORED);
+  writeStrip(_paint.GetImage(), 0, 60, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, "Code:", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 20, _paint.GetWidth(), _paint.GetHeight());
+  _paint.DrawStringCentred(0, 0, _paint.GetWidth(), "Code:", &Font16, COLORED);
+  writeStrip(_paint.GetImage(), 0, 20, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, "Pete Milne", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 0, _paint.GetWidth(), _paint.GetHeight());
+  _paint.DrawStringCentred(0, 0, _paint.GetWidth(), "Pete Milne", &Font16, COLORED);
+  writeStrip(_paint.GetImage(), 0, 0, _paint.GetWidth(), _paint.GetHeight());
 
-  _epd.DisplayFrame_Partial();
+  showStrips();
+  _overdrawn = true;
 }
 
 void FloodMagnetDisplay::connectionError(void) {
@@ -59,13 +63,14 @@ void FloodMagnetDisplay::connectionError(void) {
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 4, "Connection", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 140, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 140, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 4, "Error", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
 
-  _epd.DisplayFrame_Partial();
+  showStrips();
+  _overdrawn = true;
 }
 
 void FloodMagnetDisplay::apiError(void) {
@@ -75,18 +80,23 @@ void FloodMagnetDisplay::apiError(void) {
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 4, "API", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 140, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 140, _paint.GetWidth(), _paint.GetHeight());
 
   _paint.Clear(UNCOLORED);
   _paint.DrawStringAt(0, 4, "Error", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
 
-  _epd.DisplayFrame_Partial();
+  _paint.Clear(UNCOLORED);
+  _paint.DrawStringAt(0, 4, (staleOn ? "Data stale" : ""), &Font16, COLORED);
+  writeStrip(_paint.GetImage(), 0, 100, _paint.GetWidth(), _paint.GetHeight());
+
+  showStrips();
+  _overdrawn = true;
 }
 
 void FloodMagnetDisplay::updateDisplay() {
   Serial.println("Updating display...");
-  int severityLevel = _magnet->warning.severityLevel;
+  int tpl = levelTemplate(_magnet->warning.severityLevel);
   // Index warning string based on severity level
   //int warning_idx = severityLevel ? severityLevel : 0;
   //  char single_digit[] = {'0', '\0'};
@@ -94,68 +104,40 @@ void FloodMagnetDisplay::updateDisplay() {
   //  char three_digit[] = {'0', '/', '0', '\0'};
   //  char four_digit[] = {'0', '/', '0', '0',  '\0'};
   //
-  // Set background
-  if (_epd.Init() != 0) {
-    return;
+  // Set background, in full only when the screen changes or ghosting
+  // has built up, see RefreshPolicy
+  if (refresh.fullDue(_magnet->warning.severityLevel, millis())) {
+    if (_epd.Init() != 0) {
+      return;
+    }
+    // One full refresh drives every pixel through black and white,
+    // clearing to white first as well only doubled the flashing
+    _epd.SetFrameMemory_Base(images[tpl]);
+    _epd.DisplayFrame();
+#ifdef FULL_FRAME
+    frame.load(images[tpl]);
+#endif
+    refresh.fullDone(_magnet->warning.severityLevel, millis());
+  } else if (_overdrawn) {
+    writeStrip(images[tpl], 0, 0, EPD_WIDTH, EPD_HEIGHT);
   }
-  _epd.ClearFrameMemory(0xFF);  // bit set = white, bit reset = black
-  _epd.DisplayFrame();
+  _overdrawn = false;
 
-  delay(500);
-  switch (severityLevel) {
-    case NONE:
-      _epd.SetFrameMemory_Base(epd_flood_warning_removed);
-      break;
-    case SEVERE_FLOOD_WARNING:
-      _epd.SetFrameMemory_Base(epd_flood_warning_severe);
-      break;
-    case FLOOD_WARNING:
-      _epd.SetFrameMemory_Base(epd_flood_warning);
-      break;
-    case FLOOD_ALERT:
-      _epd.SetFrameMemory_Base(epd_flood_alert);
-      break;
-    case NO_LONGER:
-      _epd.SetFrameMemory_Base(epd_flood_warning_removed);
-      break;
-    default:
-      break;
+  // River level chart, below the message
+  if (chart.hasSeries()) {
+    chart.draw(this);
   }
 
-  _epd.DisplayFrame();
-
-  // Static text
   _paint.SetWidth(120);
   _paint.SetHeight(40);
   _paint.SetRotate(ROTATE_180);
 
-  // _paint.Clear(UNCOLORED);
-  // _paint.DrawStringAt(0, 0, "UV Max", &Font16, COLORED);
-  // _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 140, _paint.GetWidth(), _paint.GetHeight());
-
-  _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, w1[severityLevel], &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 120, _paint.GetWidth(), _paint.GetHeight());
-
-  _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, w2[severityLevel], &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 100, _paint.GetWidth(), _paint.GetHeight());
-
-  _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, w3[severityLevel], &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 80, _paint.GetWidth(), _paint.GetHeight());
-
   // _paint.Clear(UNCOLORED);
   // _paint.DrawStringAt(0, 0, LINE_4, &Font16, COLORED);
   // _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 60, _paint.GetWidth(), _paint.GetHeight());
 
-  _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, "Updated", &Font16, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 40, _paint.GetWidth(), _paint.GetHeight());
-
-  _paint.Clear(UNCOLORED);
-  _paint.DrawStringAt(0, 0, (_magnet->warning.time_raised ? _magnet->warning.time_raised : ""), &Font12, COLORED);
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 20, _paint.GetWidth(), _paint.GetHeight());
+  drawTimeRaised();
+  writeStrip(_paint.GetImage(), 0, 20, _paint.GetWidth(), _paint.GetHeight());
 
   // _paint.Clear(UNCOLORED);
   // _paint.DrawStringAt(0, 0, LINE_7, &Font16, COLORED);
@@ -174,7 +156,87 @@ void FloodMagnetDisplay::updateDisplay() {
   } else {
     _paint.DrawStringAt(0, 0, "", &Font16, COLORED);
   }
-  _epd.SetFrameMemory_Partial(_paint.GetImage(), 0, 0, _paint.GetWidth(), _paint.GetHeight());
+  writeStrip(_paint.GetImage(), 0, 0, _paint.GetWidth(), _paint.GetHeight());
+
+  showStrips();
+}
+
+// Timestamp and relative age, e.g. "2022-12-19 15:20" over "12 min ago"
+void FloodMagnetDisplay::drawTimeRaised(void) {
+  char timeStr[DATESTR_LEN] = { '\0' };
+  char ageStr[AGE_STR_LEN] = { '\0' };
+  uint32_t raised = _magnet->warning.time_raised;
+  if (raised) {
+    formatTime(raised, timeStr);
+    uint32_t now = clockNow();
+    if (now) {
+      formatAge(now > raised ? now - raised : 0, ageStr, sizeof(ageStr));
+    }
+  }
+  _paint.Clear(UNCOLORED);
+  _paint.DrawStringAt(0, 0, timeStr, &Font12, COLORED);
+  _paint.DrawStringAt(0, 14, ageStr, &Font12, COLORED);
+}
+
+// Re-render only the timestamp strip so the relative age stays current,
+// with the fast waveform
+void FloodMagnetDisplay::updateAge(void) {
+  if (refresh.fullDue(_magnet->warning.severityLevel, millis())) {
+    updateDisplay();  // Ghosting budget spent, redraw it all
+    return;
+  }
+  _paint.SetWidth(120);
+  _paint.SetHeight(40);
+  _paint.SetRotate(ROTATE_180);
+  _epd.SetWaveform(WAVEFORM_FAST);  // Only a line of small text changes
+
+  drawTimeRaised();
+  writeStrip(_paint.GetImage(), 0, 20, _paint.GetWidth(), _paint.GetHeight());
+  showStrips();
+  _epd.SetWaveform(WAVEFORM_PARTIAL);
+}
+
+// Seconds until the relative age shown on screen next changes
+uint32_t FloodMagnetDisplay::ageInterval(void) {
+  uint32_t raised = _magnet->warning.time_raised;
+  uint32_t now = clockNow();
+  if (!raised || !now || now < raised) {
+    return 0;
+  }
+  return ageRefreshInterval(now - raised);
+}
+
+// Plot new river level samples, redrawing the chart only if rescaled
+void FloodMagnetDisplay::updateChart(void) {
+  if (!chart.hasSeries()) {
+    return;
+  }
+  if (refresh.fullDue(_magnet->warning.severityLevel, millis())) {
+    updateDisplay();
+    return;
+  }
+  if (!chart.addLatest(this)) {
+    chart.draw(this);
+  }
+  showStrips();
+}
+
+// Strips go straight to the panel, or with FULL_FRAME are composited
+// in RAM and only the rows that changed are sent by showStrips()
+void FloodMagnetDisplay::writeStrip(const unsigned char* image, int x, int y, int width, int height) {
+#ifdef FULL_FRAME
+  frame.writeStrip(image, x, y, width, height);
+#else
+  _epd.SetFrameMemory_Partial(image, x, y, width, height);
+  _stripArea += (uint32_t)width * height;
+#endif
+}
 
+void FloodMagnetDisplay::showStrips(void) {
+#ifdef FULL_FRAME
+  _stripArea = (uint32_t)frame.flush(&_epd) * EPD_WIDTH;
+#endif
   _epd.DisplayFrame_Partial();
+  refresh.partialDone(_stripArea, millis());
+  _stripArea = 0;
 }
@@ -4,28 +4,34 @@
 #include "FloodAPI.h"
 #include "epd2in9_V2.h"
 #include "epdpaint.h"
+#include "EpdFrame.h"
+#include "LevelChart.h"
+#include "RefreshPolicy.h"
 #include "img/rslogo.h"
 
 // Image converter https://javl.github.io/image2cpp/ 
-#include "img/flood_warning_removed.h"    // Level 0
-#include "img/flood_warning_severe.h"     // Level 1
-#include "img/flood_warning.h"            // Level 2
-#include "img/flood_alert.h"              // Level 3
-#include "img/flood_warning_removed.h"    // Level 4
+// Backgrounds with the static text composited by FontTools/screenpack
+#include "img/flood_screens.h"
 
 #define COLORED     0
 #define UNCOLORED   1
 
 
 
-class FloodMagnetDisplay {
+class FloodMagnetDisplay : public StripTarget {
   public:
   bool wifiOn = false;
   bool demoOn = false;
+  bool staleOn = false;
   unsigned char image[1024];
-  Epd _epd; // default reset: 8, dc: 9, cs: 10, busy: 7
+  Epd<Panel2in9> _epd;  // Pins in epdif.h
   Paint _paint = Paint(image, 0, 0);
   FloodAPI* _magnet;
+  LevelChart chart;
+  RefreshPolicy refresh = RefreshPolicy(REFRESH_MAX_PARTIALS, REFRESH_MAX_AREA, REFRESH_IDLE);
+#ifdef FULL_FRAME
+  EpdFrame frame;
+#endif
 
   FloodMagnetDisplay(FloodAPI* magnet) : _magnet(magnet) {};
   void initDisplay(void);
@@ -33,6 +39,17 @@ class FloodMagnetDisplay {
   void showGreeting(void);
   void connectionError(void);
   void apiError(void);
+  void updateAge(void);
+  void updateChart(void);
+  uint32_t ageInterval(void);
+  void writeStrip(const unsigned char* image, int x, int y, int width, int height);
+
+  private:
+  bool _overdrawn = false;   // Greeting or an error drawn over the screen
+  uint32_t _stripArea = 0;  // Pixels written since the last showStrips()
+
+  void drawTimeRaised(void);
+  void showStrips(void);
 };
 
 #endif
@@ -0,0 +1,89 @@
+#include <FlashStorage.h>
+#include "FloodOTA.h"
+
+// Running image in flash, new image to InternalStorage
+class FlashTarget : public PatchTarget {
+public:
+  uint8_t readOld(uint32_t offset) {
+    uint8_t b;
+    _flash.read((const void*)(uintptr_t)(OTA_IMAGE_START + offset), &b, 1);
+    return b;
+  }
+  bool write(uint8_t b) { return InternalStorage.write(b) == 1; }
+
+private:
+  FlashClass _flash;
+};
+
+int otaUpdate(const char* host, int port, const char* name, const char* version, const char* key) {
+  uint8_t keyBytes[PATCH_KEY_LEN];
+  if (!parseKey(key, keyBytes)) {
+    Serial.println("No OTA key, set otaKey to check for updates");
+    return -1;
+  }
+  WiFiClient client;
+  if (!client.connect(host, port)) {
+    Serial.println("Failed to connect to OTA server");
+    return -1;
+  }
+  client.print("GET /firmware/");
+  client.print(name);
+  client.print("-");
+  client.print(version);
+  client.println(".patch HTTP/1.0");
+  client.print("Host: ");
+  client.println(host);
+  client.println("Connection: close");
+  client.println();
+
+  // Check status code, 404 if there is no newer release
+  char status[32] = { 0 };
+  client.readBytesUntil('\r', status, sizeof(status));
+  if (memcmp(status + 9, "404", 3) == 0) {
+    client.stop();
+    return 0;
+  }
+  if (memcmp(status + 9, "200 OK", 6) != 0) {
+    Serial.print("Unexpected HTTP status");
+    Serial.println(status);
+    client.stop();
+    return -1;
+  }
+  client.find("\r\n\r\n");
+
+  // Check the header against the running image before erasing anything
+  FlashTarget flash;
+  PatchApplier applier(&flash, keyBytes);
+  uint8_t buf[64];
+  size_t len = client.readBytes(buf, PATCH_HEADER_LEN);
+  if (!applier.feed(buf, len) || !applier.headerDone()) {
+    Serial.println(applier.error() ? applier.error() : "Short patch");
+    client.stop();
+    return -1;
+  }
+  if (applier.header().newLen > OTA_MAX_LEN || !InternalStorage.open(applier.header().newLen)) {
+    Serial.println("Update too big for flash");
+    client.stop();
+    return -1;
+  }
+  Serial.print("Updating to ");
+  Serial.print(applier.header().newLen);
+  Serial.println(" byte image");
+  while ((len = client.readBytes(buf, sizeof(buf))) > 0) {
+    if (!applier.feed(buf, len)) {
+      break;
+    }
+  }
+  client.stop();
+  InternalStorage.close();
+
+  if (!applier.verified()) {
+    Serial.println(applier.error() ? applier.error() : "Update incomplete, CRC mismatch or unsigned");
+    InternalStorage.clear();
+    return -1;
+  }
+  Serial.println("Update verified, restarting");
+  delay(500);
+  InternalStorage.apply();  // Copies the new image over the running one and resets
+  return -1;
+}
@@ -0,0 +1,33 @@
+#ifndef _FLOOD_OTA_H_
+#define _FLOOD_OTA_H_
+
+#include <WiFiNINA.h>
+#include <InternalStorage.h>
+#include "ConfigStore.h"
+#include "FloodPatch.h"
+
+// Over the air updates from a local HTTP server, shared by Flood Magnet
+// and Flood Falcon. Keep the copies identical.
+//
+// The server holds delta patches made by FloodGateway/floodpatch, named
+// firmware/<name>-<running version>.patch. The patch is applied as it
+// downloads, reading the running image and writing the new one to the
+// inactive upper half of flash with ArduinoOTA's InternalStorage. It is
+// only installed once its CRC and the patch's HMAC under the device's
+// OTA key match, otherwise the running image is kept. Images stop short
+// of the config record's flash rows, so saved settings survive the
+// update.
+//
+// There is no rollback. Installing copies the new image over the
+// running one, so a release that fails after it starts is fixed with
+// another patch, or over USB if it cannot reach the server.
+
+#define OTA_IMAGE_START FLASH_SKETCH_START
+#define OTA_MAX_LEN (CONFIG_FLASH_ADDR - OTA_IMAGE_START)
+
+// Returns 0 if there is no update for this version or -1 on failure.
+// A verified update is installed and the board restarts. key is the
+// OTA key as 64 hex digits, updates are refused without one.
+int otaUpdate(const char* host, int port, const char* name, const char* version, const char* key);
+
+#endif
@@ -0,0 +1,143 @@
+#include <string.h>
+#include "FloodPolygon.h"
+
+void PolygonLocator::begin(geoPoint site) {
+  *this = PolygonLocator();
+  _site = site;
+  _min.lat = _min.lon = INT32_MAX;
+  _max.lat = _max.lon = INT32_MIN;
+}
+
+void PolygonLocator::feed(const char* data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    feedChar(data[i]);
+  }
+  _bytes += len;
+}
+
+void PolygonLocator::feedChar(char c) {
+  if (_inString) {
+    if (_escape) {
+      _escape = false;
+    } else if (c == '\\') {
+      _escape = true;
+    } else if (c == '"') {
+      _inString = false;
+      _key[_keyLen] = '\0';
+    } else if (_keyLen < sizeof(_key) - 1) {
+      _key[_keyLen++] = c;
+    }
+    return;
+  }
+  if (_inNumber) {
+    if (c >= '0' && c <= '9') {
+      if (_exp) {
+        return;  // Exponents are not used for coordinates
+      }
+      if (!_frac) {
+        _whole = _whole < 1000 ? _whole * 10 + (c - '0') : _whole;
+      } else if (_fracDigits < 6) {
+        _micro = _micro * 10 + (c - '0');
+        _fracDigits++;
+      }
+      return;
+    }
+    if (c == '.') {
+      _frac = true;
+      return;
+    }
+    if (c == 'e' || c == 'E' || c == '+' || (c == '-' && _exp)) {
+      _exp = true;
+      return;
+    }
+    endNumber();
+  }
+
+  switch (c) {
+    case '"':
+      _inString = true;
+      _keyLen = 0;
+      break;
+    case ':':
+      _keyCoords = (strcmp(_key, "coordinates") == 0);
+      break;
+    case '[':
+      if (_coordDepth || _keyCoords) {
+        _coordDepth++;
+        _nums = 0;
+      }
+      _keyCoords = false;
+      break;
+    case ']':
+      if (_coordDepth) {
+        if (_nums >= 2) {  // End of a [lon, lat] position
+          geoPoint p = { _pos[1], _pos[0] };
+          addPoint(p);
+        } else if (_ringPoints) {  // End of a ring
+          addEdge(_prev, _first);
+          _ringPoints = 0;
+        }
+        _nums = 0;
+        _coordDepth--;
+      }
+      break;
+    case ',':
+    case ' ':
+    case '\t':
+    case '\r':
+    case '\n':
+      break;
+    default:
+      _keyCoords = false;
+      if (_coordDepth && (c == '-' || (c >= '0' && c <= '9'))) {
+        _inNumber = true;
+        _neg = (c == '-');
+        _frac = false;
+        _exp = false;
+        _fracDigits = 0;
+        _whole = _neg ? 0 : c - '0';
+        _micro = 0;
+      }
+      break;
+  }
+}
+
+void PolygonLocator::endNumber(void) {
+  _inNumber = false;
+  int32_t value = _micro;
+  for (uint8_t i = _fracDigits; i < 6; i++) {
+    value *= 10;
+  }
+  value += _whole * 1000000L;
+  if (_nums < 2) {
+    _pos[_nums] = _neg ? -value : value;
+  }
+  _nums++;
+}
+
+void PolygonLocator::addPoint(geoPoint p) {
+  if (_ringPoints) {
+    addEdge(_prev, p);
+  } else {
+    _first = p;
+  }
+  _prev = p;
+  _ringPoints++;
+  _points++;
+  _min.lat = p.lat < _min.lat ? p.lat : _min.lat;
+  _min.lon = p.lon < _min.lon ? p.lon : _min.lon;
+  _max.lat = p.lat > _max.lat ? p.lat : _max.lat;
+  _max.lon = p.lon > _max.lon ? p.lon : _max.lon;
+}
+
+// Toggle if the edge crosses the ray running east from the site
+void PolygonLocator::addEdge(geoPoint a, geoPoint b) {
+  if ((a.lat > _site.lat) == (b.lat > _site.lat)) {
+    return;
+  }
+  int64_t lhs = (int64_t)(_site.lon - a.lon) * (b.lat - a.lat);
+  int64_t rhs = (int64_t)(_site.lat - a.lat) * (b.lon - a.lon);
+  if (b.lat > a.lat ? lhs < rhs : lhs > rhs) {
+    _inside = !_inside;
+  }
+}
@@ -0,0 +1,68 @@
+#ifndef _FLOOD_POLYGON_H_
+#define _FLOOD_POLYGON_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Streaming point-in-polygon test for flood area GeoJSON, shared by
+// Flood Magnet and FloodGateway. Keep the copies identical.
+//
+// The polygon endpoint can return megabytes, so the body is fed through
+// in chunks of any size and never held. Each edge is tested against the
+// site as it is parsed (even-odd rule over every ring), which handles
+// holes and MultiPolygons without keeping any vertices. Coordinates are
+// parsed as integer microdegrees, no floating point is used.
+
+struct geoPoint {
+  int32_t lat;  // Microdegrees, north positive
+  int32_t lon;  // Microdegrees, east positive
+};
+
+class PolygonLocator {
+public:
+  void begin(geoPoint site);
+  void feed(const char* data, size_t len);
+  bool valid(void) { return _points >= 3; }  // Found a polygon
+  bool contains(void) { return _inside; }
+  uint32_t points(void) { return _points; }
+  uint32_t bytes(void) { return _bytes; }
+  geoPoint boundsMin(void) { return _min; }  // Bounding box
+  geoPoint boundsMax(void) { return _max; }
+
+private:
+  geoPoint _site;
+  geoPoint _first;  // Current ring
+  geoPoint _prev;
+  geoPoint _min;
+  geoPoint _max;
+  bool _inside;
+  uint32_t _points;
+  uint32_t _ringPoints;
+  uint32_t _bytes;
+
+  // Tokeniser
+  bool _inString;
+  bool _escape;
+  uint8_t _keyLen;
+  char _key[12];        // Last string seen, truncated
+  bool _keyCoords;      // "coordinates" followed by ':'
+  uint8_t _coordDepth;  // Array nesting inside "coordinates"
+  uint8_t _nums;        // Numbers in the current array
+  int32_t _pos[2];      // [lon, lat]
+
+  // Number being parsed
+  bool _inNumber;
+  bool _neg;
+  bool _frac;
+  bool _exp;
+  uint8_t _fracDigits;
+  int32_t _whole;
+  int32_t _micro;
+
+  void feedChar(char c);
+  void endNumber(void);
+  void addPoint(geoPoint p);
+  void addEdge(geoPoint a, geoPoint b);
+};
+
+#endif
@@ -0,0 +1,97 @@
+#include "FloodReadings.h"
+
+struct levelReading {
+  uint32_t time;
+  int32_t level;
+};
+
+// Fetch readings since the last one held, returns the number received
+// or -1 on error
+int FloodReadings::getData() {
+  WiFiSSLClient client;
+  Serial.println("Connecting to environment.data.gov.uk for readings");
+  if (!client.connect("environment.data.gov.uk", 443)) {
+    Serial.println("Failed to connect to server");
+    return -1;
+  }
+
+  // Only ask for what we don't have, sorted newest first
+  uint32_t since = 0;
+  if (series.count()) {
+    since = series.lastTime() + 60;
+  } else if (clockValid()) {
+    since = clockNow() - READINGS_HISTORY;
+  }
+  client.print("GET /flood-monitoring/id/stations/");
+  client.print(_station);
+  client.print("/readings?_sorted&_limit=");
+  client.print(READINGS_LIMIT);
+  if (since) {  // Latest readings only until the clock is synced
+    char sinceStr[TIME_STR_LEN];
+    formatTime(since, sinceStr);  // "2022-12-19 15:20"
+    sinceStr[10] = 'T';
+    client.print("&since=");
+    client.print(sinceStr);
+    client.print(":00Z");
+  }
+  client.println(" HTTP/1.1");
+  client.println("Host: environment.data.gov.uk");
+  client.println("Connection: close");
+  client.println();
+
+  // Check status code
+  char status[32] = { 0 };
+  client.readBytesUntil('\r', status, sizeof(status));
+  if (memcmp(status + 9, "200 OK", 6) != 0) {
+    Serial.print("Unexpected HTTP status");
+    Serial.println(status);
+    client.stop();
+    return -1;
+  }
+
+  // Skip response headers and stream the items array one reading at a time
+  client.find("\r\n\r\n");
+  if (!client.find("\"items\"") || !client.find("[")) {
+    client.stop();
+    return -1;
+  }
+
+  StaticJsonDocument<64> filter;
+  filter["dateTime"] = true;
+  filter["measure"] = true;
+  filter["value"] = true;
+
+  StaticJsonDocument<256> doc;
+  static levelReading batch[READINGS_BATCH];  // 800 bytes for a day, off the stack
+  int count = 0;
+  do {
+    DeserializationError error = deserializeJson(doc, client, DeserializationOption::Filter(filter));
+    if (error) {
+      Serial.print("deserializeJson() failed: ");
+      Serial.println(error.c_str());
+      break;
+    }
+    // Stations may report flow as well as level
+    const char* measure = doc["measure"];
+    if (!measure || !strstr(measure, "-" STATION_PARAMETER "-")) {
+      continue;
+    }
+    uint32_t time;
+    if (count < READINGS_BATCH && parseIsoTime(doc["dateTime"], &time)) {  // "2023-01-01T00:15:00Z"
+      batch[count].time = time;
+      batch[count].level = lround(doc["value"].as<float>() * 1000);  // m to mm
+      count++;
+    }
+  } while (client.findUntil(",", "]"));
+  client.stop();
+
+  // Oldest first into the series
+  for (int i = count - 1; i >= 0; i--) {
+    if (series.append(batch[i].time, batch[i].level)) {
+      trend.update(batch[i].time, batch[i].level);
+    }
+  }
+  Serial.print("Readings received: ");
+  Serial.println(count);
+  return count;
+}
@@ -0,0 +1,28 @@
+#ifndef _FLOOD_READINGS_H_
+#define _FLOOD_READINGS_H_
+
+#include <WiFiNINA.h>
+#include <ArduinoJson.h>
+#include "magnet_config.h"
+#include "FloodTime.h"
+#include "LevelSeries.h"
+#include "LevelTrend.h"
+
+// Readings kept per poll, newest first, enough for READINGS_HISTORY
+#define READINGS_BATCH (READINGS_HISTORY / READINGS_INTERVAL + 2)
+// Readings asked for, a station may report flow as well as level
+#define READINGS_LIMIT (2 * READINGS_BATCH)
+
+// Incrementally polls a monitoring station's readings into a LevelSeries
+class FloodReadings {
+public:
+  LevelSeries series;  // Level history in mm
+  LevelTrend trend;    // Rate of rise
+  FloodReadings(const char* station) : _station(station) {};
+  int getData();
+
+private:
+  const char* _station;
+};
+
+#endif
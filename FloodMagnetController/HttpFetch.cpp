@@ -0,0 +1,217 @@
+#include "HttpFetch.h"
+
+// Copies the request, host must outlive the fetch
+bool HttpFetch::begin(const char* host, uint16_t port, const char* request, HttpConsumer* consumer, unsigned long now) {
+  stop();
+  _requestLen = strlen(request);
+  if (_requestLen >= HTTP_REQUEST_LEN) {
+    return false;
+  }
+  memcpy(_request, request, _requestLen);
+  _host = host;
+  _port = port;
+  _consumer = consumer;
+  _sent = 0;
+  _lineLen = 0;
+  _status = 0;
+  _chunked = false;
+  _length = -1;
+  _remaining = 0;
+  _timedOut = false;
+  _failedIn = HTTP_IDLE;
+  _start = now;
+  enter(HTTP_CONNECT, now);
+  return true;
+}
+
+httpPhase HttpFetch::step(unsigned long now) {
+  if (!busy()) {
+    return _phase;
+  }
+  if (now - _start > deadlines.total || now - _phaseStart > _phaseLimit) {
+    _timedOut = true;
+    fail();
+    return _phase;
+  }
+  if (_phase == HTTP_CONNECT) {
+    if (!_client->connect(_host, _port)) {
+      fail();
+    } else {
+      enter(HTTP_SEND, now);
+    }
+    return _phase;
+  }
+  if (_phase == HTTP_SEND) {
+    int len = _requestLen - _sent < HTTP_STEP_BYTES ? _requestLen - _sent : HTTP_STEP_BYTES;
+    _sent += _client->write((const uint8_t*)&_request[_sent], len);
+    if (_sent >= _requestLen) {
+      enter(HTTP_STATUS, now);
+    }
+    return _phase;
+  }
+
+  int available = _client->available();
+  if (available <= 0) {
+    if (!_client->connected()) {
+      if (_phase == HTTP_BODY && _length < 0) {
+        finish(HTTP_DONE);  // Body ran to the close
+      } else {
+        fail();
+      }
+    }
+    return _phase;
+  }
+  uint8_t buf[HTTP_STEP_BYTES];
+  int len = _client->read(buf, available < HTTP_STEP_BYTES ? available : HTTP_STEP_BYTES);
+  if (len > 0) {
+    receive(buf, len, now);
+  }
+  return _phase;
+}
+
+// Abandons a fetch in progress
+void HttpFetch::stop(void) {
+  if (busy()) {
+    _client->stop();
+  }
+  _phase = HTTP_IDLE;
+}
+
+void HttpFetch::enter(httpPhase phase, unsigned long now) {
+  _phase = phase;
+  _phaseStart = now;
+  switch (phase) {
+    case HTTP_CONNECT:
+      _phaseLimit = deadlines.total;
+      break;
+    case HTTP_SEND:
+      _phaseLimit = deadlines.send;
+      break;
+    case HTTP_STATUS:
+      _phaseLimit = deadlines.status;
+      break;
+    case HTTP_HEADERS:
+      _phaseLimit = deadlines.headers;
+      break;
+    default:
+      _phaseLimit = deadlines.stall;
+      break;
+  }
+}
+
+void HttpFetch::finish(httpPhase phase) {
+  _client->stop();
+  _phase = phase;
+}
+
+void HttpFetch::fail(void) {
+  _failedIn = _phase;
+  finish(HTTP_FAILED);
+}
+
+void HttpFetch::receive(const uint8_t* data, int len, unsigned long now) {
+  int i = 0;
+  while (i < len && busy()) {
+    if (_phase == HTTP_BODY || _phase == HTTP_CHUNK_DATA) {
+      bool sized = _phase == HTTP_CHUNK_DATA || _length >= 0;
+      long run = len - i;
+      if (sized && _remaining < run) {
+        run = _remaining;
+      }
+      if (!_consumer->body(&data[i], run)) {
+        fail();
+        return;
+      }
+      i += run;
+      if (sized && (_remaining -= run) == 0) {
+        if (_phase == HTTP_CHUNK_DATA) {
+          enter(HTTP_CHUNK_END, now);
+        } else {
+          finish(HTTP_DONE);
+        }
+      }
+      continue;
+    }
+    char c = data[i++];
+    if (c == '\n') {
+      if (_lineLen > 0 && _line[_lineLen - 1] == '\r') {
+        _lineLen--;
+      }
+      _line[_lineLen] = '\0';
+      line(now);
+      _lineLen = 0;
+    } else if (_lineLen < HTTP_LINE_LEN - 1) {
+      _line[_lineLen++] = c;
+    }
+  }
+  if (_phase >= HTTP_BODY && _phase <= HTTP_TRAILERS) {
+    _phaseStart = now;  // Still coming, the stall timer restarts
+  }
+}
+
+// A complete status, header, chunk size or trailer line
+void HttpFetch::line(unsigned long now) {
+  switch (_phase) {
+    case HTTP_STATUS: {
+      const char* code = strchr(_line, ' ');  // "HTTP/1.1 200 OK"
+      if (strncmp(_line, "HTTP/", 5) != 0 || !code) {
+        fail();
+        return;
+      }
+      _status = atoi(code + 1);
+      enter(HTTP_HEADERS, now);
+      break;
+    }
+    case HTTP_HEADERS:
+      if (_lineLen == 0) {
+        headersDone(now);
+        return;
+      }
+      if (strncasecmp(_line, "Content-Length:", 15) == 0) {
+        _length = atol(&_line[15]);
+      } else if (strncasecmp(_line, "Transfer-Encoding:", 18) == 0 && strstr(&_line[18], "chunked")) {
+        _chunked = true;
+      }
+      _consumer->header(_line);
+      break;
+    case HTTP_CHUNK_SIZE: {
+      char* end;
+      _remaining = strtol(_line, &end, 16);  // Any extension after a ';' is ignored
+      if (end == _line || _remaining < 0) {
+        fail();
+      } else {
+        enter(_remaining ? HTTP_CHUNK_DATA : HTTP_TRAILERS, now);
+      }
+      break;
+    }
+    case HTTP_CHUNK_END:
+      if (_lineLen != 0) {
+        fail();
+      } else {
+        enter(HTTP_CHUNK_SIZE, now);
+      }
+      break;
+    case HTTP_TRAILERS:
+      if (_lineLen == 0) {
+        finish(HTTP_DONE);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void HttpFetch::headersDone(unsigned long now) {
+  if (_status / 100 == 1) {  // 100 Continue, the real status follows
+    enter(HTTP_STATUS, now);
+  } else if (_status == 204 || _status == 304) {
+    finish(HTTP_DONE);
+  } else if (_chunked) {
+    enter(HTTP_CHUNK_SIZE, now);
+  } else if (_length == 0) {
+    finish(HTTP_DONE);
+  } else {
+    _remaining = _length;
+    enter(HTTP_BODY, now);
+  }
+}
@@ -0,0 +1,91 @@
+#ifndef _HTTP_FETCH_H_
+#define _HTTP_FETCH_H_
+
+#include <Arduino.h>
+#include <Client.h>
+
+#define HTTP_REQUEST_LEN 256  // Request line and headers
+#define HTTP_LINE_LEN 80      // Status and header lines kept, longer ones are cut
+#define HTTP_STEP_BYTES 128   // Most bytes sent or received by one step()
+
+enum httpPhase { HTTP_IDLE,
+                 HTTP_CONNECT,
+                 HTTP_SEND,
+                 HTTP_STATUS,
+                 HTTP_HEADERS,
+                 HTTP_BODY,
+                 HTTP_CHUNK_SIZE,
+                 HTTP_CHUNK_DATA,
+                 HTTP_CHUNK_END,  // CRLF after a chunk's data
+                 HTTP_TRAILERS,
+                 HTTP_DONE,
+                 HTTP_FAILED };
+
+// Longest each phase may take, in ms
+struct httpDeadlines {
+  unsigned long send;     // Writing the request
+  unsigned long status;   // To the status line, the server's think time
+  unsigned long headers;  // All the headers
+  unsigned long stall;    // Body, between bytes
+  unsigned long total;    // Whole fetch, connecting included
+};
+
+// Where the response goes as it arrives. Header lines come without
+// their CRLF, cut to HTTP_LINE_LEN - 1. Body bytes come with any
+// chunked framing removed. Return false from body() to abort.
+class HttpConsumer {
+public:
+  virtual void header(const char* line) {}
+  virtual bool body(const uint8_t* data, size_t len) = 0;
+};
+
+// HTTP/1.1 request that moves on by one bounded step per call, so
+// loop() keeps running however slow the server or the network. Each
+// step() sends or reads at most HTTP_STEP_BYTES, never waits for more,
+// and fails the fetch once its phase runs past its deadline. Bodies
+// may be sized by Content-Length, chunked or end at the close.
+// connect() is the exception, WiFiNINA only has a blocking one.
+class HttpFetch {
+public:
+  HttpFetch(Client* client) : _client(client) {};
+  httpDeadlines deadlines = { 5000, 10000, 5000, 5000, 30000 };
+
+  bool begin(const char* host, uint16_t port, const char* request, HttpConsumer* consumer, unsigned long now);
+  httpPhase step(unsigned long now);
+  void stop(void);
+  bool busy(void) { return _phase != HTTP_IDLE && _phase != HTTP_DONE && _phase != HTTP_FAILED; }
+  httpPhase phase(void) { return _phase; }
+  int status(void) { return _status; }
+  httpPhase failedIn(void) { return _failedIn; }  // Phase a failed fetch stopped in
+  bool timedOut(void) { return _timedOut; }
+
+private:
+  Client* _client;
+  HttpConsumer* _consumer = NULL;
+  const char* _host = NULL;
+  uint16_t _port = 0;
+  char _request[HTTP_REQUEST_LEN];
+  int _requestLen = 0;
+  int _sent = 0;
+  httpPhase _phase = HTTP_IDLE;
+  httpPhase _failedIn = HTTP_IDLE;
+  bool _timedOut = false;
+  unsigned long _start = 0;
+  unsigned long _phaseStart = 0;  // Or the last body byte, for stalls
+  unsigned long _phaseLimit = 0;
+  char _line[HTTP_LINE_LEN];
+  int _lineLen = 0;
+  int _status = 0;
+  bool _chunked = false;
+  long _length = -1;     // Content-Length, -1 to read to the close
+  long _remaining = 0;   // Of the body or the chunk
+
+  void enter(httpPhase phase, unsigned long now);
+  void finish(httpPhase phase);
+  void fail(void);
+  void receive(const uint8_t* data, int len, unsigned long now);
+  void line(unsigned long now);
+  void headersDone(unsigned long now);
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "LevelChart.h"
+
+#define COLORED 0
+#define UNCOLORED 1
+
+#define CHART_MIN_RANGE 100  // mm, stops noise filling the chart
+
+// Level in mm to chart row, 0 is the top
+int LevelChart::toY(int32_t level) {
+  if (level <= _min) {
+    return CHART_HEIGHT - 1;
+  }
+  if (level >= _max) {
+    return 0;
+  }
+  return (CHART_HEIGHT - 1) - (int)((int64_t)(level - _min) * (CHART_HEIGHT - 1) / (_max - _min));
+}
+
+// Threshold lines, drawn as part of each column
+static void drawThresholds(Paint* paint, int x, int typicalY, int alertY) {
+  if (LEVEL_TYPICAL_HIGH && x % 2 == 0) {
+    paint->DrawPixel(x, typicalY, COLORED);
+  }
+  if (LEVEL_ALERT && x % 4 < 2) {
+    paint->DrawPixel(x, alertY, COLORED);
+  }
+}
+
+void LevelChart::drawColumn(int col, int y0, int y1) {
+  int x = col + 1;  // ROTATE_180 maps x = 0 off the canvas
+  _paint.DrawVerticalSpan(x, 0, CHART_HEIGHT - 1, UNCOLORED);
+  _paint.DrawVerticalSpan(x, y0, y1, COLORED);
+  drawThresholds(&_paint, x, toY(LEVEL_TYPICAL_HIGH), toY(LEVEL_ALERT));
+}
+
+void LevelChart::drawGap(int col) {
+  int x = col + 1;
+  _paint.DrawVerticalSpan(x, 0, CHART_HEIGHT - 1, UNCOLORED);
+  drawThresholds(&_paint, x, toY(LEVEL_TYPICAL_HIGH), toY(LEVEL_ALERT));
+}
+
+// Upload the 8 pixel wide byte column holding a chart column
+void LevelChart::uploadColumn(StripTarget* target, int col) {
+  int byteCol = (CHART_WIDTH - (col + 1)) / 8;  // ROTATE_180
+  unsigned char slice[CHART_HEIGHT];
+  for (int row = 0; row < CHART_HEIGHT; row++) {
+    slice[row] = _image[row * (CHART_WIDTH / 8) + byteCol];
+  }
+  target->writeStrip(slice, CHART_X + byteCol * 8, CHART_Y, 8, CHART_HEIGHT);
+}
+
+// Scale to the samples on screen and redraw the whole strip
+void LevelChart::draw(StripTarget* target) {
+  _paint.SetRotate(ROTATE_180);
+  _paint.Clear(UNCOLORED);
+  _col = 0;
+  _lastTime = 0;
+  if (_series && _series->count()) {
+    size_t skip = _series->count() > CHART_COLUMNS ? _series->count() - CHART_COLUMNS : 0;
+    levelCursor cursor;
+    size_t i = 0;
+
+    // Scale to fit the data and the threshold lines
+    _min = _series->lastLevel();
+    _max = _series->lastLevel();
+    _series->begin(&cursor);
+    while (_series->next(&cursor)) {
+      if (i++ >= skip) {
+        _min = cursor.level < _min ? cursor.level : _min;
+        _max = cursor.level > _max ? cursor.level : _max;
+      }
+    }
+    if (LEVEL_TYPICAL_HIGH) {
+      _min = LEVEL_TYPICAL_HIGH < _min ? LEVEL_TYPICAL_HIGH : _min;
+      _max = LEVEL_TYPICAL_HIGH > _max ? LEVEL_TYPICAL_HIGH : _max;
+    }
+    if (LEVEL_ALERT) {
+      _max = LEVEL_ALERT > _max ? LEVEL_ALERT : _max;
+    }
+    if (_max - _min < CHART_MIN_RANGE) {
+      _max = _min + CHART_MIN_RANGE;
+    }
+    _max += (_max - _min) / 8;  // Headroom for a rise
+
+    i = 0;
+    _series->begin(&cursor);
+    while (_series->next(&cursor)) {
+      if (i++ < skip) {
+        continue;
+      }
+      int y = toY(cursor.level);
+      drawColumn(_col, _col ? _lastY : y, y);
+      _lastY = y;
+      _col++;
+    }
+    _col %= CHART_COLUMNS;
+    _lastTime = _series->lastTime();
+  }
+  target->writeStrip(_paint.GetImage(), CHART_X, CHART_Y, _paint.GetWidth(), _paint.GetHeight());
+}
+
+// Plot samples newer than the last drawn at the cursor and upload only
+// the columns that changed. Returns false if a full draw() is needed.
+bool LevelChart::addLatest(StripTarget* target) {
+  if (!_series || !_lastTime) {
+    return false;
+  }
+  if (_series->lastTime() == _lastTime) {
+    return true;
+  }
+  levelCursor cursor;
+  _series->begin(&cursor);
+  while (_series->next(&cursor)) {
+    if (cursor.time <= _lastTime) {
+      continue;
+    }
+    if (cursor.level < _min || cursor.level > _max) {
+      return false;  // Off scale
+    }
+    int y = toY(cursor.level);
+    int gap = (_col + 1) % CHART_COLUMNS;
+    drawColumn(_col, _col ? _lastY : y, y);
+    drawGap(gap);
+    uploadColumn(target, _col);
+    if ((CHART_WIDTH - (gap + 1)) / 8 != (CHART_WIDTH - (_col + 1)) / 8) {
+      uploadColumn(target, gap);
+    }
+    _lastY = y;
+    _lastTime = cursor.time;
+    _col = gap;
+  }
+  return true;
+}
@@ -0,0 +1,45 @@
+#ifndef _LEVEL_CHART_H_
+#define _LEVEL_CHART_H_
+
+#include "EpdFrame.h"
+#include "epdpaint.h"
+#include "LevelSeries.h"
+#include "magnet_config.h"
+
+// Chart strip, between the "Updated" and warning text lines
+#define CHART_X 0
+#define CHART_Y 80
+#define CHART_WIDTH 120
+#define CHART_HEIGHT 24
+#define CHART_COLUMNS (CHART_WIDTH - 1)  // One sample per column
+
+// River level sparkline with dotted typical high and dashed alert lines.
+// New samples are drawn at a sweeping cursor rather than scrolling the
+// whole chart, so each sample only changes one or two byte columns.
+// Those are uploaded on their own as small partial updates.
+class LevelChart {
+public:
+  LevelChart() : _paint(_image, CHART_WIDTH, CHART_HEIGHT) {};
+  void setSeries(LevelSeries* series) { _series = series; }
+  bool hasSeries(void) { return _series != NULL; }
+  void draw(StripTarget* target);
+  bool addLatest(StripTarget* target);
+  const unsigned char* image(void) { return _image; }  // As drawn, uploaded or not
+
+private:
+  unsigned char _image[CHART_WIDTH / 8 * CHART_HEIGHT];
+  Paint _paint;
+  LevelSeries* _series = NULL;
+  int32_t _min = 0;  // mm at the bottom row
+  int32_t _max = 1;  // mm at the top row
+  int _col = 0;      // Next column to draw
+  int _lastY = 0;
+  uint32_t _lastTime = 0;
+
+  int toY(int32_t level);
+  void drawColumn(int col, int y0, int y1);
+  void drawGap(int col);
+  void uploadColumn(StripTarget* target, int col);
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "LevelSeries.h"
+
+#define VARINT_MAX 5  // Bytes for a 32 bit varint
+
+static uint32_t zigzag(int32_t v) {
+  return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static size_t putVarint(uint8_t* out, uint32_t v) {
+  size_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = (v & 0x7F) | 0x80;
+    v >>= 7;
+  }
+  out[n++] = v;
+  return n;
+}
+
+void LevelSeries::clear(void) {
+  _start = 0;
+  _used = 0;
+  _count = 0;
+}
+
+size_t LevelSeries::readVarint(size_t pos, uint32_t* value) {
+  uint32_t v = 0;
+  size_t n = 0;
+  uint8_t b;
+  do {
+    b = at(pos + n);
+    v |= (uint32_t)(b & 0x7F) << (7 * n);
+    n++;
+  } while ((b & 0x80) && n < VARINT_MAX);
+  *value = v;
+  return n;
+}
+
+// Fold the oldest delta into the first sample
+void LevelSeries::dropOldest(void) {
+  if (_count <= 1) {
+    clear();
+    return;
+  }
+  uint32_t minutes, change;
+  size_t n = readVarint(0, &minutes);
+  n += readVarint(n, &change);
+  _firstTime += minutes * 60;
+  _firstLevel += unzigzag(change);
+  _start = (_start + n) % LEVEL_SERIES_LEN;
+  _used -= n;
+  _count--;
+}
+
+bool LevelSeries::append(uint32_t time, int32_t level) {
+  if (_count == 0) {
+    _firstTime = _lastTime = time;
+    _firstLevel = _lastLevel = level;
+    _count = 1;
+    return true;
+  }
+  if (time <= _lastTime) {
+    return false;
+  }
+  uint8_t rec[2 * VARINT_MAX];
+  size_t n = putVarint(rec, (time - _lastTime) / 60);
+  n += putVarint(rec + n, zigzag(level - _lastLevel));
+  while (_used + n > LEVEL_SERIES_LEN) {
+    dropOldest();
+  }
+  for (size_t i = 0; i < n; i++) {
+    _buf[(_start + _used + i) % LEVEL_SERIES_LEN] = rec[i];
+  }
+  _used += n;
+  _count++;
+  // Keep whole minutes so decoded times match what was stored
+  _lastTime += (time - _lastTime) / 60 * 60;
+  _lastLevel = level;
+  return true;
+}
+
+void LevelSeries::begin(levelCursor* cursor) {
+  cursor->pos = 0;
+  cursor->time = _firstTime;
+  cursor->level = _firstLevel;
+  cursor->first = true;
+}
+
+bool LevelSeries::next(levelCursor* cursor) {
+  if (_count == 0) {
+    return false;
+  }
+  if (cursor->first) {
+    cursor->first = false;
+    return true;
+  }
+  if (cursor->pos >= _used) {
+    return false;
+  }
+  uint32_t minutes, change;
+  cursor->pos += readVarint(cursor->pos, &minutes);
+  cursor->pos += readVarint(cursor->pos, &change);
+  cursor->time += minutes * 60;
+  cursor->level += unzigzag(change);
+  return true;
+}
@@ -0,0 +1,52 @@
+#ifndef _LEVEL_SERIES_H_
+#define _LEVEL_SERIES_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Fixed capacity time series of river level readings.
+// The oldest sample is held in full, each later sample is stored as
+// varint encoded deltas from the one before: minutes since the last
+// reading, then the zigzag change in level in mm. A steady 15 minute
+// series costs about 2 bytes per sample. When the buffer is full the
+// oldest samples are dropped to make room.
+
+#define LEVEL_SERIES_LEN 1024  // ~500 samples, 5 days at 15 min
+
+struct levelCursor {
+  size_t pos;       // Bytes read from the start of the ring
+  uint32_t time;    // Seconds since 1970 UTC
+  int32_t level;    // mm
+  bool first;
+};
+
+class LevelSeries {
+public:
+  void clear(void);
+  // Append a newer sample, false if older than the last one
+  bool append(uint32_t time, int32_t level);
+  size_t count(void) { return _count; }
+  size_t bytesUsed(void) { return _used; }
+  uint32_t lastTime(void) { return _lastTime; }
+  int32_t lastLevel(void) { return _lastLevel; }
+
+  // Iterate oldest to newest
+  void begin(levelCursor* cursor);
+  bool next(levelCursor* cursor);
+
+private:
+  uint8_t _buf[LEVEL_SERIES_LEN];
+  size_t _start = 0;  // Ring offset of the oldest delta
+  size_t _used = 0;   // Bytes of deltas held
+  size_t _count = 0;  // Samples held, including the oldest
+  uint32_t _firstTime = 0;
+  int32_t _firstLevel = 0;
+  uint32_t _lastTime = 0;
+  int32_t _lastLevel = 0;
+
+  uint8_t at(size_t pos) { return _buf[(_start + pos) % LEVEL_SERIES_LEN]; }
+  size_t readVarint(size_t pos, uint32_t* value);
+  void dropOldest(void);
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include "LevelTrend.h"
+
+void LevelTrend::reset(void) {
+  _level = 0;
+  _slope = 0;
+  _time = 0;
+  _samples = 0;
+}
+
+void LevelTrend::update(uint32_t time, int32_t level) {
+  int32_t x = level << TREND_SHIFT;
+  if (_samples == 0 || time - _time > TREND_MAX_GAP) {
+    _level = x;
+    _slope = 0;
+    _time = time;
+    _samples = 1;
+    return;
+  }
+  if (time <= _time) {
+    return;
+  }
+  int32_t dt = time - _time;
+  int32_t predicted = _level + (int32_t)((int64_t)_slope * dt / 3600);
+  int32_t smoothed = predicted + ((x - predicted) >> TREND_LEVEL_GAIN);
+  int32_t observed = (int32_t)((int64_t)(smoothed - _level) * 3600 / dt);
+  _slope += (observed - _slope) >> TREND_SLOPE_GAIN;
+  _level = smoothed;
+  _time = time;
+  if (_samples < TREND_MIN_SAMPLES) {
+    _samples++;
+  }
+}
+
+bool LevelTrend::timeTo(int32_t threshold, int32_t minRate, uint32_t* secs) {
+  if (!ready() || _slope <= 0 || rate() < minRate) {
+    return false;
+  }
+  int32_t remaining = (threshold << TREND_SHIFT) - _level;
+  *secs = remaining > 0 ? (uint32_t)((int64_t)remaining * 3600 / _slope) : 0;
+  return true;
+}
@@ -0,0 +1,35 @@
+#ifndef _LEVEL_TREND_H_
+#define _LEVEL_TREND_H_
+
+#include <stdint.h>
+
+// Rate of rise estimator for river level readings.
+// Holt's double exponential smoothing of the level and its slope, in
+// fixed point as the SAMD21 has no FPU. Each sample costs a handful of
+// integer operations and no history is kept.
+
+#define TREND_SHIFT 8          // Q8 fixed point
+#define TREND_LEVEL_GAIN 2     // Level smoothing, alpha = 1/4
+#define TREND_SLOPE_GAIN 3     // Slope smoothing, beta = 1/8
+#define TREND_MIN_SAMPLES 4    // Samples before the slope is trusted
+#define TREND_MAX_GAP 6 * 60 * 60UL  // Restart after a longer gap, in seconds
+
+class LevelTrend {
+public:
+  void reset(void);
+  void update(uint32_t time, int32_t level);
+  bool ready(void) { return _samples >= TREND_MIN_SAMPLES; }
+  int32_t level(void) { return _level >> TREND_SHIFT; }  // Smoothed, mm
+  int32_t rate(void) { return _slope >> TREND_SHIFT; }   // mm per hour
+  // Seconds until the smoothed level reaches threshold, 0 if already
+  // there. False if the level is not rising at least minRate mm/hour.
+  bool timeTo(int32_t threshold, int32_t minRate, uint32_t* secs);
+
+private:
+  int32_t _level = 0;  // mm, Q8
+  int32_t _slope = 0;  // mm per hour, Q8
+  uint32_t _time = 0;
+  uint16_t _samples = 0;
+};
+
+#endif
@@ -0,0 +1,25 @@
+#include "RefreshPolicy.h"
+
+// Whether the next screen of this severity should be a full refresh
+bool RefreshPolicy::fullDue(int severity, unsigned long now) {
+  return _severity < 0 || severity != _severity || _partials >= _maxPartials || _area >= _maxArea
+         || now - _lastUpdate >= _idleMs;
+}
+
+void RefreshPolicy::fullDone(int severity, unsigned long now) {
+  _severity = severity;
+  _lastUpdate = now;
+  _partials = 0;
+  _area = 0;
+  _fullRefreshes++;
+}
+
+// Count a partial update that rewrote area pixels
+void RefreshPolicy::partialDone(uint32_t area, unsigned long now) {
+  _lastUpdate = now;
+  if (_partials < 0xFFFF) {
+    _partials++;
+  }
+  _area = area > 0xFFFFFFFFUL - _area ? 0xFFFFFFFFUL : _area + area;
+  _partialRefreshes++;
+}
@@ -0,0 +1,49 @@
+#include "SeverityFilter.h"
+
+void SeverityFilter::reset(warning_levels level) {
+  _level = level;
+  _pending = level;
+  _count = 0;
+  _failures = 0;
+}
+
+// Returns the filtered level after a successful reading
+warning_levels SeverityFilter::update(warning_levels reading, unsigned long now) {
+  _failures = 0;
+  if (reading == _level) {
+    _pending = _level;
+    _count = 0;
+    return _level;
+  }
+  if (_level == INIT || severityRank[reading] > severityRank[_level]) {
+    reset(reading);
+    return _level;
+  }
+  if (reading != _pending) {
+    _pending = reading;
+    _count = 0;
+    _pendingSince = now;
+  }
+  _count++;
+  if (_count >= _readings || now - _pendingSince >= _holdMs) {
+    reset(reading);
+  }
+  return _level;
+}
+
+// Count a failed or unparseable reading, the level is held
+void SeverityFilter::failed(void) {
+  if (_failures < 255) {
+    _failures++;
+  }
+}
+
+// The source is there but has nothing new, not a reading. The level and
+// any pending downgrade are left alone, the data is no longer stale.
+void SeverityFilter::heard(void) {
+  _failures = 0;
+}
+
+bool SeverityFilter::stale(void) {
+  return _failures >= _staleFailures;
+}
@@ -0,0 +1,32 @@
+#ifndef _SEVERITY_FILTER_H_
+#define _SEVERITY_FILTER_H_
+
+#include "FloodStates.h"
+
+// Debounces API severity readings before they reach updateState().
+// Higher severities are accepted at once. Downgrades, and moves between
+// levels of equal rank, need a number of consistent readings or a hold
+// time, so a flapping feed doesn't cycle the display and buzzer.
+class SeverityFilter {
+public:
+  SeverityFilter(uint8_t readings, unsigned long holdMs, uint8_t staleFailures)
+    : _readings(readings), _holdMs(holdMs), _staleFailures(staleFailures) {};
+  void reset(warning_levels level);
+  warning_levels update(warning_levels reading, unsigned long now);
+  void failed(void);
+  void heard(void);
+  bool stale(void);
+  warning_levels level(void) { return _level; }
+
+private:
+  uint8_t _readings;       // Consistent readings needed to downgrade
+  unsigned long _holdMs;   // Or time since the first of them
+  uint8_t _staleFailures;  // Consecutive failures before data is stale
+  warning_levels _level = INIT;
+  warning_levels _pending = INIT;
+  uint8_t _count = 0;
+  unsigned long _pendingSince = 0;
+  uint8_t _failures = 0;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include <string.h>
+#include "WarningScan.h"
+
+void WarningScanner::begin(void) {
+  *this = WarningScanner();
+}
+
+void WarningScanner::feed(const char* data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    feedChar(data[i]);
+  }
+}
+
+void WarningScanner::feedChar(char c) {
+  if (_inString) {
+    if (_escape) {
+      _escape = false;
+    } else if (c == '\\') {
+      _escape = true;
+      return;
+    } else if (c == '"') {
+      endString();
+      return;
+    }
+    if (_len < sizeof(_str) - 1) {
+      _str[_len++] = c;
+    }
+    return;
+  }
+  if (_inNumber) {
+    if (c >= '0' && c <= '9') {
+      _number = _number < 100000 ? _number * 10 + (c - '0') : _number;
+      return;
+    }
+    endNumber();
+  }
+
+  switch (c) {
+    case '"':
+      _inString = true;
+      _len = 0;
+      break;
+    case ':':
+      _value = true;
+      break;
+    case ',':
+      _value = false;  // After true, false or null
+      break;
+    case '{':
+    case '[':
+      _depth++;
+      if (c == '{' && _value && !_warningDepth && strcmp(_key, "currentWarning") == 0) {
+        _warningDepth = _depth;
+      }
+      _value = false;
+      break;
+    case '}':
+    case ']':
+      if (_depth == _warningDepth) {
+        _warningDepth = 0;
+      }
+      if (_depth && --_depth == 0) {
+        _complete = true;
+      }
+      break;
+    default:
+      if (_value && (c == '-' || (c >= '0' && c <= '9'))) {
+        _inNumber = true;
+        _neg = (c == '-');
+        _number = _neg ? 0 : c - '0';
+      }
+      break;
+  }
+}
+
+void WarningScanner::endString(void) {
+  _inString = false;
+  _str[_len] = '\0';
+  if (!_value) {
+    strncpy(_key, _str, sizeof(_key) - 1);
+    _key[sizeof(_key) - 1] = '\0';
+    return;
+  }
+  _value = false;
+  if (!_warningDepth || _depth != _warningDepth) {
+    return;
+  }
+  if (strcmp(_key, "floodAreaID") == 0) {
+    strcpy(_areaId, _str);
+  } else if (strcmp(_key, "timeRaised") == 0) {
+    strcpy(_timeRaised, _str);
+  }
+}
+
+void WarningScanner::endNumber(void) {
+  _inNumber = false;
+  _value = false;
+  if (_warningDepth && _depth == _warningDepth && strcmp(_key, "severityLevel") == 0) {
+    _severity = _neg ? -_number : _number;
+  }
+}
@@ -0,0 +1,50 @@
+#ifndef _WARNING_SCAN_H_
+#define _WARNING_SCAN_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define WARNING_VALUE_LEN 24  // Strings kept, "2022-12-19T15:20:31" or an area ID
+
+// Streaming scan of a floodAreas/{id} response for its current warning.
+//
+// The body is fed through in chunks of any size as it arrives and never
+// held, so the fetch needs no document buffer. Only severityLevel,
+// floodAreaID and timeRaised directly inside the "currentWarning"
+// object are kept, the same fields the ArduinoJson filter picked out.
+// No currentWarning means no warning in force.
+
+class WarningScanner {
+public:
+  void begin(void);
+  void feed(const char* data, size_t len);
+  bool complete(void) { return _complete; }  // Whole top level object seen
+  int severity(void) { return _severity; }   // 0 if there is no warning
+  const char* areaId(void) { return _areaId[0] ? _areaId : NULL; }
+  const char* timeRaised(void) { return _timeRaised; }
+
+private:
+  bool _complete;
+  int _severity;
+  char _areaId[WARNING_VALUE_LEN];
+  char _timeRaised[WARNING_VALUE_LEN];
+
+  // Tokeniser
+  bool _inString;
+  bool _escape;
+  bool _value;          // After a ':', the next string or number is a value
+  uint8_t _len;
+  char _str[WARNING_VALUE_LEN];  // String being read, truncated
+  char _key[16];                 // Last key seen, truncated
+  uint8_t _depth;                // Object and array nesting
+  uint8_t _warningDepth;         // Of the currentWarning object, 0 outside it
+  bool _inNumber;
+  bool _neg;
+  int32_t _number;
+
+  void feedChar(char c);
+  void endString(void);
+  void endNumber(void);
+};
+
+#endif
@@ -4,23 +4,17 @@
 // Pizo buzzer
 #define BUZZER_PIN 15
 
-static void buzzer_on() {
+static inline void buzzer_on() {
   digitalWrite(BUZZER_PIN, HIGH);
 }
 
-static void buzzer_off() {
+static inline void buzzer_off() {
   digitalWrite(BUZZER_PIN, LOW);
 }
 
-static void bip() {
-  buzzer_on();
-  delay(100);
-  buzzer_off();
-}
-
-static void buzzer_init() {
+static inline void buzzer_init() {
   pinMode(BUZZER_PIN, OUTPUT);
-  bip();
+  buzzer_off();
 }
 
 #endif
\ No newline at end of file
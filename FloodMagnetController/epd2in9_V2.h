@@ -33,10 +33,61 @@
 #define EPD_WIDTH       128
 #define EPD_HEIGHT      296
 
-class Epd : EpdIf {
+// Panel geometry, the Epd template parameter with the pin map. Both
+// are constants, so loops over the panel have fixed trip counts. The 4.2" V2 has an SSD1683, which
+// takes the same commands as the 2.9"'s SSD1680.
+struct Panel2in9 {
+    static const int WIDTH = EPD_WIDTH;
+    static const int HEIGHT = EPD_HEIGHT;
+};
+
+struct Panel4in2 {
+    static const int WIDTH = 400;
+    static const int HEIGHT = 300;
+};
+
+// Partial update waveforms, see SetWaveform
+#define WAVEFORM_PARTIAL    0
+#define WAVEFORM_FAST       1   // Shorter drive for small text changes, more ghosting
+#define WAVEFORM_FULL       2   // Only for UpdateMs, full refreshes pick their own
+#define WAVEFORMS           3
+
+#define TEMPERATURE_UNKNOWN -128
+
+// Row of the panel RAM shadow not known to hold anything, see ShadowRows
+#define SHADOW_UNKNOWN      0
+
+/* WS_20_30 is tuned for 20-30 C, so full refreshes outside that use the
+   panel's own waveform instead */
+#define LUT_FIRST_PHASE     60  /* Group 0 TP[A], the main drive */
+#define WS_MIN_C            20
+#define WS_MAX_C            30
+
+struct EpdDriveScale {
+    signed char below;
+    unsigned char percent;
+};
+
+extern unsigned char _WF_PARTIAL_2IN9[159];
+extern unsigned char _WF_FAST_2IN9[159];
+extern unsigned char WS_20_30[159];
+extern const EpdDriveScale drive_scale[];
+
+// A panel's refresh, started and finished apart so several panels on
+// one bus can refresh at once, see EpdGroup
+class EpdRefresh {
 public:
-    unsigned long width;
-    unsigned long height;
+    virtual void StartFrame(void) = 0;
+    virtual void StartFrame_Partial(void) = 0;
+    virtual bool Busy(void) = 0;
+    virtual void FinishFrame(void) = 0;
+};
+
+template <class Panel, class Pins = EpdBoardPins>
+class Epd : EpdIf, public EpdRefresh {
+public:
+    static const int width = Panel::WIDTH;
+    static const int height = Panel::HEIGHT;
 
     Epd();
     ~Epd();
@@ -64,20 +115,48 @@ public:
     void ClearFrameMemory(unsigned char color);
     void DisplayFrame(void);
 	void DisplayFrame_Partial(void);
+    void StartFrame(void);
+    void StartFrame_Partial(void);
+    bool Busy(void);
+    void FinishFrame(void);
+    int  ReadTemperature(void);
+    void SetWaveform(int waveform);
+    unsigned long UpdateMs(int waveform);
+    unsigned long ShadowSavedBytes(void) { return shadow_saved; }
     void Sleep(void);
 
 private:
-    unsigned int reset_pin;
-    unsigned int dc_pin;
-    unsigned int cs_pin;
-    unsigned int busy_pin;
+    int temperature;
+    int waveform;
+    unsigned char partial_lut[159];
+    unsigned long update_ms[WAVEFORMS];
+    unsigned long update_start;
+    int update_waveform;                  /* Of the refresh started, -1 for none */
+    unsigned long shadow[2][Panel::HEIGHT];  /* Each row as last written to 0x24 and 0x26 */
+    unsigned long shadow_saved;           /* Image bytes not sent since start up */
 		
 	void SetLut(unsigned char *lut);
     void SetLut_by_host(unsigned char *lut);
     void SetMemoryArea(int x_start, int y_start, int x_end, int y_end);
     void SetMemoryPointer(int x, int y);
+    void StartUpdate(int waveform);
+    void ShadowInvalidate(void);
+    bool ShadowRows(
+        unsigned char bank,
+        const unsigned char* image_buffer,
+        bool progmem,
+        int stride,
+        int x,
+        int x_end,
+        int y,
+        int y_end,
+        int* first,
+        int* last
+    );
 };
 
+#include "epd2in9_V2_impl.h"
+
 #endif /* EPD2IN9_V2_H */
 
 /* END OF FILE */
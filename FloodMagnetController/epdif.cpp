@@ -26,7 +26,56 @@
  */
 
 #include "epdif.h"
-#include <SPI.h>
+
+#ifdef EPD_DMA
+static unsigned char dmaBuffer[EPD_DMA_BUFFER];
+
+#ifdef ARDUINO_ARCH_SAMD
+#include <Adafruit_ZeroDMA.h>
+
+static Adafruit_ZeroDMA dma;
+static DmacDescriptor* descriptor;
+static volatile bool dmaActive = false;
+static int dmaCs;
+
+/* Transfer complete interrupt, release the panel once the last byte has
+   shifted out and drop the bytes clocked in meanwhile, or the next
+   SPI.transfer() would return before its own byte is sent */
+static void dmaDone(Adafruit_ZeroDMA* dma) {
+    while (!EPD_SPI_SERCOM->SPI.INTFLAG.bit.TXC);
+    while (EPD_SPI_SERCOM->SPI.INTFLAG.bit.RXC) {
+        (void)EPD_SPI_SERCOM->SPI.DATA.reg;
+    }
+    EPD_SPI_SERCOM->SPI.STATUS.bit.BUFOVF = 1;
+    EpdIf::PinWrite(dmaCs, HIGH);
+    dmaActive = false;
+}
+
+static void dmaBegin(void) {
+    dma.setTrigger(EPD_SPI_DMAC_ID_TX);
+    dma.setAction(DMA_TRIGGER_ACTON_BEAT);
+    dma.allocate();
+    descriptor = dma.addDescriptor(dmaBuffer, (void*)&EPD_SPI_SERCOM->SPI.DATA.reg, 0, DMA_BEAT_SIZE_BYTE, true, false);
+    dma.setCallback(dmaDone);
+}
+
+static void dmaStart(int cs, const unsigned char* data, int length) {
+    dmaCs = cs;
+    dma.changeDescriptor(descriptor, (void*)data, NULL, length);
+    dmaActive = true;
+    dma.startJob();
+}
+
+static bool dmaBusy(void) {
+    return dmaActive;
+}
+#else
+/* Host builds, simulated with latency by FontTools/mockpanel.cpp */
+void dmaBegin(void);
+void dmaStart(int cs, const unsigned char* data, int length);
+bool dmaBusy(void);
+#endif
+#endif
 
 EpdIf::EpdIf() {
 };
@@ -34,31 +83,75 @@ EpdIf::EpdIf() {
 EpdIf::~EpdIf() {
 };
 
-void EpdIf::DigitalWrite(int pin, int value) {
-    digitalWrite(pin, value);
+void EpdIf::DelayMs(unsigned int delaytime) {
+    delay(delaytime);
 }
 
-int EpdIf::DigitalRead(int pin) {
-    return digitalRead(pin);
+/**
+ *  @brief: sends a block of data. With EPD_DMA it is copied to the DMA
+ *          buffer and this returns at once, so the caller may reuse its
+ *          buffer while the transfer runs. Any later call waits for it.
+ */
+void EpdIf::SpiTransferBuffer(int cs, const unsigned char* data, int length) {
+#ifdef EPD_DMA
+    if (length > 0 && length <= EPD_DMA_BUFFER) {
+        SpiWait();
+        memcpy(dmaBuffer, data, length);
+        PinWrite(cs, LOW);
+        dmaStart(cs, dmaBuffer, length);
+        return;
+    }
+#endif
+    for (int i = 0; i < length; i++) {
+        SpiTransfer(cs, data[i]);
+    }
 }
 
-void EpdIf::DelayMs(unsigned int delaytime) {
-    delay(delaytime);
+void EpdIf::SpiWaitDma(void) {
+#ifdef EPD_DMA
+    while (dmaBusy());
+#endif
 }
 
-void EpdIf::SpiTransfer(unsigned char data) {
-    digitalWrite(CS_PIN, LOW);
-    SPI.transfer(data);
-    digitalWrite(CS_PIN, HIGH);
+/**
+ *  @brief: reads data after a read command. The panel only talks back
+ *          on its data pin, so MOSI is turned round and clocked by hand,
+ *          then SPI is started again.
+ */
+void EpdIf::SpiRead(int cs, unsigned char* data, int length) {
+    SpiWait();
+    SPI.end();
+    pinMode(PIN_SPI_SCK, OUTPUT);
+    pinMode(PIN_SPI_MOSI, INPUT);
+    digitalWrite(PIN_SPI_SCK, LOW);
+    PinWrite(cs, LOW);
+    for (int i = 0; i < length; i++) {
+        data[i] = 0;
+        for (int bit = 0; bit < 8; bit++) {
+            digitalWrite(PIN_SPI_SCK, HIGH);
+            data[i] = data[i] << 1 | digitalRead(PIN_SPI_MOSI);
+            digitalWrite(PIN_SPI_SCK, LOW);
+        }
+    }
+    PinWrite(cs, HIGH);
+    SPI.begin();
+    SPI.beginTransaction(SPISettings(2000000, MSBFIRST, SPI_MODE0));
 }
 
-int EpdIf::IfInit(void) {
-    pinMode(CS_PIN, OUTPUT);
-    pinMode(RST_PIN, OUTPUT);
-    pinMode(DC_PIN, OUTPUT);
-    pinMode(BUSY_PIN, INPUT); 
+int EpdIf::IfInit(int rst, int dc, int cs, int busy) {
+    pinMode(cs, OUTPUT);
+    pinMode(rst, OUTPUT);
+    pinMode(dc, OUTPUT);
+    pinMode(busy, INPUT);
     SPI.begin();
     SPI.beginTransaction(SPISettings(2000000, MSBFIRST, SPI_MODE0));
+#ifdef EPD_DMA
+    static bool dmaReady = false;
+    if (!dmaReady) {
+        dmaBegin();
+        dmaReady = true;
+    }
+#endif
     return 0;
 }
 
@@ -36,6 +36,9 @@
 // Color inverse. 1 or 0 = set or reset a bit if set a colored pixel
 #define IF_INVERT_COLOR     1
 
+// Blank rows between wrapped lines of text
+#define LINE_SPACING        4
+
 #include "fonts.h"
 
 class Paint {
@@ -54,15 +57,28 @@ public:
     void DrawPixel(int x, int y, int colored);
     void DrawCharAt(int x, int y, char ascii_char, sFONT* font, int colored);
     void DrawStringAt(int x, int y, const char* text, sFONT* font, int colored);
+    int  CharAdvance(char ascii_char, char next_char, sFONT* font);
+    int  MeasureString(const char* text, int length, sFONT* font);
+    int  CountLines(const char* text, sFONT* font, int width);
+    int  DrawStringCentred(int x, int y, int width, const char* text, sFONT* font, int colored);
     void DrawLine(int x0, int y0, int x1, int y1, int colored);
     void DrawHorizontalLine(int x, int y, int width, int colored);
     void DrawVerticalLine(int x, int y, int height, int colored);
+    void DrawVerticalSpan(int x, int y0, int y1, int colored);
+    void DrawHorizontalSpan(int x0, int x1, int y, int colored);
     void DrawRectangle(int x0, int y0, int x1, int y1, int colored);
     void DrawFilledRectangle(int x0, int y0, int x1, int y1, int colored);
     void DrawCircle(int x, int y, int radius, int colored);
     void DrawFilledCircle(int x, int y, int radius, int colored);
 
 private:
+    void FillAbsoluteColumn(int x, int y0, int y1, int colored);
+    void FillAbsoluteRow(int y, int x0, int x1, int colored);
+    void DrawPackedCharAt(int x, int y, char ascii_char, sFONT* font, int colored);
+    const sGLYPH* PackedGlyph(char ascii_char, sFONT* font);
+    void DrawStringRun(int x, int y, const char* text, int length, sFONT* font, int colored);
+    int  WrapLine(const char* text, int width, sFONT* font, const char** next);
+
     unsigned char* image;
     int width;
     int height;
@@ -1,1765 +1,147 @@
-/**
-  ******************************************************************************
-  * @file    font16.cpp
-  * @author  MCD Application Team
-  * @version V1.0.0
-  * @date    18-February-2014
-  * @brief   This file provides text font16. 
-  ******************************************************************************
-  * @attention
-  *
-  * <h2><center>&copy; COPYRIGHT(c) 2014 STMicroelectronics</center></h2>
-  *
-  * Redistribution and use in source and binary forms, with or without modification,
-  * are permitted provided that the following conditions are met:
-  *   1. Redistributions of source code must retain the above copyright notice,
-  *      this list of conditions and the following disclaimer.
-  *   2. Redistributions in binary form must reproduce the above copyright notice,
-  *      this list of conditions and the following disclaimer in the documentation
-  *      and/or other materials provided with the distribution.
-  *   3. Neither the name of STMicroelectronics nor the names of its contributors
-  *      may be used to endorse or promote products derived from this software
-  *      without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
-  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
-  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
-  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
-  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
-  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
-  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
-  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
-  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  ******************************************************************************
-  */
+// Generated by FontTools/fontpack from font16.cpp, do not edit.
+// Subset of the characters used by the sketch, see fonts.h for the format.
 
-/* Includes ------------------------------------------------------------------*/
 #include "fonts.h"
 #include <avr/pgmspace.h>
 
-// 
-//  Font data for Courier New 12pt
-// 
-
-const uint8_t Font16_Table[] PROGMEM = 
-{
-	// @0 ' ' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @32 '!' (11 pixels wide)
-	0x00, 0x00, //            
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x00, 0x00, //            
-	0x0C, 0x00, //     ##     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @64 '"' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1D, 0xC0, //    ### ### 
-	0x1D, 0xC0, //    ### ### 
-	0x08, 0x80, //     #   #  
-	0x08, 0x80, //     #   #  
-	0x08, 0x80, //     #   #  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @96 '#' (11 pixels wide)
-	0x00, 0x00, //            
-	0x0D, 0x80, //     ## ##  
-	0x0D, 0x80, //     ## ##  
-	0x0D, 0x80, //     ## ##  
-	0x0D, 0x80, //     ## ##  
-	0x3F, 0xC0, //   ######## 
-	0x1B, 0x00, //    ## ##   
-	0x3F, 0xC0, //   ######## 
-	0x1B, 0x00, //    ## ##   
-	0x1B, 0x00, //    ## ##   
-	0x1B, 0x00, //    ## ##   
-	0x1B, 0x00, //    ## ##   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @128 '$' (11 pixels wide)
-	0x04, 0x00, //      #     
-	0x1F, 0x80, //    ######  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x38, 0x00, //   ###      
-	0x1E, 0x00, //    ####    
-	0x0F, 0x00, //     ####   
-	0x03, 0x80, //       ###  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x3F, 0x00, //   ######   
-	0x04, 0x00, //      #     
-	0x04, 0x00, //      #     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @160 '%' (11 pixels wide)
-	0x00, 0x00, //            
-	0x18, 0x00, //    ##      
-	0x24, 0x00, //   #  #     
-	0x24, 0x00, //   #  #     
-	0x18, 0xC0, //    ##   ## 
-	0x07, 0x80, //      ####  
-	0x1E, 0x00, //    ####    
-	0x31, 0x80, //   ##   ##  
-	0x02, 0x40, //       #  # 
-	0x02, 0x40, //       #  # 
-	0x01, 0x80, //        ##  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @192 '&' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x0F, 0x00, //     ####   
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x0C, 0x00, //     ##     
-	0x1D, 0x80, //    ### ##  
-	0x37, 0x00, //   ## ###   
-	0x33, 0x00, //   ##  ##   
-	0x1D, 0x80, //    ### ##  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @224 ''' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x07, 0x00, //      ###   
-	0x07, 0x00, //      ###   
-	0x02, 0x00, //       #    
-	0x02, 0x00, //       #    
-	0x02, 0x00, //       #    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @256 '(' (11 pixels wide)
-	0x00, 0x00, //            
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x06, 0x00, //      ##    
-	0x0E, 0x00, //     ###    
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0E, 0x00, //     ###    
-	0x06, 0x00, //      ##    
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @288 ')' (11 pixels wide)
-	0x00, 0x00, //            
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x0C, 0x00, //     ##     
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x0C, 0x00, //     ##     
-	0x1C, 0x00, //    ###     
-	0x18, 0x00, //    ##      
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @320 '*' (11 pixels wide)
-	0x00, 0x00, //            
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x3F, 0xC0, //   ######## 
-	0x3F, 0xC0, //   ######## 
-	0x0F, 0x00, //     ####   
-	0x1F, 0x80, //    ######  
-	0x19, 0x80, //    ##  ##  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @352 '+' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x04, 0x00, //      #     
-	0x04, 0x00, //      #     
-	0x04, 0x00, //      #     
-	0x3F, 0x80, //   #######  
-	0x04, 0x00, //      #     
-	0x04, 0x00, //      #     
-	0x04, 0x00, //      #     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @384 ',' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x06, 0x00, //      ##    
-	0x04, 0x00, //      #     
-	0x0C, 0x00, //     ##     
-	0x08, 0x00, //     #      
-	0x08, 0x00, //     #      
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @416 '-' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x3F, 0x80, //   #######  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @448 '.' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @480 '/' (11 pixels wide)
-	0x00, 0xC0, //         ## 
-	0x00, 0xC0, //         ## 
-	0x01, 0x80, //        ##  
-	0x01, 0x80, //        ##  
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x06, 0x00, //      ##    
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x30, 0x00, //   ##       
-	0x30, 0x00, //   ##       
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @512 '0' (11 pixels wide)
-	0x00, 0x00, //            
-	0x0E, 0x00, //     ###    
-	0x1B, 0x00, //    ## ##   
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x1B, 0x00, //    ## ##   
-	0x0E, 0x00, //     ###    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @544 '1' (11 pixels wide)
-	0x00, 0x00, //            
-	0x06, 0x00, //      ##    
-	0x3E, 0x00, //   #####    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x3F, 0xC0, //   ######## 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @576 '2' (11 pixels wide)
-	0x00, 0x00, //            
-	0x0F, 0x00, //     ####   
-	0x19, 0x80, //    ##  ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x03, 0x00, //       ##   
-	0x06, 0x00, //      ##    
-	0x0C, 0x00, //     ##     
-	0x18, 0x00, //    ##      
-	0x30, 0x00, //   ##       
-	0x3F, 0x80, //   #######  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @608 '3' (11 pixels wide)
-	0x00, 0x00, //            
-	0x3F, 0x00, //   ######   
-	0x61, 0x80, //  ##    ##  
-	0x01, 0x80, //        ##  
-	0x03, 0x00, //       ##   
-	0x1F, 0x00, //    #####   
-	0x03, 0x80, //       ###  
-	0x01, 0x80, //        ##  
-	0x01, 0x80, //        ##  
-	0x61, 0x80, //  ##    ##  
-	0x3F, 0x00, //   ######   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @640 '4' (11 pixels wide)
-	0x00, 0x00, //            
-	0x07, 0x00, //      ###   
-	0x07, 0x00, //      ###   
-	0x0F, 0x00, //     ####   
-	0x0B, 0x00, //     # ##   
-	0x1B, 0x00, //    ## ##   
-	0x13, 0x00, //    #  ##   
-	0x33, 0x00, //   ##  ##   
-	0x3F, 0x80, //   #######  
-	0x03, 0x00, //       ##   
-	0x0F, 0x80, //     #####  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @672 '5' (11 pixels wide)
-	0x00, 0x00, //            
-	0x1F, 0x80, //    ######  
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x1F, 0x00, //    #####   
-	0x11, 0x80, //    #   ##  
-	0x01, 0x80, //        ##  
-	0x01, 0x80, //        ##  
-	0x21, 0x80, //   #    ##  
-	0x1F, 0x00, //    #####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @704 '6' (11 pixels wide)
-	0x00, 0x00, //            
-	0x07, 0x80, //      ####  
-	0x1C, 0x00, //    ###     
-	0x18, 0x00, //    ##      
-	0x30, 0x00, //   ##       
-	0x37, 0x00, //   ## ###   
-	0x39, 0x80, //   ###  ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x19, 0x80, //    ##  ##  
-	0x0F, 0x00, //     ####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @736 '7' (11 pixels wide)
-	0x00, 0x00, //            
-	0x7F, 0x00, //  #######   
-	0x43, 0x00, //  #    ##   
-	0x03, 0x00, //       ##   
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @768 '8' (11 pixels wide)
-	0x00, 0x00, //            
-	0x1F, 0x00, //    #####   
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x1F, 0x00, //    #####   
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x1F, 0x00, //    #####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @800 '9' (11 pixels wide)
-	0x00, 0x00, //            
-	0x1E, 0x00, //    ####    
-	0x33, 0x00, //   ##  ##   
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x33, 0x80, //   ##  ###  
-	0x1D, 0x80, //    ### ##  
-	0x01, 0x80, //        ##  
-	0x03, 0x00, //       ##   
-	0x07, 0x00, //      ###   
-	0x3C, 0x00, //   ####     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @832 ':' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @864 ';' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x06, 0x00, //      ##    
-	0x04, 0x00, //      #     
-	0x08, 0x00, //     #      
-	0x08, 0x00, //     #      
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @896 '<' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0xC0, //         ## 
-	0x03, 0x00, //       ##   
-	0x04, 0x00, //      #     
-	0x18, 0x00, //    ##      
-	0x60, 0x00, //  ##        
-	0x18, 0x00, //    ##      
-	0x04, 0x00, //      #     
-	0x03, 0x00, //       ##   
-	0x00, 0xC0, //         ## 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @928 '=' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7F, 0xC0, //  ######### 
-	0x00, 0x00, //            
-	0x7F, 0xC0, //  ######### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @960 '>' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x60, 0x00, //  ##        
-	0x18, 0x00, //    ##      
-	0x04, 0x00, //      #     
-	0x03, 0x00, //       ##   
-	0x00, 0xC0, //         ## 
-	0x03, 0x00, //       ##   
-	0x04, 0x00, //      #     
-	0x18, 0x00, //    ##      
-	0x60, 0x00, //  ##        
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @992 '?' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1F, 0x00, //    #####   
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x01, 0x80, //        ##  
-	0x07, 0x00, //      ###   
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x00, 0x00, //            
-	0x0C, 0x00, //     ##     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1024 '@' (11 pixels wide)
-	0x00, 0x00, //            
-	0x0E, 0x00, //     ###    
-	0x11, 0x00, //    #   #   
-	0x21, 0x00, //   #    #   
-	0x21, 0x00, //   #    #   
-	0x27, 0x00, //   #  ###   
-	0x29, 0x00, //   # #  #   
-	0x29, 0x00, //   # #  #   
-	0x27, 0x00, //   #  ###   
-	0x20, 0x00, //   #        
-	0x11, 0x00, //    #   #   
-	0x0E, 0x00, //     ###    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1056 'A' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x3F, 0x00, //   ######   
-	0x0F, 0x00, //     ####   
-	0x09, 0x00, //     #  #   
-	0x19, 0x80, //    ##  ##  
-	0x19, 0x80, //    ##  ##  
-	0x1F, 0x80, //    ######  
-	0x30, 0xC0, //   ##    ## 
-	0x30, 0xC0, //   ##    ## 
-	0x79, 0xE0, //  ####  ####
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1088 'B' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7F, 0x00, //  #######   
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x3F, 0x00, //   ######   
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x7F, 0x00, //  #######   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1120 'C' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1F, 0x40, //    ##### # 
-	0x30, 0xC0, //   ##    ## 
-	0x60, 0x40, //  ##      # 
-	0x60, 0x00, //  ##        
-	0x60, 0x00, //  ##        
-	0x60, 0x00, //  ##        
-	0x60, 0x40, //  ##      # 
-	0x30, 0x80, //   ##    #  
-	0x1F, 0x00, //    #####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1152 'D' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7F, 0x00, //  #######   
-	0x31, 0x80, //   ##   ##  
-	0x30, 0xC0, //   ##    ## 
-	0x30, 0xC0, //   ##    ## 
-	0x30, 0xC0, //   ##    ## 
-	0x30, 0xC0, //   ##    ## 
-	0x30, 0xC0, //   ##    ## 
-	0x31, 0x80, //   ##   ##  
-	0x7F, 0x00, //  #######   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1184 'E' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7F, 0x80, //  ########  
-	0x30, 0x80, //   ##    #  
-	0x30, 0x80, //   ##    #  
-	0x32, 0x00, //   ##  #    
-	0x3E, 0x00, //   #####    
-	0x32, 0x00, //   ##  #    
-	0x30, 0x80, //   ##    #  
-	0x30, 0x80, //   ##    #  
-	0x7F, 0x80, //  ########  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1216 'F' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7F, 0xC0, //  ######### 
-	0x30, 0x40, //   ##     # 
-	0x30, 0x40, //   ##     # 
-	0x32, 0x00, //   ##  #    
-	0x3E, 0x00, //   #####    
-	0x32, 0x00, //   ##  #    
-	0x30, 0x00, //   ##       
-	0x30, 0x00, //   ##       
-	0x7C, 0x00, //  #####     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1248 'G' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1E, 0x80, //    #### #  
-	0x31, 0x80, //   ##   ##  
-	0x60, 0x80, //  ##     #  
-	0x60, 0x00, //  ##        
-	0x60, 0x00, //  ##        
-	0x67, 0xC0, //  ##  ##### 
-	0x61, 0x80, //  ##    ##  
-	0x31, 0x80, //   ##   ##  
-	0x1F, 0x00, //    #####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1280 'H' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7B, 0xC0, //  #### #### 
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x3F, 0x80, //   #######  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x7B, 0xC0, //  #### #### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1312 'I' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x3F, 0xC0, //   ######## 
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x3F, 0xC0, //   ######## 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1344 'J' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1F, 0xC0, //    ####### 
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x63, 0x00, //  ##   ##   
-	0x63, 0x00, //  ##   ##   
-	0x63, 0x00, //  ##   ##   
-	0x3E, 0x00, //   #####    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1376 'K' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7B, 0xC0, //  #### #### 
-	0x31, 0x80, //   ##   ##  
-	0x33, 0x00, //   ##  ##   
-	0x36, 0x00, //   ## ##    
-	0x3C, 0x00, //   ####     
-	0x3E, 0x00, //   #####    
-	0x33, 0x00, //   ##  ##   
-	0x31, 0x80, //   ##   ##  
-	0x79, 0xC0, //  ####  ### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1408 'L' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7E, 0x00, //  ######    
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x40, //    ##    # 
-	0x18, 0x40, //    ##    # 
-	0x18, 0x40, //    ##    # 
-	0x7F, 0xC0, //  ######### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1440 'M' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0xE0, 0xE0, // ###     ###
-	0x60, 0xC0, //  ##     ## 
-	0x71, 0xC0, //  ###   ### 
-	0x7B, 0xC0, //  #### #### 
-	0x6A, 0xC0, //  ## # # ## 
-	0x6E, 0xC0, //  ## ### ## 
-	0x64, 0xC0, //  ##  #  ## 
-	0x60, 0xC0, //  ##     ## 
-	0xFB, 0xE0, // ##### #####
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1472 'N' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x73, 0xC0, //  ###  #### 
-	0x31, 0x80, //   ##   ##  
-	0x39, 0x80, //   ###  ##  
-	0x3D, 0x80, //   #### ##  
-	0x35, 0x80, //   ## # ##  
-	0x37, 0x80, //   ## ####  
-	0x33, 0x80, //   ##  ###  
-	0x31, 0x80, //   ##   ##  
-	0x79, 0x80, //  ####  ##  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1504 'O' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1F, 0x00, //    #####   
-	0x31, 0x80, //   ##   ##  
-	0x60, 0xC0, //  ##     ## 
-	0x60, 0xC0, //  ##     ## 
-	0x60, 0xC0, //  ##     ## 
-	0x60, 0xC0, //  ##     ## 
-	0x60, 0xC0, //  ##     ## 
-	0x31, 0x80, //   ##   ##  
-	0x1F, 0x00, //    #####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1536 'P' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7F, 0x00, //  #######   
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x3F, 0x00, //   ######   
-	0x30, 0x00, //   ##       
-	0x30, 0x00, //   ##       
-	0x7E, 0x00, //  ######    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1568 'Q' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1F, 0x00, //    #####   
-	0x31, 0x80, //   ##   ##  
-	0x60, 0xC0, //  ##     ## 
-	0x60, 0xC0, //  ##     ## 
-	0x60, 0xC0, //  ##     ## 
-	0x60, 0xC0, //  ##     ## 
-	0x60, 0xC0, //  ##     ## 
-	0x31, 0x80, //   ##   ##  
-	0x1F, 0x00, //    #####   
-	0x0C, 0xC0, //     ##  ## 
-	0x1F, 0x80, //    ######  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1600 'R' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7F, 0x00, //  #######   
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x3E, 0x00, //   #####    
-	0x33, 0x00, //   ##  ##   
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x7C, 0xE0, //  #####  ###
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1632 'S' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1F, 0x80, //    ######  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x38, 0x00, //   ###      
-	0x1F, 0x00, //    #####   
-	0x03, 0x80, //       ###  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x3F, 0x00, //   ######   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1664 'T' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7F, 0x80, //  ########  
-	0x4C, 0x80, //  #  ##  #  
-	0x4C, 0x80, //  #  ##  #  
-	0x4C, 0x80, //  #  ##  #  
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x3F, 0x00, //   ######   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1696 'U' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7B, 0xC0, //  #### #### 
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x1F, 0x00, //    #####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1728 'V' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7B, 0xC0, //  #### #### 
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x1B, 0x00, //    ## ##   
-	0x1B, 0x00, //    ## ##   
-	0x1B, 0x00, //    ## ##   
-	0x0A, 0x00, //     # #    
-	0x0E, 0x00, //     ###    
-	0x0E, 0x00, //     ###    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1760 'W' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0xFB, 0xE0, // ##### #####
-	0x60, 0xC0, //  ##     ## 
-	0x64, 0xC0, //  ##  #  ## 
-	0x6E, 0xC0, //  ## ### ## 
-	0x6E, 0xC0, //  ## ### ## 
-	0x2A, 0x80, //   # # # #  
-	0x3B, 0x80, //   ### ###  
-	0x3B, 0x80, //   ### ###  
-	0x31, 0x80, //   ##   ##  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1792 'X' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7B, 0xC0, //  #### #### 
-	0x31, 0x80, //   ##   ##  
-	0x1B, 0x00, //    ## ##   
-	0x0E, 0x00, //     ###    
-	0x0E, 0x00, //     ###    
-	0x0E, 0x00, //     ###    
-	0x1B, 0x00, //    ## ##   
-	0x31, 0x80, //   ##   ##  
-	0x7B, 0xC0, //  #### #### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1824 'Y' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x79, 0xE0, //  ####  ####
-	0x30, 0xC0, //   ##    ## 
-	0x19, 0x80, //    ##  ##  
-	0x0F, 0x00, //     ####   
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x1F, 0x80, //    ######  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1856 'Z' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x3F, 0x80, //   #######  
-	0x21, 0x80, //   #    ##  
-	0x23, 0x00, //   #   ##   
-	0x06, 0x00, //      ##    
-	0x04, 0x00, //      #     
-	0x0C, 0x00, //     ##     
-	0x18, 0x80, //    ##   #  
-	0x30, 0x80, //   ##    #  
-	0x3F, 0x80, //   #######  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1888 '[' (11 pixels wide)
-	0x00, 0x00, //            
-	0x07, 0x80, //      ####  
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x07, 0x80, //      ####  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1920 '\' (11 pixels wide)
-	0x30, 0x00, //   ##       
-	0x30, 0x00, //   ##       
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x06, 0x00, //      ##    
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x01, 0x80, //        ##  
-	0x01, 0x80, //        ##  
-	0x00, 0xC0, //         ## 
-	0x00, 0xC0, //         ## 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1952 ']' (11 pixels wide)
-	0x00, 0x00, //            
-	0x1E, 0x00, //    ####    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x1E, 0x00, //    ####    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @1984 '^' (11 pixels wide)
-	0x04, 0x00, //      #     
-	0x0A, 0x00, //     # #    
-	0x0A, 0x00, //     # #    
-	0x11, 0x00, //    #   #   
-	0x20, 0x80, //   #     #  
-	0x20, 0x80, //   #     #  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2016 '_' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0xFF, 0xE0, // ###########
-
-	// @2048 '`' (11 pixels wide)
-	0x08, 0x00, //     #      
-	0x04, 0x00, //      #     
-	0x02, 0x00, //       #    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2080 'a' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1F, 0x00, //    #####   
-	0x01, 0x80, //        ##  
-	0x01, 0x80, //        ##  
-	0x1F, 0x80, //    ######  
-	0x31, 0x80, //   ##   ##  
-	0x33, 0x80, //   ##  ###  
-	0x1D, 0xC0, //    ### ### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2112 'b' (11 pixels wide)
-	0x00, 0x00, //            
-	0x70, 0x00, //  ###       
-	0x30, 0x00, //   ##       
-	0x30, 0x00, //   ##       
-	0x37, 0x00, //   ## ###   
-	0x39, 0x80, //   ###  ##  
-	0x30, 0xC0, //   ##    ## 
-	0x30, 0xC0, //   ##    ## 
-	0x30, 0xC0, //   ##    ## 
-	0x39, 0x80, //   ###  ##  
-	0x77, 0x00, //  ### ###   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2144 'c' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1E, 0x80, //    #### #  
-	0x31, 0x80, //   ##   ##  
-	0x60, 0x80, //  ##     #  
-	0x60, 0x00, //  ##        
-	0x60, 0x80, //  ##     #  
-	0x31, 0x80, //   ##   ##  
-	0x1F, 0x00, //    #####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2176 'd' (11 pixels wide)
-	0x00, 0x00, //            
-	0x03, 0x80, //       ###  
-	0x01, 0x80, //        ##  
-	0x01, 0x80, //        ##  
-	0x1D, 0x80, //    ### ##  
-	0x33, 0x80, //   ##  ###  
-	0x61, 0x80, //  ##    ##  
-	0x61, 0x80, //  ##    ##  
-	0x61, 0x80, //  ##    ##  
-	0x33, 0x80, //   ##  ###  
-	0x1D, 0xC0, //    ### ### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2208 'e' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1F, 0x00, //    #####   
-	0x31, 0x80, //   ##   ##  
-	0x60, 0xC0, //  ##     ## 
-	0x7F, 0xC0, //  ######### 
-	0x60, 0x00, //  ##        
-	0x30, 0xC0, //   ##    ## 
-	0x1F, 0x80, //    ######  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2240 'f' (11 pixels wide)
-	0x00, 0x00, //            
-	0x07, 0xE0, //      ######
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x3F, 0x80, //   #######  
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x3F, 0x80, //   #######  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2272 'g' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1D, 0xC0, //    ### ### 
-	0x33, 0x80, //   ##  ###  
-	0x61, 0x80, //  ##    ##  
-	0x61, 0x80, //  ##    ##  
-	0x61, 0x80, //  ##    ##  
-	0x33, 0x80, //   ##  ###  
-	0x1D, 0x80, //    ### ##  
-	0x01, 0x80, //        ##  
-	0x01, 0x80, //        ##  
-	0x1F, 0x00, //    #####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2304 'h' (11 pixels wide)
-	0x00, 0x00, //            
-	0x70, 0x00, //  ###       
-	0x30, 0x00, //   ##       
-	0x30, 0x00, //   ##       
-	0x37, 0x00, //   ## ###   
-	0x39, 0x80, //   ###  ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x7B, 0xC0, //  #### #### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2336 'i' (11 pixels wide)
-	0x00, 0x00, //            
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x00, 0x00, //            
-	0x1E, 0x00, //    ####    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x3F, 0xC0, //   ######## 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2368 'j' (11 pixels wide)
-	0x00, 0x00, //            
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x00, 0x00, //            
-	0x3F, 0x00, //   ######   
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x03, 0x00, //       ##   
-	0x3E, 0x00, //   #####    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2400 'k' (11 pixels wide)
-	0x00, 0x00, //            
-	0x70, 0x00, //  ###       
-	0x30, 0x00, //   ##       
-	0x30, 0x00, //   ##       
-	0x37, 0x80, //   ## ####  
-	0x36, 0x00, //   ## ##    
-	0x3C, 0x00, //   ####     
-	0x3C, 0x00, //   ####     
-	0x36, 0x00, //   ## ##    
-	0x33, 0x00, //   ##  ##   
-	0x77, 0xC0, //  ### ##### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2432 'l' (11 pixels wide)
-	0x00, 0x00, //            
-	0x1E, 0x00, //    ####    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x3F, 0xC0, //   ######## 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2464 'm' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7F, 0x80, //  ########  
-	0x36, 0xC0, //   ## ## ## 
-	0x36, 0xC0, //   ## ## ## 
-	0x36, 0xC0, //   ## ## ## 
-	0x36, 0xC0, //   ## ## ## 
-	0x36, 0xC0, //   ## ## ## 
-	0x76, 0xE0, //  ### ## ###
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2496 'n' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x77, 0x00, //  ### ###   
-	0x39, 0x80, //   ###  ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x7B, 0xC0, //  #### #### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2528 'o' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1F, 0x00, //    #####   
-	0x31, 0x80, //   ##   ##  
-	0x60, 0xC0, //  ##     ## 
-	0x60, 0xC0, //  ##     ## 
-	0x60, 0xC0, //  ##     ## 
-	0x31, 0x80, //   ##   ##  
-	0x1F, 0x00, //    #####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2560 'p' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x77, 0x00, //  ### ###   
-	0x39, 0x80, //   ###  ##  
-	0x30, 0xC0, //   ##    ## 
-	0x30, 0xC0, //   ##    ## 
-	0x30, 0xC0, //   ##    ## 
-	0x39, 0x80, //   ###  ##  
-	0x37, 0x00, //   ## ###   
-	0x30, 0x00, //   ##       
-	0x30, 0x00, //   ##       
-	0x7C, 0x00, //  #####     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2592 'q' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1D, 0xC0, //    ### ### 
-	0x33, 0x80, //   ##  ###  
-	0x61, 0x80, //  ##    ##  
-	0x61, 0x80, //  ##    ##  
-	0x61, 0x80, //  ##    ##  
-	0x33, 0x80, //   ##  ###  
-	0x1D, 0x80, //    ### ##  
-	0x01, 0x80, //        ##  
-	0x01, 0x80, //        ##  
-	0x07, 0xC0, //      ##### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2624 'r' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7B, 0x80, //  #### ###  
-	0x1C, 0xC0, //    ###  ## 
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x7F, 0x00, //  #######   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2656 's' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x1F, 0x80, //    ######  
-	0x31, 0x80, //   ##   ##  
-	0x3C, 0x00, //   ####     
-	0x1F, 0x00, //    #####   
-	0x03, 0x80, //       ###  
-	0x31, 0x80, //   ##   ##  
-	0x3F, 0x00, //   ######   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2688 't' (11 pixels wide)
-	0x00, 0x00, //            
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x7F, 0x00, //  #######   
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x00, //    ##      
-	0x18, 0x80, //    ##   #  
-	0x0F, 0x00, //     ####   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2720 'u' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x73, 0x80, //  ###  ###  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x33, 0x80, //   ##  ###  
-	0x1D, 0xC0, //    ### ### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2752 'v' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7B, 0xC0, //  #### #### 
-	0x31, 0x80, //   ##   ##  
-	0x31, 0x80, //   ##   ##  
-	0x1B, 0x00, //    ## ##   
-	0x1B, 0x00, //    ## ##   
-	0x0E, 0x00, //     ###    
-	0x0E, 0x00, //     ###    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2784 'w' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0xF1, 0xE0, // ####   ####
-	0x60, 0xC0, //  ##     ## 
-	0x64, 0xC0, //  ##  #  ## 
-	0x6E, 0xC0, //  ## ### ## 
-	0x3B, 0x80, //   ### ###  
-	0x3B, 0x80, //   ### ###  
-	0x31, 0x80, //   ##   ##  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2816 'x' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x7B, 0xC0, //  #### #### 
-	0x1B, 0x00, //    ## ##   
-	0x0E, 0x00, //     ###    
-	0x0E, 0x00, //     ###    
-	0x0E, 0x00, //     ###    
-	0x1B, 0x00, //    ## ##   
-	0x7B, 0xC0, //  #### #### 
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2848 'y' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x79, 0xE0, //  ####  ####
-	0x30, 0xC0, //   ##    ## 
-	0x19, 0x80, //    ##  ##  
-	0x19, 0x80, //    ##  ##  
-	0x0B, 0x00, //     # ##   
-	0x0F, 0x00, //     ####   
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x0C, 0x00, //     ##     
-	0x3E, 0x00, //   #####    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2880 'z' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x3F, 0x80, //   #######  
-	0x21, 0x80, //   #    ##  
-	0x03, 0x00, //       ##   
-	0x0E, 0x00, //     ###    
-	0x18, 0x00, //    ##      
-	0x30, 0x80, //   ##    #  
-	0x3F, 0x80, //   #######  
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-
-	// @2912 '{' (11 pixels wide)
-	0x00, 0x00, //            
-	0x06, 0x00, //      ##    
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x18, 0x00, //    ##      
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x0C, 0x00, //     ##     
-	0x06, 0x00, //      ##    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
+static const uint8_t Font16_Bits[] PROGMEM = {
+   // ' '
+  0x60, 0x90, 0x90, 0x63, 0x1E, 0x78, 0xC6, 0x09, 0x09, 0x06,  // '%'
+  0x10, 0x20, 0x47, 0xF1, 0x02, 0x04, 0x00,  // '+'
+  0x6B, 0x48,  // ','
+  0xFE,  // '-'
+  0xF0,  // '.'
+  0x38, 0xDB, 0x1E, 0x3C, 0x78, 0xF1, 0xE3, 0x6C, 0x70,  // '0'
+  0x18, 0xF8, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF,  // '1'
+  0x3C, 0xCF, 0x1E, 0x30, 0xC3, 0x0C, 0x30, 0xC1, 0xFC,  // '2'
+  0x7E, 0xC3, 0x03, 0x06, 0x3E, 0x07, 0x03, 0x03, 0xC3, 0x7E,  // '3'
+  0x1C, 0x38, 0xF1, 0x66, 0xC9, 0xB3, 0x7F, 0x0C, 0x7C,  // '4'
+  0x7E, 0xC1, 0x83, 0x07, 0xC8, 0xC1, 0x83, 0x86, 0xF8,  // '5'
+  0x1E, 0xE1, 0x86, 0x0D, 0xDC, 0xF1, 0xE3, 0x66, 0x78,  // '6'
+  0xFF, 0x0C, 0x18, 0x60, 0xC1, 0x83, 0x0C, 0x18, 0x30,  // '7'
+  0x7D, 0x8F, 0x1E, 0x37, 0xD8, 0xF1, 0xE3, 0xC6, 0xF8,  // '8'
+  0x79, 0x9B, 0x1E, 0x3C, 0xEE, 0xC1, 0x86, 0x1D, 0xE0,  // '9'
+  0xF0, 0x3C,  // ':'
+  0x7E, 0x07, 0x81, 0x20, 0xCC, 0x33, 0x0F, 0xC6, 0x19, 0x86, 0xF3, 0xC0,  // 'A'
+  0x3E, 0xB0, 0xF0, 0x38, 0x0C, 0x06, 0x03, 0x02, 0xC2, 0x3E, 0x00,  // 'C'
+  0xFE, 0x31, 0x98, 0x6C, 0x36, 0x1B, 0x0D, 0x86, 0xC6, 0xFE, 0x00,  // 'D'
+  0xFF, 0x61, 0x61, 0x64, 0x7C, 0x64, 0x61, 0x61, 0xFF,  // 'E'
+  0xFF, 0xB0, 0x58, 0x2C, 0x87, 0xC3, 0x21, 0x80, 0xC0, 0xF8, 0x00,  // 'F'
+  0xFF, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF,  // 'I'
+  0x3F, 0x83, 0x01, 0x80, 0xC0, 0x66, 0x33, 0x19, 0x8C, 0x7C, 0x00,  // 'J'
+  0xE0, 0xEC, 0x19, 0xC7, 0x3D, 0xE6, 0xAC, 0xDD, 0x99, 0x33, 0x06, 0xFB, 0xE0,  // 'M'
+  0xE7, 0xB1, 0x9C, 0xCF, 0x66, 0xB3, 0x79, 0x9C, 0xC6, 0xF3, 0x00,  // 'N'
+  0x3E, 0x31, 0xB0, 0x78, 0x3C, 0x1E, 0x0F, 0x06, 0xC6, 0x3E, 0x00,  // 'O'
+  0xFE, 0x63, 0x63, 0x63, 0x63, 0x7E, 0x60, 0x60, 0xFC,  // 'P'
+  0x7F, 0x8F, 0x1F, 0x07, 0xC1, 0xF1, 0xE3, 0xFC,  // 'S'
+  0xFF, 0x99, 0x99, 0x99, 0x18, 0x18, 0x18, 0x18, 0x7E,  // 'T'
+  0xF7, 0xB1, 0x98, 0xCC, 0x66, 0x33, 0x19, 0x8C, 0xC6, 0x3E, 0x00,  // 'U'
+  0xFB, 0xEC, 0x19, 0x93, 0x37, 0x66, 0xEC, 0x55, 0x0E, 0xE1, 0xDC, 0x31, 0x80,  // 'W'
+  0x7C, 0x06, 0x06, 0x7E, 0xC6, 0xCE, 0x77,  // 'a'
+  0xE0, 0x30, 0x18, 0x0D, 0xC7, 0x33, 0x0D, 0x86, 0xC3, 0x73, 0x77, 0x00,  // 'b'
+  0x3D, 0x63, 0xC1, 0xC0, 0xC1, 0x63, 0x3E,  // 'c'
+  0x07, 0x01, 0x80, 0xC7, 0x66, 0x76, 0x1B, 0x0D, 0x86, 0x67, 0x1D, 0xC0,  // 'd'
+  0x3E, 0x31, 0xB0, 0x7F, 0xFC, 0x03, 0x0C, 0xFC,  // 'e'
+  0x1F, 0x98, 0x0C, 0x1F, 0xC3, 0x01, 0x80, 0xC0, 0x60, 0x30, 0x7F, 0x00,  // 'f'
+  0x3B, 0xB3, 0xB0, 0xD8, 0x6C, 0x33, 0x38, 0xEC, 0x06, 0x03, 0x1F, 0x00,  // 'g'
+  0xE0, 0x30, 0x18, 0x0D, 0xC7, 0x33, 0x19, 0x8C, 0xC6, 0x63, 0x7B, 0xC0,  // 'h'
+  0x18, 0x18, 0x00, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF,  // 'i'
+  0x18, 0x60, 0x3F, 0x0C, 0x30, 0xC3, 0x0C, 0x30, 0xC3, 0xF8,  // 'j'
+  0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF,  // 'l'
+  0xFF, 0x1B, 0x66, 0xD9, 0xB6, 0x6D, 0x9B, 0x6E, 0xDC,  // 'm'
+  0xEE, 0x39, 0x98, 0xCC, 0x66, 0x33, 0x1B, 0xDE,  // 'n'
+  0x3E, 0x31, 0xB0, 0x78, 0x3C, 0x1B, 0x18, 0xF8,  // 'o'
+  0xEE, 0x39, 0x98, 0x6C, 0x36, 0x1B, 0x99, 0xB8, 0xC0, 0x60, 0x7C, 0x00,  // 'p'
+  0xF7, 0x1C, 0xCC, 0x06, 0x03, 0x01, 0x83, 0xF8,  // 'r'
+  0x7F, 0x8F, 0xC3, 0xE0, 0xF8, 0xFF, 0x00,  // 's'
+  0x30, 0x30, 0x30, 0xFE, 0x30, 0x30, 0x30, 0x30, 0x31, 0x1E,  // 't'
+  0xE7, 0x31, 0x98, 0xCC, 0x66, 0x33, 0x38, 0xEE,  // 'u'
+  0xF7, 0xB1, 0x98, 0xC6, 0xC3, 0x60, 0xE0, 0x70,  // 'v'
+  0xF1, 0xEC, 0x19, 0x93, 0x37, 0x63, 0xB8, 0x77, 0x0C, 0x60,  // 'w'
+  0xF3, 0xD8, 0x63, 0x30, 0xCC, 0x16, 0x07, 0x80, 0xC0, 0x30, 0x18, 0x1F, 0x00,  // 'y'
+};
 
-	// @2944 '|' (11 pixels wide)
-	0x00, 0x00, //            
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
+static const sGLYPH Font16_Glyphs[] PROGMEM = {
+  { 0, 0, 0, 0, 0, 5 },  // ' '
+  { 0, 1, 10, 2, 8, 9 },  // '%'
+  { 10, 3, 7, 2, 7, 8 },  // '+'
+  { 17, 9, 5, 4, 3, 4 },  // ','
+  { 19, 6, 1, 2, 7, 8 },  // '-'
+  { 20, 9, 2, 4, 2, 3 },  // '.'
+  { 21, 1, 10, 2, 7, 8 },  // '0'
+  { 30, 1, 10, 2, 8, 9 },  // '1'
+  { 40, 1, 10, 2, 7, 8 },  // '2'
+  { 49, 1, 10, 1, 8, 9 },  // '3'
+  { 59, 1, 10, 2, 7, 8 },  // '4'
+  { 68, 1, 10, 2, 7, 8 },  // '5'
+  { 77, 1, 10, 2, 7, 8 },  // '6'
+  { 86, 1, 10, 1, 7, 8 },  // '7'
+  { 95, 1, 10, 2, 7, 8 },  // '8'
+  { 104, 1, 10, 2, 7, 8 },  // '9'
+  { 113, 4, 7, 4, 2, 3 },  // ':'
+  { 115, 2, 9, 1, 10, 11 },  // 'A'
+  { 127, 2, 9, 1, 9, 10 },  // 'C'
+  { 138, 2, 9, 1, 9, 10 },  // 'D'
+  { 149, 2, 9, 1, 8, 9 },  // 'E'
+  { 158, 2, 9, 1, 9, 10 },  // 'F'
+  { 169, 2, 9, 2, 8, 9 },  // 'I'
+  { 178, 2, 9, 1, 9, 10 },  // 'J'
+  { 189, 2, 9, 0, 11, 12 },  // 'M'
+  { 202, 2, 9, 1, 9, 10 },  // 'N'
+  { 213, 2, 9, 1, 9, 10 },  // 'O'
+  { 224, 2, 9, 1, 8, 9 },  // 'P'
+  { 233, 2, 9, 2, 7, 8 },  // 'S'
+  { 241, 2, 9, 1, 8, 9 },  // 'T'
+  { 250, 2, 9, 1, 9, 10 },  // 'U'
+  { 261, 2, 9, 0, 11, 12 },  // 'W'
+  { 274, 4, 7, 2, 8, 9 },  // 'a'
+  { 281, 1, 10, 1, 9, 10 },  // 'b'
+  { 293, 4, 7, 1, 8, 9 },  // 'c'
+  { 300, 1, 10, 1, 9, 10 },  // 'd'
+  { 312, 4, 7, 1, 9, 10 },  // 'e'
+  { 320, 1, 10, 2, 9, 10 },  // 'f'
+  { 332, 4, 10, 1, 9, 10 },  // 'g'
+  { 344, 1, 10, 1, 9, 10 },  // 'h'
+  { 356, 1, 10, 2, 8, 9 },  // 'i'
+  { 366, 1, 13, 2, 6, 7 },  // 'j'
+  { 376, 1, 10, 2, 8, 9 },  // 'l'
+  { 386, 4, 7, 1, 10, 11 },  // 'm'
+  { 395, 4, 7, 1, 9, 10 },  // 'n'
+  { 403, 4, 7, 1, 9, 10 },  // 'o'
+  { 411, 4, 10, 1, 9, 10 },  // 'p'
+  { 423, 4, 7, 1, 9, 10 },  // 'r'
+  { 431, 4, 7, 2, 7, 8 },  // 's'
+  { 438, 1, 10, 1, 8, 9 },  // 't'
+  { 448, 4, 7, 1, 9, 10 },  // 'u'
+  { 456, 4, 7, 1, 9, 10 },  // 'v'
+  { 464, 4, 7, 0, 11, 12 },  // 'w'
+  { 474, 4, 10, 1, 10, 11 },  // 'y'
+};
 
-	// @2976 '}' (11 pixels wide)
-	0x00, 0x00, //            
-	0x0C, 0x00, //     ##     
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x03, 0x00, //       ##   
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x06, 0x00, //      ##    
-	0x0C, 0x00, //     ##     
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
+static const uint8_t Font16_Index[] PROGMEM = {
+  0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0xFF,
+  0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x11, 0xFF, 0x12, 0x13, 0x14, 0x15, 0xFF, 0xFF, 0x16, 0x17, 0xFF, 0xFF, 0x18, 0x19, 0x1A,
+  0x1B, 0xFF, 0xFF, 0x1C, 0x1D, 0x1E, 0xFF, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0xFF, 0x2A, 0x2B, 0x2C, 0x2D,
+  0x2E, 0xFF, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x34, 0xFF, 0x35, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
 
-	// @3008 '~' (11 pixels wide)
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x18, 0x00, //    ##      
-	0x24, 0x80, //   #  #  #  
-	0x03, 0x00, //       ##   
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
-	0x00, 0x00, //            
+static const sKERN Font16_Kerns[] PROGMEM = {
+  { 'J', 'a', -1 },
+  { 'J', 'u', -1 },
+  { 'W', 'i', -1 },
+  { 'f', 'i', -1 },
+  { 'r', 'A', -1 },
+  { 'y', '.', -2 },
+  { 'y', 'J', -1 },
 };
 
+static const sPACKED Font16_Packed = { Font16_Bits, Font16_Glyphs, Font16_Index, Font16_Kerns, 7, 1 };
+
 sFONT Font16 = {
-  Font16_Table,
+  0, /* Packed, no full table */
   11, /* Width */
   16, /* Height */
+  &Font16_Packed,
 };
-
-/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
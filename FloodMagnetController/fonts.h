@@ -47,17 +47,44 @@
 /* Includes ------------------------------------------------------------------*/
 #include <stdint.h>
 
+/* Glyph in a packed font: rows top..top+rows-1 of columns left..left+cols-1,
+   each row cols bits, MSB first */
+struct sGLYPH {
+  uint16_t offset;  /* Byte offset into bits */
+  uint8_t top;
+  uint8_t rows;
+  uint8_t left;     /* Ignored by proportional fonts, which start at the pen */
+  uint8_t cols;
+  uint8_t advance;  /* Pen movement, Width unless proportional */
+};
+
+/* Spacing adjustment for a pair of characters in a proportional font */
+struct sKERN {
+  char left;
+  char right;
+  int8_t adjust;
+};
+
+/* Subset of a font with blank rows and columns trimmed, no row padding */
+struct sPACKED {
+  const uint8_t *bits;
+  const sGLYPH *glyphs;
+  const uint8_t *index;  /* ASCII - ' ' to glyph, 0xFF if not in the subset */
+  const sKERN *kerns;    /* Sorted by left then right */
+  uint8_t numKerns;
+  uint8_t proportional;
+};
+
 struct sFONT {
-  const uint8_t *table;
+  const uint8_t *table;   /* Full fixed width table, or NULL if packed */
   uint16_t Width;
   uint16_t Height;
+  const sPACKED *packed;
 };
 
-extern sFONT Font24;
-extern sFONT Font20;
+/* Packed subsets generated by FontTools/fontpack */
 extern sFONT Font16;
 extern sFONT Font12;
-extern sFONT Font8;
 
 #endif /* __FONTS_H */
  
@@ -17,37 +17,34 @@
 #define OFF 6
 
 // Common anode - 0 is on 255 is off
-static void rgb_colour(int colour) {
+// Level scales the colour down from full, 255, for breathing
+static inline void rgb_colour(int colour, int level = 255) {
   switch (colour) {
     case RED:
-      analogWrite(RGB_RED_PIN, 127);  // Half brightness
+      analogWrite(RGB_RED_PIN, 127 * level / 255);  // Half brightness
       analogWrite(RGB_GREEN_PIN, 0);
       digitalWrite(RGB_BLUE_PIN, LOW);
       break;
     case GREEN:
       analogWrite(RGB_RED_PIN, 0);
-      analogWrite(RGB_GREEN_PIN, 127);  // Half brightness
+      analogWrite(RGB_GREEN_PIN, 127 * level / 255);  // Half brightness
       digitalWrite(RGB_BLUE_PIN, LOW);
       break;
     case BLUE:
       analogWrite(RGB_RED_PIN, 0);
       analogWrite(RGB_GREEN_PIN, 0);
-      digitalWrite(RGB_BLUE_PIN, HIGH);  // Full brightness
+      digitalWrite(RGB_BLUE_PIN, level > 127 ? HIGH : LOW);  // Full brightness, on or off
       break;
     case WHITE:
-      analogWrite(RGB_RED_PIN, 255);
-      analogWrite(RGB_GREEN_PIN, 255);
-      digitalWrite(RGB_BLUE_PIN, HIGH);
-      break;
     default:  // White
-      analogWrite(RGB_RED_PIN, 255);
-      analogWrite(RGB_GREEN_PIN, 255);
-      digitalWrite(RGB_BLUE_PIN, HIGH);
+      analogWrite(RGB_RED_PIN, level);
+      analogWrite(RGB_GREEN_PIN, level);
+      digitalWrite(RGB_BLUE_PIN, level > 127 ? HIGH : LOW);
       break;
   }
 }
 
-static void led_colour(int colour) {
+static inline void led_colour(int colour) {
   switch (colour) {
     case RED:
       digitalWrite(L1_RED_PIN, HIGH);
@@ -72,30 +69,15 @@ static void led_colour(int colour) {
   }
 }
 
-static void led_init() {
+// The lamp test is a pattern, see annLampTest
+static inline void led_init() {
   pinMode(L1_RED_PIN, OUTPUT);
   pinMode(L2_AMBER_PIN, OUTPUT);
   pinMode(L3_GREEN_PIN, OUTPUT);
   pinMode(RGB_RED_PIN, OUTPUT);
   pinMode(RGB_GREEN_PIN, OUTPUT);
   pinMode(RGB_BLUE_PIN, OUTPUT);
-
-  led_colour(RED);
-  delay(500);
-  led_colour(AMBER);
-  delay(500);
-  led_colour(GREEN);
-  delay(500);
   led_colour(OFF);
-
-  rgb_colour(RED);
-  delay(500);
-  rgb_colour(GREEN);
-  delay(500);
-  rgb_colour(BLUE);
-  delay(500);
-  rgb_colour(WHITE);
-  delay(500);
 }
 
 #endif
@@ -1,3 +1,6 @@
+// WiFi, AREA_CODE and the intervals are defaults.
+// They can be changed over serial without a rebuild, see README.
+
 // Your WiFi settings
 #define SECRET_SSID "your-ssid"
 #define SECRET_PASS "your-wifi-key"
@@ -6,6 +9,59 @@
 // Flood warning for Keswick Campsite
 #define AREA_CODE "011FWFNC6KC"
 
+// Optional site location, checked against the AREA_CODE polygon at start up.
+// FloodGateway/floodlocate lists every area containing a site.
+// #define SITE_LAT 54.6013
+// #define SITE_LONG -3.1347
+
+// Optional local gateway (see FloodGateway) shared by many devices,
+// leave undefined to poll environment.data.gov.uk directly
+// #define GATEWAY_HOST "192.168.1.10"
+// #define GATEWAY_PORT 8080
+
+// Optional over the air updates from a local HTTP server, see README
+// #define OTA_HOST "192.168.1.10"
+// #define OTA_PORT 8000
+#define OTA_INTERVAL 24 * 60 * 60 * 1000UL  // Check daily
+// Key that patches are signed with, 64 hex digits from "floodpatch key".
+// Better left empty here and set over serial with "set otaKey", see README
+#define OTA_KEY ""
+
+// Optional full frame buffer in RAM (about 6 KB), the display is drawn
+// into it and only the rows that changed are sent to the panel
+// #define FULL_FRAME
+
+// Full refreshes, which flash the screen, are only done for a new
+// severity, after this many partial updates or pixels rewritten by
+// them (ghosting builds up), or when the screen has been idle this long
+#define REFRESH_MAX_PARTIALS 300
+#define REFRESH_MAX_AREA 20 * 128 * 296UL   // 20 screens
+#define REFRESH_IDLE 24 * 60 * 60 * 1000UL  // 1 day
+
+// Optional river level monitoring station, leave undefined to disable.
+// Find one near you at https://environment.data.gov.uk/flood-monitoring/id/stations?lat=y&long=x&dist=d
+// #define STATION_ID "1491TH"
+#define STATION_PARAMETER "level"          // Measure to keep, "level" or "flow"
+#define READINGS_HISTORY (24 * 60 * 60UL)  // History fetched on the first poll, in seconds
+#define READINGS_INTERVAL (15 * 60UL)      // How often the station reports, in seconds
+#define LEVEL_TYPICAL_HIGH 0               // Chart threshold lines in mm, 0 to hide
+#define LEVEL_ALERT 0
+
+// Local early warning, show Flood Alert on the indicators if the river
+// is predicted to reach LEVEL_ALERT within TREND_HORIZON
+#define TREND_HORIZON 3 * 60 * 60UL  // 3 hours, in seconds
+#define TREND_MIN_RATE 10            // mm per hour, slower rises are ignored
+// Early alerts only light the LEDs, the alarm waits for the official
+// warning. Define to sound it as well, once "make trendbench" shows no
+// false alerts over your station's recorded readings.
+// #define TREND_BUZZER
+
 // Your time intervals
 #define ALERT_INTERVAL 15 * 60 * 1000  // 15 mins
 #define DEMO_INTERVAL 10 * 1000        // 10 sec
+
+// Severity debounce - downgrades need this many consistent readings
+// or this long, escalations are shown at once
+#define DEBOUNCE_READINGS 3
+#define DEBOUNCE_TIME 30 * 60 * 1000  // 30 mins
+#define STALE_FAILURES 3              // Failed polls before data is stale
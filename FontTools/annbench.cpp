@@ -0,0 +1,223 @@
+/*
+  Annunciator pin timelines against a virtual timer
+
+  Runs the Annunciator with its tick() called as the TC3 interrupt
+  would, every ANN_TICK_MS of a virtual clock, and records every pin
+  write as an edge at its tick. Each case plays patterns the way the
+  sketch does (the lamp test, a warning coming in, a button bip over
+  the siren, the siren silenced, the wifi status breathing) and checks
+  the edges on the indicator, status and buzzer pins against the
+  timeline the pattern tables describe. The time per tick on the
+  SAMD21 is the host time scaled by CPU_SCALE, as bandbench, plus
+  PIN_WRITE_US for each pin written.
+
+  Usage: make annbench
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "Annunciator.h"
+#include "led.h"
+#include "buzzer.h"
+
+#define CPU_SCALE 60
+#define PIN_WRITE_US 1
+#define MAX_EDGES 4096
+#define PINS 22
+
+struct edge {
+  uint32_t tick;
+  uint8_t pin;
+  int16_t value;
+};
+
+static edge edges[MAX_EDGES];
+static int edgeCount;
+static int16_t pinState[PINS];
+static uint32_t now;  // Virtual clock, in ticks
+static unsigned long writes;  // Including those that change nothing
+
+void pinMode(int pin, int mode) {}
+void noInterrupts(void) {}
+void interrupts(void) {}
+
+// Only changes of level are edges
+static void record(int pin, int value) {
+  writes++;
+  if (pinState[pin] != value && edgeCount < MAX_EDGES) {
+    edges[edgeCount++] = { now, (uint8_t)pin, (int16_t)value };
+  }
+  pinState[pin] = value;
+}
+
+void digitalWrite(int pin, int value) {
+  record(pin, value);
+}
+
+void analogWrite(int pin, int value) {
+  record(pin, value);
+}
+
+static void reset(void) {
+  annunciator = Annunciator();
+  memset(pinState, 0, sizeof(pinState));
+  edgeCount = 0;
+  now = 0;
+}
+
+static void run(uint32_t ticks) {
+  for (uint32_t end = now + ticks; now < end; now++) {
+    annunciator.tick();
+  }
+}
+
+// Edges on one pin, "tick:value tick:value ..." checked in order
+static bool expect(const char* name, int pin, const uint32_t (*want)[2], int count) {
+  int n = 0;
+  bool same = true;
+  for (int i = 0; i < edgeCount; i++) {
+    if (edges[i].pin != pin) {
+      continue;
+    }
+    if (n >= count || edges[i].tick != want[n][0] || edges[i].value != (int)want[n][1]) {
+      same = false;
+    }
+    n++;
+  }
+  same = same && n == count;
+  printf("    %-12s pin %2d  %3d edges  %s\n", name, pin, n, same ? "as the table" : "DIFFERS");
+  return same;
+}
+
+#define EXPECT(name, pin, want) expect(name, pin, want, sizeof(want) / sizeof(want[0]))
+
+static int lampTest(void) {
+  printf("Lamp test\n");
+  reset();
+  annunciator.play(ANN_FEEDBACK, &annLampTest);
+  run(200);
+  static const uint32_t red[][2] = { { 0, 1 }, { 50, 0 } };
+  static const uint32_t amber[][2] = { { 50, 1 }, { 100, 0 } };
+  static const uint32_t green[][2] = { { 100, 1 }, { 150, 0 } };
+  static const uint32_t buzzer[][2] = { { 0, 1 }, { 10, 0 } };
+  int bad = !EXPECT("red", L1_RED_PIN, red) + !EXPECT("amber", L2_AMBER_PIN, amber) + !EXPECT("green", L3_GREEN_PIN, green)
+            + !EXPECT("buzzer", BUZZER_PIN, buzzer);
+  // Whole brightness at the middle of the breath
+  bool peak = false;
+  for (int i = 0; i < edgeCount; i++) {
+    peak |= edges[i].pin == RGB_RED_PIN && edges[i].tick == 75 && edges[i].value == 255;
+  }
+  printf("    %-12s peaks at tick 75 %s\n", "white", peak ? "as the table" : "DIFFERS");
+  return bad + !peak;
+}
+
+// Severe warning: the red indicator flashes 25/25 and the siren sounds
+// 50/25 forty times, then the indicator carries on alone
+static int severe(void) {
+  printf("Severe flood warning\n");
+  reset();
+  annunciator.play(ANN_SEVERITY, &annSeverity[SEVERE_FLOOD_WARNING]);
+  annunciator.play(ANN_ALARM, &annAlarm[SEVERE_FLOOD_WARNING]);
+  run(3100);
+  static uint32_t red[124][2];
+  for (int i = 0; i < 124; i++) {
+    red[i][0] = i * 25;
+    red[i][1] = !(i & 1);
+  }
+  static uint32_t buzzer[80][2];
+  for (int i = 0; i < 40; i++) {
+    buzzer[i * 2][0] = i * 75;
+    buzzer[i * 2][1] = 1;
+    buzzer[i * 2 + 1][0] = i * 75 + 50;
+    buzzer[i * 2 + 1][1] = 0;
+  }
+  return !EXPECT("red", L1_RED_PIN, red) + !EXPECT("buzzer", BUZZER_PIN, buzzer);
+}
+
+// A bip at 130 preempts the flood warning cadence (20 on, 20 off, 20
+// on, 100 off, 160 a cycle) and hands the buzzer back at 140, part way
+// through an off step. A second bip at 200 lands on an on step, which
+// carries on under it to 220.
+static int bipOverSiren(void) {
+  printf("Bip over the warning siren\n");
+  reset();
+  annunciator.play(ANN_ALARM, &annAlarm[FLOOD_WARNING]);
+  run(130);
+  annunciator.bip();
+  run(70);
+  annunciator.bip();
+  run(30);
+  static const uint32_t buzzer[][2] = { { 0, 1 }, { 20, 0 }, { 40, 1 }, { 60, 0 }, { 130, 1 }, { 140, 0 },
+                                        { 160, 1 }, { 180, 0 }, { 200, 1 }, { 220, 0 } };
+  return !EXPECT("buzzer", BUZZER_PIN, buzzer);
+}
+
+// B4 held: the siren stops at once, the indicator keeps flashing
+static int silenced(void) {
+  printf("Siren silenced by B4\n");
+  reset();
+  annunciator.play(ANN_SEVERITY, &annSeverity[FLOOD_WARNING]);
+  annunciator.play(ANN_ALARM, &annAlarm[FLOOD_WARNING]);
+  run(45);
+  annunciator.stop(ANN_ALARM);
+  run(400);
+  static const uint32_t red[][2] = { { 0, 1 }, { 100, 0 }, { 200, 1 }, { 300, 0 }, { 400, 1 } };
+  static const uint32_t buzzer[][2] = { { 0, 1 }, { 20, 0 }, { 40, 1 }, { 45, 0 } };
+  return !EXPECT("red", L1_RED_PIN, red) + !EXPECT("buzzer", BUZZER_PIN, buzzer);
+}
+
+// Connecting breathes red over 2 s, online is steady green, and the
+// status shows through the lamp test's end
+static int status(void) {
+  printf("Wifi status\n");
+  reset();
+  annunciator.play(ANN_STATUS, &annConnecting);
+  run(200);
+  int low = 255, high = 0, lowTick = -1, highTick = -1;
+  for (int i = 0; i < 200; i++) {  // Second breath, sampled every tick
+    run(1);
+    if (pinState[RGB_RED_PIN] < low) {
+      low = pinState[RGB_RED_PIN];
+      lowTick = now - 1;
+    }
+    if (pinState[RGB_RED_PIN] > high) {
+      high = pinState[RGB_RED_PIN];
+      highTick = now - 1;
+    }
+  }
+  bool breath = low == 0 && lowTick == 200 && high == 127 && highTick == 300;
+  printf("    %-12s pin %2d  dark at %d, %d at %d  %s\n", "breathing", RGB_RED_PIN, lowTick, high, highTick,
+         breath ? "as the table" : "DIFFERS");
+  annunciator.play(ANN_STATUS, &annOnline);
+  annunciator.play(ANN_FEEDBACK, &annLampTest);
+  run(200);
+  bool online = pinState[RGB_RED_PIN] == 0 && pinState[RGB_GREEN_PIN] == 127 && pinState[RGB_BLUE_PIN] == LOW;
+  printf("    %-12s green after the lamp test %s\n", "online", online ? "as the table" : "DIFFERS");
+  return !breath + !online;
+}
+
+// Busiest case, every slot playing
+static void cost(void) {
+  reset();
+  annunciator.play(ANN_SEVERITY, &annSeverity[SEVERE_FLOOD_WARNING]);
+  annunciator.play(ANN_STATUS, &annConnecting);
+  annunciator.play(ANN_ALARM, &annAlarm[SEVERE_FLOOD_WARNING]);
+  annunciator.play(ANN_FEEDBACK, &annLampTest);
+  writes = 0;
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  run(3000);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double us = ((end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3) / 3000;
+  double pinUs = writes / 3000.0 * PIN_WRITE_US;  // Per tick, as mockpanel charges a digitalWrite()
+  printf("Tick %.2f us on the SAMD21 (host %.3f us) and %.2f us in pin writes, %.3f%% of the CPU\n", us * CPU_SCALE, us,
+         pinUs, (us * CPU_SCALE + pinUs) / (ANN_TICK_MS * 10.0));
+}
+
+int main() {
+  int bad = lampTest() + severe() + bipOverSiren() + silenced() + status();
+  cost();
+  printf("%s\n", bad ? "Pin timelines DIFFER" : "Pin timelines match the pattern tables");
+  return bad ? 1 : 0;
+}
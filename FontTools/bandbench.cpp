@@ -0,0 +1,173 @@
+/*
+  Banded rendering of a display list against a frame buffer
+
+  Records the same notice board on a 2.9", a 4.2" and a 7.5" panel (an
+  icon twice, one of them off the byte grid, text, rules, a diagonal
+  and a chart) as a DisplayList and renders it in BAND_BYTES bands. The
+  banded output has to match the list rendered as one band the height
+  of the panel. Render time on the SAMD21 is the host time scaled by
+  CPU_SCALE, as dmabench. Peak RAM is the band, the list and the driver
+  against a frame buffer for the panel.
+
+  The 2.9" and 4.2" bands are also sent through the real driver into
+  mockpanel, twice, the second time finding every band already in the
+  panel RAM. The 2.9" panel RAM is checked against the render. The 7.5"
+  V2 has a UC8179, for which there is no driver here.
+
+  Usage: make bandbench
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "DisplayList.h"
+#include "mockpanel.h"
+
+#define COLORED 0
+#define UNCOLORED 1
+#define CPU_SCALE 60
+#define REPEATS 50
+#define ICON_SIZE 64
+#define SAMPLES 96
+
+// Every band into a frame in host memory
+class FrameSink : public StripTarget {
+public:
+  FrameSink(int width, int height) : _rowBytes(width / 8), _frame(new unsigned char[width / 8 * height]) {}
+  ~FrameSink() { delete[] _frame; }
+  void writeStrip(const unsigned char* image, int x, int y, int width, int height) {
+    memcpy(&_frame[y * _rowBytes + x / 8], image, width / 8 * height);
+  }
+  const unsigned char* frame(void) { return _frame; }
+
+private:
+  int _rowBytes;
+  unsigned char* _frame;
+};
+
+class NullSink : public StripTarget {
+public:
+  void writeStrip(const unsigned char*, int, int, int, int) {}
+};
+
+struct panelSize {
+  const char* name;
+  int width;
+  int height;
+};
+
+static const panelSize panels[] = {
+  { "2.9\"", 128, 296 },
+  { "4.2\"", 400, 300 },
+  { "7.5\"", 800, 480 },
+};
+
+static const char* messages[] = { "Flood", "Data stale", "API", "Error", "Updated", "Connection", "Wifi" };
+
+static unsigned char icon[ICON_SIZE / 8 * ICON_SIZE];
+static int16_t samples[SAMPLES];
+static unsigned char band[BAND_BYTES];
+
+// Ring with a cross through it, black on white
+static void makeIcon(void) {
+  for (int y = 0; y < ICON_SIZE; y++) {
+    for (int x = 0; x < ICON_SIZE; x++) {
+      int dx = x - ICON_SIZE / 2;
+      int dy = y - ICON_SIZE / 2;
+      int r = dx * dx + dy * dy;
+      bool ink = (r < 30 * 30 && r > 24 * 24) || x == y || x == ICON_SIZE - 1 - y;
+      if (!ink) {
+        icon[y * ICON_SIZE / 8 + x / 8] |= 0x80 >> (x % 8);
+      }
+    }
+  }
+  for (int i = 0; i < SAMPLES; i++) {
+    samples[i] = 1200 + (i * 37) % 90 + (i > SAMPLES / 2 ? (i - SAMPLES / 2) * 12 : 0);
+  }
+}
+
+static void record(DisplayList* list, int width, int height) {
+  list->clear();
+  list->bitmap(8, 8, ICON_SIZE, ICON_SIZE, icon);
+  list->bitmap(width - ICON_SIZE - 11, 8, ICON_SIZE, ICON_SIZE, icon);
+  list->text(84, 16, "Flood", &Font16, COLORED);
+  list->text(84, 40, "2022-12-19 15:20", &Font12, COLORED);
+  list->line(0, 80, width - 1, 80, COLORED);
+  int chartTop = height - 100;
+  for (int i = 0, y = 90; y + 16 < chartTop - 8; i++, y += 20) {
+    list->text(8 + (i % 3) * 4, y, messages[i % 7], &Font16, COLORED);
+  }
+  list->line(0, chartTop - 6, width - 1, height - 1, COLORED);
+  list->chart(8, chartTop, width - 16, 90, samples, SAMPLES, COLORED);
+}
+
+static double renderUs(DisplayList* list, int bandBytes) {
+  NullSink sink;
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    list->render(&sink, band, bandBytes);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return ((end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3) / REPEATS;
+}
+
+// The list through the driver into the mock panel, returning SPI ms
+template <class Panel>
+static double send(Epd<Panel>* epd, DisplayList* list) {
+  EpdBands<Panel> bands(epd);
+  uint64_t start = panelMicros();
+  list->render(&bands, band, BAND_BYTES);
+  return (panelMicros() - start) / 1e3;
+}
+
+template <class Panel>
+static void sendTwice(DisplayList* list, const unsigned char* frame, bool check) {
+  static Epd<Panel> epd;
+  panelPowerCycle();
+  epd.Init();
+  panelClearStats();
+  double first = send(&epd, list);
+  unsigned long firstBytes = panel.spiBytes;
+  panelClearStats();
+  double again = send(&epd, list);
+  printf("  sent %6.1f ms (%5lu SPI bytes), unchanged %4.1f ms (%lu bytes), driver %u bytes on the host", first, firstBytes, again,
+         panel.spiBytes, (unsigned)sizeof(epd));
+  if (check) {
+    printf(", panel RAM %s", memcmp(panelRam[0], frame, PANEL_BYTES) ? "DIFFERS" : "matches");
+  }
+  printf("\n");
+}
+
+int main() {
+  static DisplayList list(0, 0);
+  int bad = 0;
+  makeIcon();
+  printf("Band %d bytes, list %u bytes for up to %d items\n", BAND_BYTES, (unsigned)sizeof(list), DISPLAY_LIST_ITEMS);
+  for (const panelSize& p : panels) {
+    list = DisplayList(p.width, p.height);
+    record(&list, p.width, p.height);
+    int frameBytes = p.width / 8 * p.height;
+
+    FrameSink banded(p.width, p.height);
+    FrameSink whole(p.width, p.height);
+    unsigned char* frame = new unsigned char[frameBytes];
+    int bands = list.render(&banded, band, BAND_BYTES);
+    list.render(&whole, frame, frameBytes);
+    bool same = memcmp(banded.frame(), whole.frame(), frameBytes) == 0;
+    bad += !same;
+
+    double us = renderUs(&list, BAND_BYTES);
+    printf("%s %3dx%3d  %2d items in %2d bands, %s the full frame render, %5.1f ms on the SAMD21 (host %4.0f us)\n",
+           p.name, p.width, p.height, list.count(), bands, same ? "matches" : "DIFFERS from", us * CPU_SCALE / 1e3, us);
+    printf("  RAM %5u bytes banded (band and list) against a %5d byte frame buffer\n",
+           (unsigned)(BAND_BYTES + sizeof(list)), frameBytes);
+    if (p.width == Panel2in9::WIDTH && p.height == Panel2in9::HEIGHT) {
+      sendTwice<Panel2in9>(&list, banded.frame(), true);
+    } else if (p.width == Panel4in2::WIDTH && p.height == Panel4in2::HEIGHT) {
+      sendTwice<Panel4in2>(&list, banded.frame(), false);
+    }
+    delete[] frame;
+  }
+  return bad ? 1 : 0;
+}
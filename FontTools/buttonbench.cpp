@@ -0,0 +1,234 @@
+/*
+  Button events from bouncy edges while loop() is blocked
+
+  Plays two minutes of presses on the Magnet's six buttons into
+  ButtonEvents on a virtual clock. Every press and release bounces for
+  up to 8 ms, some presses overlap on two buttons and some B4 presses
+  are held past its 2 s hold. Each pin change calls the interrupt
+  handler begin() attached, tick() runs every ANN_TICK_MS as from the
+  annunciator's timer, and loop() takes the events off the queue every
+  millisecond except while it is blocked in a fetch or a full refresh,
+  as it is for seconds at every poll. The events have to come out one
+  for one with the presses, with no bounce getting through, and the
+  press-to-handler latency is reported. The same presses are also
+  polled from loop() with EasyButton's 35 ms debounce, which misses
+  those made while loop() is blocked.
+
+  Usage: make buttonbench
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "ButtonEvents.h"
+#include "Annunciator.h"
+
+#define SIM_US (120 * 1000000UL)
+#define STEP_US 10
+#define PRESSES 200
+#define BUTTONS 6
+#define HOLD_MS 2000
+#define POLL_DEBOUNCE_MS 35  // EasyButton's default
+#define MAX_EDGES 8192
+
+static const uint8_t pins[BUTTONS] = { 21, 20, 19, 18, 17, 16 };
+
+static uint32_t simUs;
+static int level[22];
+static void (*isr)(void);
+
+unsigned long micros(void) {
+  return simUs;
+}
+
+unsigned long millis(void) {
+  return simUs / 1000;
+}
+
+void pinMode(int pin, int mode) {}
+void noInterrupts(void) {}
+void interrupts(void) {}
+
+int digitalRead(int pin) {
+  return level[pin];
+}
+
+int digitalPinToInterrupt(int pin) {
+  return pin;
+}
+
+void attachInterrupt(int interrupt, void (*handler)(void), int mode) {
+  isr = handler;
+}
+
+struct pinEdge {
+  uint32_t us;
+  uint8_t button;
+  uint8_t level;
+};
+
+struct press {
+  uint8_t button;
+  uint32_t down;  // First edge of the press
+  uint32_t up;    // First edge of the release
+  bool held;
+};
+
+static pinEdge edges[MAX_EDGES];
+static int edgeCount;
+static press presses[PRESSES];
+static int pressCount;
+static uint32_t seed = 12345;
+
+static uint32_t rnd(uint32_t n) {
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % n;
+}
+
+// Bursts of bounces ending at the new level
+static void bounce(uint8_t button, uint32_t at, uint8_t to) {
+  uint32_t t = at;
+  int bounces = rnd(12);
+  for (int i = 0; i < bounces; i++) {
+    edges[edgeCount++] = { t, button, (uint8_t)(i & 1 ? !to : to) };
+    t += 30 + rnd(700);
+  }
+  edges[edgeCount++] = { t, button, to };
+}
+
+static int byTime(const void* a, const void* b) {
+  uint32_t x = ((const pinEdge*)a)->us;
+  uint32_t y = ((const pinEdge*)b)->us;
+  return x < y ? -1 : x > y;
+}
+
+static void script(void) {
+  uint32_t t = 500000;
+  uint32_t free[BUTTONS] = { 0 };  // When each button is next up
+  while (pressCount < PRESSES && t < SIM_US - 4000000) {
+    uint8_t button = rnd(BUTTONS);
+    uint32_t down = t > free[button] ? t : free[button];
+    uint32_t length = button == 3 && rnd(3) == 0 ? 2200000 + rnd(800000) : 40000 + rnd(400000);
+    press& p = presses[pressCount++];
+    p = { button, down, down + length, length >= HOLD_MS * 1000UL + 10000 };
+    bounce(button, p.down, LOW);
+    bounce(button, p.up, HIGH);
+    free[button] = p.up + 60000;
+    t += rnd(4) == 0 ? 20000 : 300000 + rnd(1200000);  // Some presses overlap
+  }
+  qsort(edges, edgeCount, sizeof(edges[0]), byTime);
+}
+
+// loop() is blocked for a fetch and a full refresh every 15 s
+static bool blocked(uint32_t us) {
+  uint32_t at = us % 15000000;
+  return at >= 5000000 && at < 5000000 + 2500000 + 1800000;
+}
+
+struct latency {
+  uint32_t count;
+  uint64_t sum;
+  uint32_t max;
+  void add(uint32_t us) {
+    count++;
+    sum += us;
+    max = us > max ? us : max;
+  }
+};
+
+int main() {
+  for (int i = 0; i < 22; i++) {
+    level[i] = HIGH;
+  }
+  for (int i = 0; i < BUTTONS; i++) {
+    buttons.add(pins[i], i == 3 ? HOLD_MS : 0);
+  }
+  buttons.begin();
+  script();
+
+  buttonEvent got[PRESSES * 3];
+  int gotCount = 0;
+  latency free, busy;
+  int polledPresses = 0;
+  bool polled[BUTTONS] = { false };
+  uint32_t polledChange[BUTTONS] = { 0 };
+
+  int next = 0;
+  for (simUs = 0; simUs < SIM_US; simUs += STEP_US) {
+    bool changed = false;
+    while (next < edgeCount && edges[next].us <= simUs) {
+      int pin = pins[edges[next].button];
+      changed |= level[pin] != edges[next].level;
+      level[pin] = edges[next].level;
+      next++;
+    }
+    if (changed) {
+      isr();
+    }
+    if (simUs % (ANN_TICK_MS * 1000) == 0) {
+      buttons.tick();
+    }
+    if (simUs % 1000 == 0 && !blocked(simUs)) {
+      buttonEvent event;
+      while (buttons.next(&event)) {
+        bool waited = simUs - event.queued > 1000;  // Queued while loop() was blocked
+        (waited ? busy : free).add(simUs - event.at);
+        if (gotCount < PRESSES * 3) {
+          got[gotCount++] = event;
+        }
+        buttons.handled(event);
+      }
+      // EasyButton, polled from loop()
+      for (int i = 0; i < BUTTONS; i++) {
+        bool down = level[pins[i]] == LOW;
+        if (down != polled[i] && simUs - polledChange[i] >= POLL_DEBOUNCE_MS * 1000UL) {
+          polled[i] = down;
+          polledChange[i] = simUs;
+          polledPresses += down;
+        }
+      }
+    }
+  }
+
+  // Events against the presses, button by button in order
+  int expected = 0;
+  int matched = 0;
+  int pressesInBlock = 0;
+  for (int b = 0; b < BUTTONS; b++) {
+    int g = 0;
+    for (int i = 0; i < pressCount; i++) {
+      const press& p = presses[i];
+      if (p.button != b) {
+        continue;
+      }
+      pressesInBlock += blocked(p.down) && blocked(p.up);
+      uint8_t types[3] = { BUTTON_PRESSED, BUTTON_HELD, BUTTON_RELEASED };
+      for (uint8_t type : types) {
+        if (type == BUTTON_HELD && !p.held) {
+          continue;
+        }
+        expected++;
+        while (g < gotCount && got[g].button != b) {
+          g++;
+        }
+        uint32_t at = type == BUTTON_PRESSED ? p.down : type == BUTTON_RELEASED ? p.up : p.down + HOLD_MS * 1000UL;
+        if (g < gotCount && got[g].type == type && got[g].at - at < STEP_US) {
+          matched++;
+        }
+        g++;
+      }
+    }
+  }
+  bool ok = matched == expected && gotCount == expected && buttons.dropped() == 0;
+
+  printf("%d presses (%d while loop() was blocked) with %d bouncy edges, %d events expected\n", pressCount,
+         pressesInBlock, edgeCount, expected);
+  printf("Queued   %d events, %d match the presses, %lu dropped, %d from bounces\n", gotCount, matched,
+         (unsigned long)buttons.dropped(), gotCount > matched ? gotCount - matched : 0);
+  printf("Latency  loop() free:    %4u events, mean %5.1f ms, max %6.1f ms\n", free.count,
+         free.count ? free.sum / 1e3 / free.count : 0.0, free.max / 1e3);
+  printf("         loop() blocked: %4u events, mean %5.1f ms, max %6.1f ms (queued up to %.1f ms)\n", busy.count,
+         busy.count ? busy.sum / 1e3 / busy.count : 0.0, busy.max / 1e3, buttons.waitMaxUs() / 1e3);
+  printf("Polled from loop() with EasyButton's debounce: %d of %d presses seen\n", polledPresses, pressCount);
+  printf("Events %s\n", ok ? "match the presses one for one" : "DIFFER from the presses");
+  return ok ? 0 : 1;
+}
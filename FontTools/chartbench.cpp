@@ -0,0 +1,196 @@
+/*
+  River level sparkline, incremental updates checked and timed
+
+  Loads two days of a synthetic 15 minute station record into a
+  LevelSeries, draws the LevelChart through the real e-paper driver
+  into mockpanel, then adds the next three days a reading at a time as
+  updateChart() does: addLatest(), or a full draw() when a reading goes
+  off scale. A flood crest on day four forces rescales. After every
+  update, the chart area of the panel RAM must match the chart image,
+  so no changed column is left unsent. It also checks that the column
+  after the cursor is blank.
+
+  Reports image bytes, SPI bytes and panel time per column update
+  against full chart draws. The time is virtual, as in framebench,
+  including the partial refresh. The chart's own CPU time is host time
+  scaled by CPU_SCALE.
+
+  Usage: make chartbench
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "epd2in9_V2.h"
+#include "LevelChart.h"
+#include "LevelSeries.h"
+#include "mockpanel.h"
+
+#define CPU_SCALE 60
+#define STEP (15 * 60)
+#define LOADED 2 * 96      // Readings held before the first draw
+#define ADDED 3 * 96       // Then added one at a time
+#define MAX_COLUMN_MS 400  // Column upload and partial refresh
+#define MAX_COLUMN_BYTES (2 * CHART_HEIGHT)
+#define MAX_REDRAWS 16
+
+static const uint32_t T0 = 1671463200UL;
+
+static Epd<Panel2in9> epd;
+
+// Strips straight to the panel, counting the image bytes sent
+class PanelStrips : public StripTarget {
+public:
+  unsigned long bytes = 0;
+  void writeStrip(const unsigned char* image, int x, int y, int width, int height) {
+    epd.SetFrameMemory_Partial(image, x, y, width, height);
+    bytes += width / 8 * height;
+  }
+};
+
+// Tide, with a flood crest on day four
+static int32_t gauge(int i) {
+  double hours = i * STEP / 3600.0;
+  double tide = 150 * sin(hours * 2 * M_PI / 12.42);
+  double flood = 1800 * exp(-pow((hours - 84) / 10, 2));
+  double noise = ((i * 2654435761u) >> 28) - 8;
+  return (int32_t)lround(600 + tide + flood + noise);
+}
+
+// Chart area of the current RAM bank against the chart image
+static bool panelMatches(LevelChart* chart) {
+  for (int row = 0; row < CHART_HEIGHT; row++) {
+    const uint8_t* ram = panelRam[0] + (CHART_Y + row) * PANEL_ROW_BYTES + CHART_X / 8;
+    if (memcmp(ram, chart->image() + row * (CHART_WIDTH / 8), CHART_WIDTH / 8) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Pixels set in one chart column, ROTATE_180 as LevelChart draws
+static int columnPixels(LevelChart* chart, int col) {
+  int x = CHART_WIDTH - (col + 1);  // Paint's ROTATE_180 maps x to width - x
+  int set = 0;
+  for (int row = 0; row < CHART_HEIGHT; row++) {
+    set += !(chart->image()[row * (CHART_WIDTH / 8) + x / 8] & (0x80 >> (x % 8)));
+  }
+  return set;
+}
+
+struct updateStats {
+  int updates = 0;
+  unsigned long bytes = 0;
+  unsigned long spiBytes = 0;
+  uint64_t us = 0;
+  uint64_t maxUs = 0;
+  double cpuNs = 0;
+
+  void add(unsigned long b, unsigned long spi, uint64_t t, double ns) {
+    updates++;
+    bytes += b;
+    spiBytes += spi;
+    us += t;
+    maxUs = t > maxUs ? t : maxUs;
+    cpuNs += ns;
+  }
+  void print(const char* name) {
+    if (!updates) {
+      printf("%-8s none\n", name);
+      return;
+    }
+    printf("%-8s %3d, %4lu image bytes, %5lu SPI bytes, %3.0f ms avg, %3.0f ms max, %5.1f us CPU on the SAMD21\n",
+           name, updates, bytes / updates, spiBytes / updates, us / 1e3 / updates, maxUs / 1e3,
+           cpuNs * CPU_SCALE / 1e3 / updates);
+  }
+};
+
+static double hostNs(struct timespec start, struct timespec end) {
+  return (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+}
+
+int main() {
+  static LevelSeries series;
+  static LevelChart chart;
+  PanelStrips strips;
+  series.clear();
+  chart.setSeries(&series);
+  for (int i = 0; i < LOADED; i++) {
+    series.append(T0 + i * STEP, gauge(i));
+  }
+
+  epd.Init();
+  epd.ClearFrameMemory(0xFF);
+  epd.DisplayFrame();
+  chart.draw(&strips);
+  epd.DisplayFrame_Partial();
+  int mismatches = panelMatches(&chart) ? 0 : 1;
+  int bad = 0;
+  int drawn = 0;
+  for (int col = 0; col < CHART_COLUMNS; col++) {
+    drawn += columnPixels(&chart, col) > 0;
+  }
+  if (drawn != CHART_COLUMNS) {
+    printf("FAIL %d of %d columns drawn from %d readings\n", drawn, CHART_COLUMNS, LOADED);
+    bad++;
+  }
+
+  updateStats columns, redraws;
+  int gapsSet = 0;
+  for (int i = LOADED; i < LOADED + ADDED; i++) {
+    series.append(T0 + i * STEP, gauge(i));
+    strips.bytes = 0;
+    panelClearStats();
+    uint64_t start = panelMicros();
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    bool added = chart.addLatest(&strips);
+    if (!added) {
+      chart.draw(&strips);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    epd.DisplayFrame_Partial();
+    (added ? columns : redraws).add(strips.bytes, panel.spiBytes, panelMicros() - start, hostNs(t0, t1));
+
+    if (!panelMatches(&chart)) {
+      if (!mismatches) {
+        printf("FAIL panel differs from the chart after reading %d\n", i);
+      }
+      mismatches++;
+    }
+    // The column after the cursor separates new from old
+    if (added && !LEVEL_TYPICAL_HIGH && !LEVEL_ALERT) {
+      int sweep = 0;
+      for (int col = 0; col < CHART_COLUMNS; col++) {
+        sweep += columnPixels(&chart, col) == 0;
+      }
+      gapsSet += sweep != 1;
+    }
+  }
+
+  printf("Readings %d drawn, then %d added\n", LOADED, ADDED);
+  columns.print("Columns");
+  redraws.print("Redraws");
+  if (mismatches) {
+    printf("FAIL panel RAM differed from the chart after %d updates\n", mismatches);
+    bad++;
+  }
+  if (gapsSet) {
+    printf("FAIL %d updates without exactly one blank column at the cursor\n", gapsSet);
+    bad++;
+  }
+  if (columns.maxUs > MAX_COLUMN_MS * 1000UL) {
+    printf("FAIL column update took %.0f ms, want at most %d ms\n", columns.maxUs / 1e3, MAX_COLUMN_MS);
+    bad++;
+  }
+  if (columns.updates && columns.bytes / columns.updates > MAX_COLUMN_BYTES) {
+    printf("FAIL %lu image bytes per column, want at most %d\n", columns.bytes / columns.updates, MAX_COLUMN_BYTES);
+    bad++;
+  }
+  if (redraws.updates > MAX_REDRAWS) {
+    printf("FAIL %d full redraws, want at most %d\n", redraws.updates, MAX_REDRAWS);
+    bad++;
+  }
+  return bad ? 1 : 0;
+}
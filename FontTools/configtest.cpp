@@ -0,0 +1,257 @@
+/*
+  ConfigStore on a simulated flash, saved, migrated and corrupted
+
+  Runs the sketches' ConfigStore against shim/FlashStorage.h, a RAM
+  array standing in for the SAMD21's flash. Two versions of a settings
+  record are used, the second adding fields at the end. Checks that a
+  blank flash leaves the defaults, that a save comes back, that an older
+  record is migrated with the new fields at their defaults, and that
+  every single bit flip in a saved record is caught or is harmless. The
+  serial commands are fed through poll(). Last, an OTA update is played
+  the way ArduinoOTA's InternalStorage does it, staged in the upper half
+  of flash and copied over the sketch, and the record must survive it.
+
+  Usage: make configtest
+*/
+
+#include <stdio.h>
+#include <string>
+#include <FlashStorage.h>
+#include "ConfigStore.h"
+
+// Serial monitor, input fed from a string and output kept
+class TestStream : public Stream {
+public:
+  std::string input;
+  std::string output;
+  int available(void) { return input.size(); }
+  int read(void) {
+    int c = (unsigned char)input[0];
+    input.erase(0, 1);
+    return c;
+  }
+  void write(const char* s) { output += s; }
+};
+
+static TestStream console;
+Stream& Serial = console;
+
+namespace v1 {
+struct deviceConfig {
+  char ssid[33];
+  char pass[64];
+  char area[24];
+  uint32_t alertInterval;
+};
+
+static const deviceConfig defaults = { "home", "secret", "011FWFNC6KC", 900000 };
+
+static const configField fields[] = {
+  CONFIG_FIELD(CFG_STR, ssid),
+  CONFIG_FIELD(CFG_SECRET, pass),
+  CONFIG_FIELD(CFG_STR, area),
+  CONFIG_FIELD(CFG_U32, alertInterval),
+};
+}
+
+namespace v2 {
+struct deviceConfig {
+  char ssid[33];
+  char pass[64];
+  char area[24];
+  uint32_t alertInterval;
+  uint32_t demoInterval;  // Added in version 2
+  uint16_t port;
+};
+
+static const deviceConfig defaults = { "home", "secret", "011FWFNC6KC", 900000, 10000, 8080 };
+
+static const configField fields[] = {
+  CONFIG_FIELD(CFG_STR, ssid),
+  CONFIG_FIELD(CFG_SECRET, pass),
+  CONFIG_FIELD(CFG_STR, area),
+  CONFIG_FIELD(CFG_U32, alertInterval),
+  CONFIG_FIELD(CFG_U32, demoInterval),
+  CONFIG_FIELD(CFG_U16, port),
+};
+}
+
+static ConfigStore store1(v1::deviceConfig* config) {
+  return ConfigStore(config, sizeof(*config), 1, v1::fields, sizeof(v1::fields) / sizeof(v1::fields[0]));
+}
+
+static ConfigStore store2(v2::deviceConfig* config) {
+  return ConfigStore(config, sizeof(*config), 2, v2::fields, sizeof(v2::fields) / sizeof(v2::fields[0]));
+}
+
+static bool same(const v2::deviceConfig& a, const v2::deviceConfig& b) {
+  return strcmp(a.ssid, b.ssid) == 0 && strcmp(a.pass, b.pass) == 0 && strcmp(a.area, b.area) == 0
+         && a.alertInterval == b.alertInterval && a.demoInterval == b.demoInterval && a.port == b.port;
+}
+
+static void eraseAll(void) {
+  memset(flashMemory(), 0xFF, FLASH_SIZE);
+}
+
+static uint8_t* record(void) {
+  return flashMemory() + CONFIG_FLASH_ADDR;
+}
+
+static int check(bool ok, const char* what) {
+  if (!ok) {
+    printf("FAIL %s\n", what);
+  }
+  return ok ? 0 : 1;
+}
+
+static int blankAndRoundTrip(void) {
+  int bad = 0;
+  eraseAll();
+  v2::deviceConfig config = v2::defaults;
+  ConfigStore store = store2(&config);
+  bad += check(store.load() == 0 && same(config, v2::defaults),
+               "blank flash did not leave the defaults");
+
+  bad += check(store.set("area", "061FWF10Witney") && store.set("port", "8000") && store.save(), "set and save");
+  v2::deviceConfig saved = config;
+  config = v2::defaults;
+  bad += check(store.load() == 1 && same(config, saved), "saved config did not come back");
+
+  store.clear();
+  config = saved;
+  bad += check(store.load() == 0 && same(config, saved), "cleared record was loaded");
+  printf("Round trip    blank, save and load, clear, %d wrong\n", bad);
+  return bad;
+}
+
+static int migration(void) {
+  int bad = 0;
+  eraseAll();
+  v1::deviceConfig old = v1::defaults;
+  ConfigStore oldStore = store1(&old);
+  oldStore.set("area", "061FWF10Witney");
+  oldStore.set("alertInterval", "600000");
+  oldStore.save();
+
+  v2::deviceConfig config = v2::defaults;
+  ConfigStore store = store2(&config);
+  bad += check(store.load() == 2, "version 1 record not reported as migrated");
+  bad += check(strcmp(config.area, "061FWF10Witney") == 0 && config.alertInterval == 600000,
+               "version 1 fields lost in migration");
+  bad += check(config.demoInterval == v2::defaults.demoInterval && config.port == v2::defaults.port,
+               "new fields not left at their defaults");
+  config = v2::defaults;
+  bad += check(store.load() == 1 && strcmp(config.area, "061FWF10Witney") == 0,
+               "migrated record not saved as version 2");
+
+  // Back to older firmware, it keeps the fields it knows
+  old = v1::defaults;
+  bad += check(oldStore.load() == 2 && strcmp(old.area, "061FWF10Witney") == 0 && old.alertInterval == 600000,
+               "version 2 record not read by version 1");
+  printf("Migration     version 1 to 2 and back, %d wrong\n", bad);
+  return bad;
+}
+
+// Every single bit flip in the header and the data in use. Flips in the
+// version only force a migration, the data is still checked by the CRC.
+static int corruption(void) {
+  eraseAll();
+  v2::deviceConfig config = v2::defaults;
+  ConfigStore store = store2(&config);
+  store.set("area", "061FWF10Witney");
+  store.save();
+  v2::deviceConfig saved = config;
+  uint8_t good[sizeof(configRecord)];
+  memcpy(good, record(), sizeof(good));
+  size_t used = offsetof(configRecord, data) + sizeof(config);
+
+  int flips = 0, caught = 0, harmless = 0, bad = 0;
+  for (size_t byte = 0; byte < used; byte++) {
+    for (int bit = 0; bit < 8; bit++) {
+      memcpy(record(), good, sizeof(good));
+      record()[byte] ^= 1 << bit;
+      config = v2::defaults;
+      int loaded = store.load();
+      flips++;
+      if (loaded == 0 && same(config, v2::defaults)) {
+        caught++;
+      } else if (loaded == 2 && byte >= offsetof(configRecord, version) && byte < offsetof(configRecord, length)
+                 && same(config, saved)) {
+        harmless++;
+      } else {
+        if (!bad) {
+          printf("FAIL bit %d of byte %zu flipped, load returned %d\n", bit, byte, loaded);
+        }
+        bad++;
+      }
+    }
+  }
+
+  // A save cut off after the erase, and a length past the record
+  memset(record(), 0xFF, sizeof(configRecord));
+  config = v2::defaults;
+  bad += check(store.load() == 0 && same(config, v2::defaults), "erased record was loaded");
+  memcpy(record(), good, sizeof(good));
+  ((configRecord*)record())->length = CONFIG_DATA_LEN + 1;
+  bad += check(store.load() == 0, "record longer than CONFIG_DATA_LEN was loaded");
+  printf("Corruption    %d bit flips, %d caught, %d version only, %d wrong\n", flips, caught, harmless, bad);
+  return bad;
+}
+
+static int serialCommands(void) {
+  int bad = 0;
+  eraseAll();
+  v2::deviceConfig config = v2::defaults;
+  ConfigStore store = store2(&config);
+  console.output.clear();
+  console.input = "set area 061FWF10Witney\r\nset ssid my home net\nset port 70000\nset nope 1\n"
+                  "set area 0123456789012345678901234\nsave\nconfig\n";
+  store.poll(console);
+  const char* want = "OK\r\nOK\r\nBad field or value\r\nBad field or value\r\nBad field or value\r\nSaved\r\n";
+  bad += check(console.output.compare(0, strlen(want), want) == 0, "unexpected replies to set and save");
+  bad += check(strcmp(config.ssid, "my home net") == 0 && config.port == v2::defaults.port, "values set wrongly");
+  bad += check(console.output.find("pass = ********") != std::string::npos
+               && console.output.find(v2::defaults.pass) == std::string::npos, "password printed by config");
+  config = v2::defaults;
+  bad += check(store.load() == 1 && strcmp(config.area, "061FWF10Witney") == 0, "values saved over serial lost");
+  printf("Serial        %d commands, %d wrong\n", 7, bad);
+  return bad;
+}
+
+// ArduinoOTA's InternalStorage: the new image is staged from the middle
+// of the sketch area, then copied over the running image a row at a time
+static int otaUpdate(void) {
+  int bad = 0;
+  uint32_t half = (FLASH_SIZE - FLASH_SKETCH_START) / 2;
+  uint32_t staging = FLASH_SKETCH_START + half;
+  uint32_t maxImage = CONFIG_FLASH_ADDR - FLASH_SKETCH_START;
+  bad += check(CONFIG_FLASH_ADDR % FLASH_ROW_SIZE == 0 && CONFIG_FLASH_ADDR + CONFIG_FLASH_LEN == staging,
+               "record not in whole rows at the top of the sketch half");
+
+  eraseAll();
+  v2::deviceConfig config = v2::defaults;
+  ConfigStore store = store2(&config);
+  store.set("area", "061FWF10Witney");
+  store.save();
+  memset(flashMemory() + FLASH_SKETCH_START, 0x5A, maxImage);  // Running image, as large as allowed
+
+  FlashClass((const void*)(uintptr_t)staging, half).erase();
+  memset(flashMemory() + staging, 0xA5, maxImage);
+  FlashClass((const void*)(uintptr_t)FLASH_SKETCH_START, maxImage).erase();
+  memcpy(flashMemory() + FLASH_SKETCH_START, flashMemory() + staging, maxImage);
+
+  config = v2::defaults;
+  bad += check(store.load() == 1 && strcmp(config.area, "061FWF10Witney") == 0, "record lost in an OTA update");
+  printf("OTA update    record at 0x%lX, images up to %u bytes, %d wrong\n", (unsigned long)CONFIG_FLASH_ADDR,
+         maxImage, bad);
+  return bad;
+}
+
+int main() {
+  int bad = blankAndRoundTrip();
+  bad += migration();
+  bad += corruption();
+  bad += serialCommands();
+  bad += otaUpdate();
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+/*
+  Time the Magnet's strip updates with and without DMA
+
+  Draws the greeting and the strips of updateDisplay() and updateAge()
+  with the sketch's Paint and sends them through the real driver into
+  mockpanel. Built twice by make, with and without EPD_DMA, so the
+  CPU either clocks each strip out itself or draws the next one while
+  DMA sends it.
+
+  Drawing time on the SAMD21 is taken as the host time scaled by
+  CPU_SCALE, a rough figure for a 48 MHz Cortex-M0+ against a desktop.
+
+  Usage: make dmabench
+*/
+
+#include <stdio.h>
+#include <time.h>
+#include "epd2in9_V2.h"
+#include "epdpaint.h"
+#include "mockpanel.h"
+
+#define COLORED 0
+#define UNCOLORED 1
+#define CPU_SCALE 60
+#define REPEATS 200
+
+struct strip {
+  int y;
+  int height;
+  const char* text;
+  sFONT* font;
+};
+
+static const strip greeting[] = {
+  { 140, 32, "Flood", &Font16 },  { 120, 32, "Magnet", &Font16 }, { 80, 32, "Concept:", &Font16 },
+  { 60, 32, "Jude Pullen", &Font16 }, { 20, 32, "Code:", &Font16 }, { 0, 32, "Pete Milne", &Font16 },
+};
+
+static const strip update[] = {
+  { 80, 24, "", &Font12 },  // Chart, drawn below
+  { 20, 40, "2022-12-19 15:20", &Font12 },
+  { 0, 40, "Wifi", &Font16 },
+};
+
+static const strip age[] = {
+  { 20, 40, "2022-12-19 15:20", &Font12 },
+};
+
+static Epd<Panel2in9> epd;
+static unsigned char image[1024];
+
+static void draw(Paint* paint, const strip& s) {
+  paint->SetWidth(120);
+  paint->SetHeight(s.height);
+  paint->SetRotate(ROTATE_180);
+  paint->Clear(UNCOLORED);
+  if (s.height == 24) {
+    for (int x = 1; x < 120; x++) {
+      paint->DrawVerticalSpan(x, 12 + x % 7 - 3, 12 + (x + 1) % 7 - 3, COLORED);
+    }
+  }
+  paint->DrawStringCentred(0, 0, 120, s.text, s.font, COLORED);
+  if (s.font == &Font12) {
+    paint->DrawStringAt(0, 14, "12 min ago", s.font, COLORED);
+  }
+}
+
+// Host time to draw a strip, scaled to the SAMD21
+static uint64_t drawCost(const strip& s) {
+  Paint paint(image, 0, 0);
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    draw(&paint, s);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double us = (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3;
+  return (uint64_t)(us / REPEATS * CPU_SCALE);
+}
+
+static void run(const char* name, const strip* strips, int count) {
+  uint64_t cost[8];
+  uint64_t drawing = 0;
+  for (int i = 0; i < count; i++) {
+    cost[i] = drawCost(strips[i]);
+    drawing += cost[i];
+  }
+  Paint paint(image, 0, 0);
+  panelClearStats();
+  uint64_t start = panelMicros();
+  for (int i = 0; i < count; i++) {
+    draw(&paint, strips[i]);
+    panelSpend(cost[i]);
+    epd.SetFrameMemory_Partial(paint.GetImage(), 0, strips[i].y, paint.GetWidth(), paint.GetHeight());
+  }
+  uint64_t sent = panelMicros();
+  epd.DisplayFrame_Partial();
+  printf("  %-8s %d strips, %5.1f ms to send (%4.1f ms drawing, %5lu of %5lu bytes by DMA), %5.1f ms with refresh\n",
+         name, count, (sent - start) / 1e3, drawing / 1e3, panel.dmaBytes, panel.spiBytes, (panelMicros() - start) / 1e3);
+}
+
+int main() {
+#ifdef EPD_DMA
+  printf("DMA:\n");
+#else
+  printf("CPU:\n");
+#endif
+  epd.Init();
+  run("greeting", greeting, sizeof(greeting) / sizeof(greeting[0]));
+  run("update", update, sizeof(update) / sizeof(update[0]));
+  run("age", age, sizeof(age) / sizeof(age[0]));
+  return 0;
+}
@@ -0,0 +1,86 @@
+/*
+  Check and time the packed fonts against the full tables
+
+  Every glyph in each packed subset is drawn with both the packed font
+  and the full font it came from, at every rotation, and the buffers
+  compared. Proportional glyphs start at the pen, so are drawn shifted
+  right by their trimmed left columns to line up with the full cell. Then each is timed drawing the subset repeatedly.
+
+  Usage: make bench
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include "epdpaint.h"
+
+#define CANVAS 32
+#define REPEATS 2000
+
+extern sFONT Font12Full;
+extern sFONT Font16Full;
+
+static unsigned char packedImage[CANVAS / 8 * CANVAS];
+static unsigned char fullImage[CANVAS / 8 * CANVAS];
+
+static bool inSubset(sFONT* font, int c) {
+  return font->packed->index[c - ' '] != 0xFF;
+}
+
+// Pen position that puts a packed glyph where the full font draws it
+static int cellX(sFONT* font, int c, int x) {
+  const sPACKED* packed = font->packed;
+  return packed->proportional ? x + packed->glyphs[packed->index[c - ' ']].left : x;
+}
+
+static double drawAll(sFONT* font, sFONT* subset, unsigned char* image) {
+  Paint paint(image, CANVAS, CANVAS);
+  paint.SetRotate(ROTATE_180);
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  for (int r = 0; r < REPEATS; r++) {
+    for (int c = ' '; c <= '~'; c++) {
+      if (inSubset(subset, c)) {
+        paint.DrawCharAt(3, 5, c, font, 0);
+      }
+    }
+  }
+  gettimeofday(&end, NULL);
+  return (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_usec - start.tv_usec);
+}
+
+static int check(const char* name, sFONT* packed, sFONT* full) {
+  int glyphs = 0;
+  int bad = 0;
+  for (int c = ' '; c <= '~'; c++) {
+    if (!inSubset(packed, c)) {
+      continue;
+    }
+    glyphs++;
+    for (int rotate = ROTATE_0; rotate <= ROTATE_270; rotate++) {
+      Paint a(packedImage, CANVAS, CANVAS);
+      Paint b(fullImage, CANVAS, CANVAS);
+      a.SetRotate(rotate);
+      b.SetRotate(rotate);
+      a.Clear(1);
+      b.Clear(1);
+      a.DrawCharAt(cellX(packed, c, 3), 5, c, packed, 0);
+      b.DrawCharAt(3, 5, c, full, 0);
+      if (memcmp(packedImage, fullImage, sizeof(fullImage)) != 0) {
+        printf("%s: '%c' differs at rotation %d\n", name, c, rotate);
+        bad++;
+      }
+    }
+  }
+  double fullUs = drawAll(full, packed, fullImage);
+  double packedUs = drawAll(packed, packed, packedImage);
+  printf("%s: %d glyphs %s, full %.3f us/glyph, packed %.3f us/glyph (%.1fx)\n", name, glyphs,
+         bad ? "MISMATCH" : "match", fullUs / glyphs / REPEATS, packedUs / glyphs / REPEATS, fullUs / packedUs);
+  return bad;
+}
+
+int main() {
+  int bad = check("Font12", &Font12, &Font12Full);
+  bad += check("Font16", &Font16, &Font16Full);
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,299 @@
+/*
+  Subset and pack the e-paper fonts for a sketch
+
+  Reads a full fixed width font table from fonts/ and the sketch
+  sources, keeps only the characters that appear in string and char
+  literals (plus digits and space, for printed numbers) and writes a
+  packed font (see sFONT in fonts.h): blank rows and columns around
+  each glyph are trimmed and rows are bit-packed without byte padding.
+  The flash used before and after is reported on stderr.
+
+  With -p the font is proportional: each glyph advances by its own
+  width plus GLYPH_SPACING, and pairs of characters that sit next to
+  each other in the literals are kerned where their outlines leave a
+  wide gap, e.g. "Wa" or "r.".
+
+  Usage: fontpack [-p] NAME WIDTH HEIGHT FONT.cpp SOURCE... > packed.cpp
+
+  Copyright 2022 Peter Milne
+  Released under GNU GENERAL PUBLIC LICENSE
+  Version 3, 29 June 2007
+*/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define FIRST_CHAR ' '
+#define NUM_CHARS 95
+#define ALWAYS_CHARS " 0123456789"
+#define GLYPH_SPACING 1  // Blank columns after each proportional glyph
+#define KERN_GAP 2       // Kerned pairs are closed up to this gap
+#define MAX_KERN 3
+
+// Ink extent of a glyph in each row, cols relative to its trimmed box
+struct glyphInfo {
+  int top;
+  int rows;
+  int left;
+  int cols;
+  int advance;
+  std::vector<int> first;  // Per font row, -1 if blank
+  std::vector<int> last;
+};
+
+static bool readFile(const char* path, std::string* text) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    text->append(buf, n);
+  }
+  fclose(f);
+  return true;
+}
+
+// Hex bytes of the table, the first {...} after "_Table[]"
+static bool readTable(const std::string& text, std::vector<uint8_t>* table) {
+  size_t start = text.find("_Table[]");
+  start = start == std::string::npos ? start : text.find('{', start);
+  size_t end = start == std::string::npos ? start : text.find("};", start);
+  if (end == std::string::npos) {
+    return false;
+  }
+  for (size_t p = start; p + 3 < end; p++) {
+    if (text[p] == '/' && text[p + 1] == '/') {  // Pixel art comments
+      p = text.find('\n', p);
+      continue;
+    }
+    if (text[p] == '0' && (text[p + 1] == 'x' || text[p + 1] == 'X')) {
+      table->push_back(strtoul(text.c_str() + p, NULL, 16));
+      p += 3;
+    }
+  }
+  return true;
+}
+
+// Mark every printable character inside string and char literals,
+// and each pair of characters that appear side by side
+static void scanLiterals(const std::string& text, bool* used, bool (*pairs)[NUM_CHARS]) {
+  enum { CODE, LINE_COMMENT, BLOCK_COMMENT, LITERAL } state = CODE;
+  char quote = 0;
+  int prev = -1;
+  for (size_t p = 0; p < text.size(); p++) {
+    char c = text[p];
+    char next = p + 1 < text.size() ? text[p + 1] : 0;
+    switch (state) {
+      case CODE:
+        if (c == '/' && next == '/') {
+          state = LINE_COMMENT;
+        } else if (c == '/' && next == '*') {
+          state = BLOCK_COMMENT;
+          p++;
+        } else if (c == '"' || c == '\'') {
+          state = LITERAL;
+          quote = c;
+          prev = -1;
+        }
+        break;
+      case LINE_COMMENT:
+        state = c == '\n' ? CODE : state;
+        break;
+      case BLOCK_COMMENT:
+        if (c == '*' && next == '/') {
+          state = CODE;
+          p++;
+        }
+        break;
+      case LITERAL:
+        if (c == '\\') {
+          p++;  // Escapes are not printable
+          prev = -1;
+        } else if (c == quote || c == '\n') {
+          state = CODE;
+        } else if (c >= FIRST_CHAR && c < FIRST_CHAR + NUM_CHARS) {
+          used[c - FIRST_CHAR] = true;
+          if (prev >= 0) {
+            pairs[prev][c - FIRST_CHAR] = true;
+          }
+          prev = c - FIRST_CHAR;
+        }
+        break;
+    }
+  }
+}
+
+static std::string charComment(int c) {
+  return c == '\\' ? "'\\\\'" : std::string("'") + (char)c + "'";
+}
+
+// Blank columns between the ink of a and b, over rows where both have
+// ink, also checking the rows above and below so diagonals stay apart.
+// Large if the outlines never face each other, e.g. "T."
+static int pairGap(const glyphInfo& a, const glyphInfo& b, int height) {
+  int gap = 1000;
+  for (int y = 0; y < height; y++) {
+    if (a.last[y] < 0) {
+      continue;
+    }
+    for (int dy = -1; dy <= 1; dy++) {
+      if (y + dy < 0 || y + dy >= height || b.first[y + dy] < 0) {
+        continue;
+      }
+      int g = a.advance - a.last[y] - 1 + b.first[y + dy];
+      gap = g < gap ? g : gap;
+    }
+  }
+  return gap;
+}
+
+int main(int argc, char* argv[]) {
+  bool proportional = argc > 1 && strcmp(argv[1], "-p") == 0;
+  if (proportional) {
+    argc--;
+    argv++;
+  }
+  if (argc < 6) {
+    fprintf(stderr, "Usage: %s [-p] NAME WIDTH HEIGHT FONT.cpp SOURCE... > packed.cpp\n", argv[0]);
+    return 1;
+  }
+  const char* name = argv[1];
+  int width = atoi(argv[2]);
+  int height = atoi(argv[3]);
+  int rowBytes = (width + 7) / 8;
+  int glyphBytes = rowBytes * height;
+
+  std::string text;
+  std::vector<uint8_t> table;
+  if (!readFile(argv[4], &text) || !readTable(text, &table) || table.size() != (size_t)glyphBytes * NUM_CHARS) {
+    fprintf(stderr, "%s: not a %dx%d font table\n", argv[4], width, height);
+    return 1;
+  }
+
+  bool used[NUM_CHARS] = { false };
+  static bool pairs[NUM_CHARS][NUM_CHARS];
+  for (const char* c = ALWAYS_CHARS; *c; c++) {
+    used[*c - FIRST_CHAR] = true;
+  }
+  for (int i = 5; i < argc; i++) {
+    std::string source;
+    if (!readFile(argv[i], &source)) {
+      return 1;
+    }
+    scanLiterals(source, used, pairs);
+  }
+
+  printf("// Generated by FontTools/fontpack from %s, do not edit.\n", strrchr(argv[4], '/') ? strrchr(argv[4], '/') + 1 : argv[4]);
+  printf("// Subset of the characters used by the sketch, see fonts.h for the format.\n\n");
+  printf("#include \"fonts.h\"\n#include <avr/pgmspace.h>\n\n");
+  printf("static const uint8_t %s_Bits[] PROGMEM = {\n", name);
+
+  std::string glyphs;
+  glyphInfo info[NUM_CHARS];
+  uint8_t index[NUM_CHARS];
+  int count = 0;
+  size_t offset = 0;
+  for (int c = 0; c < NUM_CHARS; c++) {
+    index[c] = 0xFF;
+    if (!used[c]) {
+      continue;
+    }
+    const uint8_t* glyph = &table[c * glyphBytes];
+    auto pixel = [&](int x, int y) { return (glyph[y * rowBytes + x / 8] >> (7 - x % 8)) & 1; };
+    glyphInfo& g = info[c];
+    g.first.assign(height, -1);
+    g.last.assign(height, -1);
+    int top = height, bottom = 0, left = width, right = 0;
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        if (pixel(x, y)) {
+          top = y < top ? y : top;
+          bottom = y + 1;
+          left = x < left ? x : left;
+          right = x + 1 > right ? x + 1 : right;
+        }
+      }
+    }
+    if (top >= bottom) {  // Space
+      top = bottom = left = right = 0;
+    }
+    g.top = top;
+    g.rows = bottom - top;
+    g.left = left;
+    g.cols = right - left;
+    g.advance = !proportional ? width : g.cols ? g.cols + GLYPH_SPACING : width / 2;
+
+    std::vector<uint8_t> bits((g.rows * g.cols + 7) / 8, 0);
+    int bit = 0;
+    for (int y = top; y < bottom; y++) {
+      for (int x = left; x < right; x++, bit++) {
+        if (pixel(x, y)) {
+          bits[bit / 8] |= 0x80 >> (bit % 8);
+          g.first[y] = g.first[y] < 0 ? x - left : g.first[y];
+          g.last[y] = x - left;
+        }
+      }
+    }
+    printf(" ");
+    for (uint8_t b : bits) {
+      printf(" 0x%02X,", b);
+    }
+    printf("  // %s\n", charComment(c + FIRST_CHAR).c_str());
+
+    char line[80];
+    snprintf(line, sizeof(line), "  { %zu, %d, %d, %d, %d, %d },  // %s\n", offset, g.top, g.rows, g.left, g.cols, g.advance,
+             charComment(c + FIRST_CHAR).c_str());
+    glyphs += line;
+    index[c] = count++;
+    offset += bits.size();
+  }
+  if (offset == 0) {
+    printf("  0x00,\n");  // No empty arrays
+  }
+  printf("};\n\n");
+  printf("static const sGLYPH %s_Glyphs[] PROGMEM = {\n%s};\n\n", name, glyphs.c_str());
+  printf("static const uint8_t %s_Index[] PROGMEM = {", name);
+  for (int c = 0; c < NUM_CHARS; c++) {
+    printf("%s0x%02X,", c % 16 ? " " : "\n  ", index[c]);
+  }
+  printf("\n};\n\n");
+
+  // Loops in character order so the table comes out sorted
+  int kerns = 0;
+  for (int a = 0; proportional && a < NUM_CHARS; a++) {
+    for (int b = 0; b < NUM_CHARS; b++) {
+      if (!pairs[a][b] || !info[a].cols || !info[b].cols) {
+        continue;
+      }
+      int adjust = KERN_GAP - pairGap(info[a], info[b], height);
+      adjust = adjust < -MAX_KERN ? -MAX_KERN : adjust;
+      if (adjust < 0) {
+        if (!kerns++) {
+          printf("static const sKERN %s_Kerns[] PROGMEM = {\n", name);
+        }
+        printf("  { %s, %s, %d },\n", charComment(a + FIRST_CHAR).c_str(), charComment(b + FIRST_CHAR).c_str(), adjust);
+      }
+    }
+  }
+  if (kerns) {
+    printf("};\n\n");
+    printf("static const sPACKED %s_Packed = { %s_Bits, %s_Glyphs, %s_Index, %s_Kerns, %d, %d };\n\n", name, name, name, name,
+           name, kerns, proportional);
+  } else {
+    printf("static const sPACKED %s_Packed = { %s_Bits, %s_Glyphs, %s_Index, 0, 0, %d };\n\n", name, name, name, name,
+           proportional);
+  }
+  printf("sFONT %s = {\n  0, /* Packed, no full table */\n  %d, /* Width */\n  %d, /* Height */\n  &%s_Packed,\n};\n", name, width, height, name);
+
+  size_t packed = offset + count * sizeof(uint16_t) * 4 + NUM_CHARS + kerns * 3;
+  fprintf(stderr, "%s: %d of %d glyphs, %d kerning pairs, %zu bytes packed, %d bytes full (%.0f%% saved)\n", name, count,
+          NUM_CHARS, kerns, packed, glyphBytes * NUM_CHARS, 100.0 - 100.0 * packed / (glyphBytes * NUM_CHARS));
+  return 0;
+}
@@ -0,0 +1,167 @@
+/*
+  Compare strip and full frame uploads over a simulated day
+
+  Replays a day of Magnet display updates (two severity changes, the
+  relative age ticking over and a chart column every poll) through the
+  real e-paper driver into mockpanel, once writing each strip straight
+  to the panel and once through EpdFrame (FULL_FRAME builds). The panel
+  RAM is checked to match after every update, then SPI bytes, memory
+  windows and time are reported for each.
+
+  Usage: make framebench
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "epd2in9_V2.h"
+#include "epdpaint.h"
+#include "EpdFrame.h"
+#include "mockpanel.h"
+#include "img/flood_screens.h"
+
+#define COLORED 0
+#define UNCOLORED 1
+#define DAY_MINUTES (24 * 60)
+#define POLL_MINUTES 15
+
+// Strips straight to the panel, as the sketch without FULL_FRAME
+class PanelStrips : public StripTarget {
+public:
+  PanelStrips(Epd<Panel2in9>* epd) : _epd(epd) {}
+  void writeStrip(const unsigned char* image, int x, int y, int width, int height) {
+    _epd->SetFrameMemory_Partial(image, x, y, width, height);
+  }
+
+private:
+  Epd<Panel2in9>* _epd;
+};
+
+static Epd<Panel2in9> epd;
+static unsigned char image[1024];
+static unsigned char chartImage[120 / 8 * 24];
+static std::vector<std::vector<uint8_t> > snapshots;
+
+static void show(EpdFrame* frame) {
+  if (frame) {
+    frame->flush(&epd);
+  }
+  epd.DisplayFrame_Partial();
+}
+
+static void drawTime(StripTarget* target, int minute) {
+  char timeStr[20];
+  char ageStr[20];
+  snprintf(timeStr, sizeof(timeStr), "2022-12-19 %02d:%02d", 6 + minute / 60 % 24, minute % 60);
+  if (minute < 60) {
+    snprintf(ageStr, sizeof(ageStr), "%d min ago", minute);
+  } else {
+    snprintf(ageStr, sizeof(ageStr), "%d hr ago", minute / 60);
+  }
+  Paint paint(image, 120, 40);
+  paint.SetRotate(ROTATE_180);
+  paint.Clear(UNCOLORED);
+  paint.DrawStringAt(0, 0, timeStr, &Font12, COLORED);
+  paint.DrawStringAt(0, 14, ageStr, &Font12, COLORED);
+  target->writeStrip(paint.GetImage(), 0, 20, paint.GetWidth(), paint.GetHeight());
+}
+
+static int chartY(int minute) {
+  return 12 + (minute / POLL_MINUTES * 7) % 11 - 5;
+}
+
+static void drawChartColumn(Paint* paint, int minute) {
+  int col = minute / POLL_MINUTES % 119 + 1;
+  paint->DrawVerticalSpan(col, 0, 23, UNCOLORED);
+  paint->DrawVerticalSpan(col, chartY(minute - POLL_MINUTES), chartY(minute), COLORED);
+}
+
+static void fullUpdate(StripTarget* target, EpdFrame* frame, const unsigned char* screen, int minute) {
+  epd.Init();
+  epd.ClearFrameMemory(0xFF);
+  epd.DisplayFrame();
+  delay(500);
+  epd.SetFrameMemory_Base(screen);
+  epd.DisplayFrame();
+  if (frame) {
+    frame->load(screen);
+  }
+
+  Paint chart(chartImage, 120, 24);
+  chart.SetRotate(ROTATE_180);
+  chart.Clear(UNCOLORED);
+  for (int m = POLL_MINUTES; m <= minute; m += POLL_MINUTES) {
+    drawChartColumn(&chart, m);
+  }
+  target->writeStrip(chart.GetImage(), 0, 80, chart.GetWidth(), chart.GetHeight());
+
+  drawTime(target, 0);
+
+  Paint status(image, 120, 40);
+  status.SetRotate(ROTATE_180);
+  status.Clear(UNCOLORED);
+  status.DrawStringAt(0, 0, "Wifi", &Font16, COLORED);
+  target->writeStrip(status.GetImage(), 0, 0, status.GetWidth(), status.GetHeight());
+  show(frame);
+}
+
+// Same slice upload as LevelChart::uploadColumn
+static void chartUpdate(StripTarget* target, EpdFrame* frame, int minute) {
+  Paint chart(chartImage, 120, 24);
+  chart.SetRotate(ROTATE_180);
+  drawChartColumn(&chart, minute);
+  int byteCol = (120 - (minute / POLL_MINUTES % 119 + 1)) / 8;
+  unsigned char slice[24];
+  for (int row = 0; row < 24; row++) {
+    slice[row] = chartImage[row * 15 + byteCol];
+  }
+  target->writeStrip(slice, byteCol * 8, 80, 8, 24);
+  show(frame);
+}
+
+// Returns the number of updates that left the panel RAM different
+// from the strip run
+static int replayDay(StripTarget* target, EpdFrame* frame, bool record) {
+  int raised = 0;
+  int bad = 0;
+  size_t update = 0;
+  panelClearStats();
+  uint64_t start = panelMicros();
+  for (int minute = 0; minute < DAY_MINUTES; minute++) {
+    int age = minute - raised;
+    bool refreshed = true;
+    if (minute == 0 || minute == 10 * 60) {
+      raised = minute;
+      fullUpdate(target, frame, minute ? epd_screen_alert : epd_screen_warning, minute);
+    } else if (minute % POLL_MINUTES == 0) {
+      chartUpdate(target, frame, minute);
+    } else if (age < 60 || age % 60 == 0) {
+      drawTime(target, age);
+      show(frame);
+    } else {
+      refreshed = false;
+    }
+    if (!refreshed) {
+      continue;
+    }
+    if (record) {
+      snapshots.push_back(std::vector<uint8_t>(panelRam[0], panelRam[0] + PANEL_BYTES));
+    } else if (memcmp(snapshots[update].data(), panelRam[0], PANEL_BYTES) != 0) {
+      bad++;
+    }
+    update++;
+  }
+  printf("%-7s %6lu SPI bytes/day, %4lu windows, %4lu resets, %3lu partial + %lu full refreshes, %.1f s updating\n",
+         frame ? "frame" : "strips", panel.spiBytes, panel.windows, panel.resets, panel.partialRefreshes,
+         panel.fullRefreshes, (panelMicros() - start) / 1e6);
+  return bad;
+}
+
+int main() {
+  static EpdFrame frame;
+  PanelStrips strips(&epd);
+  replayDay(&strips, NULL, true);
+  int bad = replayDay(&frame, &frame, false);
+  printf("Panel RAM %s after all %zu updates\n", bad ? "DIFFERS" : "matches", snapshots.size());
+  return bad ? 1 : 0;
+}
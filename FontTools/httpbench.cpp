@@ -0,0 +1,327 @@
+/*
+  HttpFetch against a stand-in server that trickles, drops and stalls
+
+  A forked child listens on 127.0.0.1 and answers each request by its
+  path: a sized, a chunked and a close-delimited flood area response,
+  a 304, a 100 Continue, an overlong header, one sent a byte at a time,
+  and responses cut off or stalled in the status line or the body. The
+  fetch runs over a non-blocking socket with short deadlines and is
+  stepped as loop() would. Each case reports how it ended, the warning
+  the WarningScanner found and the longest single step, which is the
+  longest loop() is held up. The blocking getData() held it for the
+  whole fetch, up to the stream timeout per stalled read.
+
+  Usage: make httpbench
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include "HttpFetch.h"
+#include "WarningScan.h"
+
+static const char* BODY =
+  "{\"@context\":\"http://environment.data.gov.uk/flood-monitoring/meta/context.jsonld\",\"items\":{"
+  "\"@id\":\"http://environment.data.gov.uk/flood-monitoring/id/floodAreas/062WAF28UpAvon\","
+  "\"county\":\"Wiltshire\",\"description\":\"River Avon \\\"upper\\\" reaches\",\"eaAreaName\":\"Wessex\","
+  "\"currentWarning\":{\"@id\":\"http://environment.data.gov.uk/flood-monitoring/id/floods/062WAF28UpAvon\","
+  "\"description\":\"Upper Avon\",\"floodArea\":{\"county\":\"Wiltshire\",\"notation\":\"062WAF28UpAvon\"},"
+  "\"floodAreaID\":\"062WAF28UpAvon\",\"isTidal\":false,\"message\":\"River levels are rising\","
+  "\"severity\":\"Flood warning\",\"severityLevel\":2,\"timeChanged\":\"2022-12-19T15:30:00\","
+  "\"timeMessageChanged\":\"2022-12-19T15:20:00\",\"timeRaised\":\"2022-12-19T15:20:31\"},"
+  "\"fwdCode\":\"062WAF28UpAvon\",\"lat\":51.3,\"long\":-1.8,\"notation\":\"062WAF28UpAvon\",\"riverOrSea\":\"River Avon\"}}";
+
+unsigned long millis(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1000UL + t.tv_nsec / 1000000;
+}
+
+static unsigned long micros64(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1000000UL + t.tv_nsec / 1000;
+}
+
+// ---- Stand-in server ----
+
+static void sendAll(int fd, const char* data, size_t len) {
+  while (len > 0) {
+    ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+    if (n <= 0) {
+      return;
+    }
+    data += n;
+    len -= n;
+  }
+}
+
+static void sendStr(int fd, const char* s) {
+  sendAll(fd, s, strlen(s));
+}
+
+static void sendHead(int fd, const char* extra) {
+  char head[1024];
+  snprintf(head, sizeof(head),
+           "HTTP/1.1 200 OK\r\nDate: Mon, 19 Dec 2022 15:40:00 GMT\r\nETag: \"6ad5a939-1\"\r\n"
+           "Content-Type: application/json\r\n%s\r\n",
+           extra);
+  sendStr(fd, head);
+}
+
+static void serve(int fd) {
+  char request[1024];
+  size_t len = 0;
+  while (len < sizeof(request) - 1 && !strstr(request, "\r\n\r\n")) {
+    ssize_t n = recv(fd, &request[len], sizeof(request) - 1 - len, 0);
+    if (n <= 0) {
+      return;
+    }
+    len += n;
+    request[len] = '\0';
+  }
+  char path[64] = { 0 };
+  sscanf(request, "GET /%63s", path);
+  char sized[64];
+  snprintf(sized, sizeof(sized), "Content-Length: %u\r\n", (unsigned)strlen(BODY));
+  size_t bodyLen = strlen(BODY);
+
+  if (strcmp(path, "sized") == 0) {
+    sendHead(fd, sized);
+    sendStr(fd, BODY);
+  } else if (strcmp(path, "chunked") == 0) {
+    sendHead(fd, "Transfer-Encoding: chunked\r\n");
+    for (size_t i = 0; i < bodyLen; i += 100) {
+      size_t n = bodyLen - i < 100 ? bodyLen - i : 100;
+      char size[32];
+      snprintf(size, sizeof(size), "%zx%s\r\n", n, i ? "" : ";ext=1");
+      sendStr(fd, size);
+      sendAll(fd, &BODY[i], n);
+      sendStr(fd, "\r\n");
+    }
+    sendStr(fd, "0\r\nX-Trailer: 1\r\n\r\n");
+  } else if (strcmp(path, "close") == 0) {
+    sendHead(fd, "");
+    sendStr(fd, BODY);
+  } else if (strcmp(path, "not-modified") == 0) {
+    sendStr(fd, "HTTP/1.1 304 Not Modified\r\nETag: \"6ad5a939-1\"\r\n\r\n");
+  } else if (strcmp(path, "continue") == 0) {
+    sendStr(fd, "HTTP/1.1 100 Continue\r\n\r\n");
+    sendHead(fd, sized);
+    sendStr(fd, BODY);
+  } else if (strcmp(path, "long-header") == 0) {
+    char extra[600] = "Set-Cookie: ";
+    memset(&extra[12], 'c', 500);
+    strcat(extra, "\r\n");
+    strcat(extra, sized);
+    sendHead(fd, extra);
+    sendStr(fd, BODY);
+  } else if (strcmp(path, "trickle") == 0) {
+    char response[2048];
+    snprintf(response, sizeof(response), "HTTP/1.1 200 OK\r\n%s\r\n%s", sized, BODY);
+    for (const char* p = response; *p; p++) {
+      sendAll(fd, p, 1);
+      usleep(500);
+    }
+  } else if (strcmp(path, "drop") == 0) {
+    sendHead(fd, sized);
+    sendAll(fd, BODY, bodyLen / 2);
+  } else if (strcmp(path, "stall-status") == 0) {
+    sleep(2);
+  } else if (strcmp(path, "stall-headers") == 0) {
+    sendStr(fd, "HTTP/1.1 200 OK\r\nContent-Type: appl");
+    sleep(2);
+  } else if (strcmp(path, "stall-body") == 0) {
+    sendHead(fd, sized);
+    sendAll(fd, BODY, bodyLen / 2);
+    sleep(2);
+  } else if (strcmp(path, "bad-chunk") == 0) {
+    sendHead(fd, "Transfer-Encoding: chunked\r\n");
+    sendStr(fd, "zz\r\n");
+  } else if (strcmp(path, "not-http") == 0) {
+    sendStr(fd, "SSH-2.0-OpenSSH\r\n");
+  }
+}
+
+static int startServer(uint16_t* port) {
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addrLen = sizeof(addr);
+  if (bind(listener, (struct sockaddr*)&addr, addrLen) < 0 || listen(listener, 8) < 0) {
+    return -1;
+  }
+  getsockname(listener, (struct sockaddr*)&addr, &addrLen);
+  *port = ntohs(addr.sin_port);
+  signal(SIGCHLD, SIG_IGN);
+  pid_t server = fork();
+  if (server == 0) {
+    while (true) {
+      int fd = accept(listener, NULL, NULL);
+      if (fd >= 0 && fork() == 0) {
+        serve(fd);
+        close(fd);
+        _exit(0);
+      }
+      close(fd);
+    }
+  }
+  close(listener);
+  return server;
+}
+
+// ---- Non-blocking client, as a WiFiClient ----
+
+class HostClient : public Client {
+public:
+  int connect(const char* host, uint16_t port) {
+    _fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, host, &addr.sin_addr);
+    if (::connect(_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+      stop();
+      return 0;
+    }
+    fcntl(_fd, F_SETFL, O_NONBLOCK);
+    return 1;
+  }
+  size_t write(const uint8_t* buf, size_t size) {
+    ssize_t n = send(_fd, buf, size, MSG_NOSIGNAL);
+    return n > 0 ? n : 0;
+  }
+  int available() {
+    int n = 0;
+    return _fd >= 0 && ioctl(_fd, FIONREAD, &n) == 0 ? n : 0;
+  }
+  int read(uint8_t* buf, size_t size) {
+    ssize_t n = recv(_fd, buf, size, 0);
+    return n > 0 ? n : -1;
+  }
+  uint8_t connected() {
+    char c;
+    if (_fd < 0) {
+      return 0;
+    }
+    ssize_t n = recv(_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n > 0 || (n < 0 && errno == EAGAIN);
+  }
+  void stop() {
+    if (_fd >= 0) {
+      close(_fd);
+    }
+    _fd = -1;
+  }
+
+private:
+  int _fd = -1;
+};
+
+// ---- Consumer, as FloodAPI ----
+
+class ScanConsumer : public HttpConsumer {
+public:
+  WarningScanner scanner;
+  int headers = 0;
+  size_t longest = 0;
+  void header(const char* line) {
+    headers++;
+    longest = strlen(line) > longest ? strlen(line) : longest;
+  }
+  bool body(const uint8_t* data, size_t len) {
+    scanner.feed((const char*)data, len);
+    return true;
+  }
+};
+
+struct fetchCase {
+  const char* path;
+  httpPhase ends;      // DONE, or the phase it should fail in
+  bool timedOut;
+};
+
+static const fetchCase cases[] = {
+  { "sized", HTTP_DONE, false },
+  { "chunked", HTTP_DONE, false },
+  { "close", HTTP_DONE, false },
+  { "not-modified", HTTP_DONE, false },
+  { "continue", HTTP_DONE, false },
+  { "long-header", HTTP_DONE, false },
+  { "trickle", HTTP_DONE, false },
+  { "drop", HTTP_BODY, false },
+  { "stall-status", HTTP_STATUS, true },
+  { "stall-headers", HTTP_HEADERS, true },
+  { "stall-body", HTTP_BODY, true },
+  { "bad-chunk", HTTP_CHUNK_SIZE, false },
+  { "not-http", HTTP_STATUS, false },
+};
+
+static const char* phaseNames[] = { "idle", "connect", "send", "status", "headers", "body", "chunk size",
+                                    "chunk data", "chunk end", "trailers", "done", "failed" };
+
+int main() {
+  uint16_t port;
+  pid_t server = startServer(&port);
+  if (server < 0) {
+    printf("No loopback socket\n");
+    return 1;
+  }
+  HostClient client;
+  HttpFetch fetch(&client);
+  fetch.deadlines = { 200, 300, 300, 200, 3000 };
+  int bad = 0;
+  unsigned long worst = 0;
+
+  printf("Case            Result                       Status  Warning  Headers    Time  Steps  Longest step\n");
+  for (const fetchCase& c : cases) {
+    ScanConsumer consumer;
+    consumer.scanner.begin();
+    char request[128];
+    snprintf(request, sizeof(request), "GET /%s HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n", c.path);
+    unsigned long start = micros64();
+    fetch.begin("127.0.0.1", port, request, &consumer, millis());
+    unsigned long steps = 0;
+    unsigned long longest = 0;
+    while (fetch.busy()) {
+      unsigned long t = micros64();
+      fetch.step(millis());
+      t = micros64() - t;
+      longest = t > longest ? t : longest;
+      steps++;
+      usleep(50);  // The rest of loop()
+    }
+    double ms = (micros64() - start) / 1e3;
+
+    char result[40];
+    if (fetch.phase() == HTTP_DONE) {
+      snprintf(result, sizeof(result), "done");
+    } else {
+      snprintf(result, sizeof(result), "%s in %s", fetch.timedOut() ? "timed out" : "failed", phaseNames[fetch.failedIn()]);
+    }
+    bool ok = c.ends == HTTP_DONE ? fetch.phase() == HTTP_DONE : fetch.phase() == HTTP_FAILED && fetch.failedIn() == c.ends
+                                                                   && fetch.timedOut() == c.timedOut;
+    if (ok && fetch.status() == 200 && c.ends == HTTP_DONE) {
+      ok = consumer.scanner.complete() && consumer.scanner.severity() == 2 && consumer.scanner.areaId()
+           && strcmp(consumer.scanner.areaId(), "062WAF28UpAvon") == 0
+           && strcmp(consumer.scanner.timeRaised(), "2022-12-19T15:20:31") == 0;
+    }
+    bad += !ok;
+    worst = longest > worst ? longest : worst;
+    printf("%-15s %-28s %6d  %7d  %7d  %4.0f ms  %5lu  %6lu us%s\n", c.path, result, fetch.status(),
+           consumer.scanner.severity(), consumer.headers, ms, steps, longest, ok ? "" : "  UNEXPECTED");
+  }
+  kill(server, SIGTERM);
+  printf("Longest step %lu us, %d of %d cases as expected\n", worst, (int)(sizeof(cases) / sizeof(cases[0])) - bad,
+         (int)(sizeof(cases) / sizeof(cases[0])));
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,198 @@
+/*
+  LevelSeries codec, checked and timed
+
+  Round-trips samples whose gaps and changes sit either side of each
+  varint length and zigzag sign, checks that full buffers drop the
+  oldest samples and keep the rest intact, and that out of order
+  samples are refused. Then fills the series from a synthetic 15
+  minute station record, a slow tide with a flood rising through it,
+  and reports bytes per sample against the 8 of a time and level pair,
+  the days held, and append and iterate time. The SAMD21 time is the
+  host time scaled by CPU_SCALE, as bandbench.
+
+  Usage: make levelbench
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include <vector>
+#include "LevelSeries.h"
+
+#define CPU_SCALE 60
+#define REPEATS 2000
+#define STEP (15 * 60)          // Station reporting interval
+#define RAW_BYTES 8             // uint32 time and int32 level
+#define MAX_BYTES_PER_SAMPLE 2.5
+#define MIN_DAYS 5
+
+struct sample {
+  uint32_t time;
+  int32_t level;
+};
+
+static const uint32_t T0 = 1671463200UL;  // 2022-12-19 15:20:00
+
+static int compare(const char* name, LevelSeries& series, const std::vector<sample>& want, size_t from) {
+  levelCursor c;
+  series.begin(&c);
+  size_t i = from;
+  int bad = 0;
+  while (series.next(&c)) {
+    if (i >= want.size() || c.time != want[i].time || c.level != want[i].level) {
+      if (!bad) {
+        printf("FAIL %s sample %zu is %u %d", name, i, c.time, c.level);
+        if (i < want.size()) {
+          printf(", want %u %d", want[i].time, want[i].level);
+        }
+        printf("\n");
+      }
+      bad++;
+    }
+    i++;
+  }
+  if (i != want.size() || series.count() != want.size() - from) {
+    printf("FAIL %s held %zu samples, count %zu, want %zu\n", name, i - from, series.count(), want.size() - from);
+    bad++;
+  }
+  return bad ? 1 : 0;
+}
+
+// Gaps of 1 - 128+ minutes and changes either side of 1, 2, 3 and 5 byte varints
+static int roundTrip(void) {
+  static const int32_t changes[] = {
+    0, 1, -1, 63, -64, 64, -65, 8191, -8192, 8192, -8193, 1048575, -1048576, 1048576,
+    -1048577, 0x3FFFFFFF, -0x40000000, 0x3FFFFFFF,
+  };
+  static const uint32_t gaps[] = { 1, 2, 127, 128, 16383, 16384, 3 * 24 * 60 };
+  LevelSeries series;
+  series.clear();
+  std::vector<sample> want;
+  uint32_t time = T0;
+  int32_t level = 0;
+  size_t n = sizeof(changes) / sizeof(changes[0]);
+  for (size_t i = 0; i < n; i++) {
+    level += changes[i];
+    want.push_back({ time, level });
+    if (!series.append(time, level)) {
+      printf("FAIL append %zu refused\n", i);
+      return 1;
+    }
+    time += gaps[i % (sizeof(gaps) / sizeof(gaps[0]))] * 60;
+  }
+  int bad = compare("round trip", series, want, 0);
+
+  // Seconds are dropped, times come back on the minute
+  series.clear();
+  want.clear();
+  for (int i = 0; i < 10; i++) {
+    uint32_t t = T0 + i * STEP + (i * 7) % 60;
+    series.append(t, 1000 + i);
+    want.push_back({ T0 + i * STEP, 1000 + i });
+  }
+  bad += compare("whole minutes", series, want, 0);
+
+  // Same time and older samples are refused
+  uint32_t last = series.lastTime();
+  if (series.append(last, 5) || series.append(last - 60, 5) || series.count() != want.size()) {
+    printf("FAIL out of order sample accepted\n");
+    bad++;
+  }
+  printf("Round trip    %zu + 10 samples, %d wrong\n", n, bad);
+  return bad;
+}
+
+// Synthetic gauge in mm, a tide with a flood crest on day 4
+static int32_t gauge(int i) {
+  double hours = i * STEP / 3600.0;
+  double tide = 150 * sin(hours * 2 * M_PI / 12.42);
+  double flood = 1800 * exp(-pow((hours - 84) / 10, 2));
+  double noise = ((i * 2654435761u) >> 28) - 8;
+  return (int32_t)lround(600 + tide + flood + noise);
+}
+
+// Keep appending past full, the oldest go and the rest stay intact
+static int eviction(void) {
+  LevelSeries series;
+  series.clear();
+  std::vector<sample> want;
+  int n = 3 * LEVEL_SERIES_LEN;
+  size_t maxUsed = 0;
+  for (int i = 0; i < n; i++) {
+    want.push_back({ T0 + i * STEP, gauge(i) });
+    series.append(want.back().time, want.back().level);
+    maxUsed = series.bytesUsed() > maxUsed ? series.bytesUsed() : maxUsed;
+  }
+  int bad = compare("eviction", series, want, want.size() - series.count());
+  if (maxUsed > LEVEL_SERIES_LEN) {
+    printf("FAIL %zu bytes used of %d\n", maxUsed, LEVEL_SERIES_LEN);
+    bad++;
+  }
+  printf("Eviction      %d appended, newest %zu kept, %d wrong\n", n, series.count(), bad);
+  return bad;
+}
+
+static double elapsedNs(struct timespec start, struct timespec end, long ops) {
+  return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / ops;
+}
+
+static int ratio(void) {
+  static LevelSeries series;
+  std::vector<int32_t> levels;
+  for (int i = 0; i < 4 * LEVEL_SERIES_LEN; i++) {
+    levels.push_back(gauge(i));
+  }
+
+  struct timespec start, end;
+  volatile int32_t sink = 0;
+  long appended = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    series.clear();
+    for (size_t i = 0; i < levels.size(); i++) {
+      series.append(T0 + i * STEP, levels[i]);
+    }
+    appended += levels.size();
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double appendNs = elapsedNs(start, end, appended);
+
+  long read = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    levelCursor c;
+    series.begin(&c);
+    while (series.next(&c)) {
+      sink = sink + c.level;
+      read++;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double readNs = elapsedNs(start, end, read);
+
+  double perSample = (double)series.bytesUsed() / (series.count() - 1);
+  double days = (double)(series.count() - 1) * STEP / 86400;
+  printf("Ratio         %zu samples in %zu bytes, %.2f bytes/sample, %.1fx smaller than raw, %.1f days\n",
+         series.count(), series.bytesUsed(), perSample, RAW_BYTES / perSample, days);
+  printf("Append        %5.1f ns on the host, %5.2f us on the SAMD21\n", appendNs, appendNs * CPU_SCALE / 1e3);
+  printf("Iterate       %5.1f ns on the host, %5.2f us on the SAMD21, %.1f ms for the series\n", readNs,
+         readNs * CPU_SCALE / 1e3, readNs * CPU_SCALE * series.count() / 1e6);
+
+  int bad = 0;
+  if (perSample > MAX_BYTES_PER_SAMPLE) {
+    printf("FAIL %.2f bytes/sample, want at most %.2f\n", perSample, MAX_BYTES_PER_SAMPLE);
+    bad++;
+  }
+  if (days < MIN_DAYS) {
+    printf("FAIL %.1f days held, want at least %d\n", days, MIN_DAYS);
+    bad++;
+  }
+  return bad;
+}
+
+int main() {
+  int bad = roundTrip();
+  bad += eviction();
+  bad += ratio();
+  return bad ? 1 : 0;
+}
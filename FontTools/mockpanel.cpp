@@ -0,0 +1,301 @@
+/*
+  Simulated 2.9" e-paper panels, see mockpanel.h
+*/
+
+#include <string.h>
+#include <Arduino.h>
+#include <SPI.h>
+#include "epdif.h"
+#include "mockpanel.h"
+
+panelStats panel;
+uint8_t panelRam[2][PANEL_BYTES];
+int panelTemperature = 22;
+SPIClass SPI;
+
+static uint64_t now;          // Virtual time in us
+static uint64_t dmaUntil;
+static uint32_t usPerByte = 4;
+static int dc = HIGH;         // Shared by every panel
+static int readBit = -1;      // Bits of the temperature register clocked out, -1 if not reading
+static int sck = LOW;
+
+// One controller on the bus, selected by its CS pin
+struct controller {
+  int csPin, rstPin, busyPin;
+  unsigned long fullMs;
+  unsigned long partialBaseMs;  // For the stock partial waveform
+  uint8_t (*ram)[PANEL_BYTES];
+  uint64_t busyUntil;
+  int rst;
+
+  uint8_t command;
+  int dataCount;
+  uint8_t args[4];
+  int bank;                     // RAM being written, -1 for none
+  int xStart, xEnd, yStart, yEnd;
+  int xPtr, yPtr;
+  uint8_t updateMode;
+  uint8_t lut[153];
+  unsigned long partialMs;
+};
+
+static uint8_t moreRam[PANEL_MAX - 1][2][PANEL_BYTES];
+static controller controllers[PANEL_MAX] = {
+  { EpdBoardPins::CS, EpdBoardPins::RST, EpdBoardPins::BUSY, PANEL_FULL_MS, PANEL_PARTIAL_MS, panelRam, 0, HIGH,
+    0, 0, { 0 }, -1, 0, PANEL_ROW_BYTES - 1, 0, PANEL_ROWS - 1, 0, 0, 0, { 0 }, PANEL_PARTIAL_MS },
+};
+static int numControllers = 1;
+static controller* ctl = &controllers[0];  // Selected by the last CS low
+
+int panelAdd(int cs, int rst, int busy, unsigned long fullMs, unsigned long partialMs) {
+  if (numControllers >= PANEL_MAX) {
+    return -1;
+  }
+  controller* c = &controllers[numControllers];
+  memset(c, 0, sizeof(*c));
+  c->csPin = cs;
+  c->rstPin = rst;
+  c->busyPin = busy;
+  c->fullMs = fullMs;
+  c->partialBaseMs = c->partialMs = partialMs;
+  c->ram = moreRam[numControllers - 1];
+  c->rst = HIGH;
+  c->bank = -1;
+  c->xEnd = PANEL_ROW_BYTES - 1;
+  c->yEnd = PANEL_ROWS - 1;
+  return numControllers++;
+}
+
+const uint8_t* panelRamOf(int n, int bank) {
+  return controllers[n].ram[bank];
+}
+
+void panelClearStats(void) {
+  memset(&panel, 0, sizeof(panel));
+}
+
+uint64_t panelMicros(void) {
+  return now;
+}
+
+void panelSpend(uint64_t us) {
+  now += us;
+}
+
+void panelPowerCycle(void) {
+  for (int n = 0; n < numControllers; n++) {
+    for (int i = 0; i < PANEL_BYTES; i++) {
+      controllers[n].ram[0][i] = rand();
+      controllers[n].ram[1][i] = rand();
+    }
+  }
+}
+
+// Frames the loaded waveform drives for: each group's four phases,
+// repeated RP + 1 times
+static unsigned long lutFrames(void) {
+  unsigned long frames = 0;
+  for (int g = 0; g < 12; g++) {
+    const uint8_t* group = &ctl->lut[60 + g * 7];
+    frames += (unsigned long)(group[0] + group[1] + group[3] + group[4]) * (group[6] + 1);
+  }
+  return frames;
+}
+
+static void startUpdate(void) {
+  unsigned long ms = PANEL_LOAD_MS;
+  if (ctl->updateMode == 0x0F) {
+    ms = ctl->partialMs;
+    panel.partialRefreshes++;
+  } else if (ctl->updateMode & 0x04) {
+    ms = ctl->fullMs;
+    panel.fullRefreshes++;
+  }
+  ctl->busyUntil = now + ms * 1000;
+}
+
+static void writeRam(uint8_t data) {
+  controller* c = ctl;
+  if (c->xPtr < PANEL_ROW_BYTES && c->yPtr < PANEL_ROWS) {
+    c->ram[c->bank][c->yPtr * PANEL_ROW_BYTES + c->xPtr] = data;
+  }
+  panel.ramBytes++;
+  if (++c->xPtr > c->xEnd) {  // Data entry mode 0x03, x then y increment
+    c->xPtr = c->xStart;
+    c->yPtr = c->yPtr >= c->yEnd ? c->yStart : c->yPtr + 1;
+  }
+}
+
+static void receive(uint8_t data) {
+  controller* c = ctl;
+  if (dc == LOW) {
+    c->command = data;
+    c->dataCount = 0;
+    c->bank = c->command == 0x24 ? 0 : c->command == 0x26 ? 1 : -1;
+    readBit = c->command == 0x1B ? 0 : -1;
+    if (c->command == 0x20) {
+      startUpdate();
+    } else if (c->command == 0x44) {
+      panel.windows++;
+    }
+    return;
+  }
+  if (c->bank >= 0) {
+    writeRam(data);
+    return;
+  }
+  if (c->dataCount < 4) {
+    c->args[c->dataCount] = data;
+  }
+  c->dataCount++;
+  switch (c->command) {
+    case 0x22:
+      c->updateMode = data;
+      break;
+    case 0x32:
+      if (c->dataCount <= (int)sizeof(c->lut)) {
+        c->lut[c->dataCount - 1] = data;
+      }
+      if (c->dataCount == (int)sizeof(c->lut)) {
+        c->partialMs = c->partialBaseMs * lutFrames() / PANEL_PARTIAL_FRAMES;
+      }
+      break;
+    case 0x44:
+      if (c->dataCount == 2) {
+        c->xStart = c->args[0];
+        c->xEnd = c->args[1];
+      }
+      break;
+    case 0x45:
+      if (c->dataCount == 4) {
+        c->yStart = c->args[0] | c->args[1] << 8;
+        c->yEnd = c->args[2] | c->args[3] << 8;
+      }
+      break;
+    case 0x4E:
+      c->xPtr = data;
+      break;
+    case 0x4F:
+      if (c->dataCount == 2) {
+        c->yPtr = c->args[0] | c->args[1] << 8;
+      }
+      break;
+  }
+}
+
+void SPIClass::beginTransaction(SPISettings settings) {
+  usPerByte = 8000000UL / settings.clock;
+}
+
+uint8_t SPIClass::transfer(uint8_t data) {
+  now += usPerByte;
+  panel.spiBytes++;
+  receive(data);
+  return 0;
+}
+
+// DMA for epdif.cpp, the bytes land at once but the channel stays
+// busy for as long as they would take to clock out
+void dmaBegin(void) {
+}
+
+void dmaStart(int cs, const unsigned char* data, int length) {
+  for (int i = 0; i < length; i++) {
+    receive(data[i]);
+  }
+  panel.spiBytes += length;
+  panel.dmaBytes += length;
+  dmaUntil = now + (uint64_t)length * usPerByte;
+}
+
+// Polled in a wait loop, so waiting is modelled by jumping to the end
+bool dmaBusy(void) {
+  if (now < dmaUntil) {
+    now = dmaUntil;
+  }
+  return false;
+}
+
+void pinMode(int pin, int mode) {
+}
+
+// Pin I/O on the CPU, in cycles so port writes can take a fraction of a us
+static void spendCycles(unsigned long cycles) {
+  static unsigned long spare;
+  panel.pinCycles += cycles;
+  spare += cycles;
+  now += spare / CPU_MHZ;
+  spare %= CPU_MHZ;
+}
+
+static void pinChange(int pin, int value) {
+  if (pin == PIN_SPI_SCK) {
+    if (sck == LOW && value == HIGH && readBit >= 0) {
+      readBit++;
+    }
+    sck = value;
+    return;
+  }
+  if (pin == EpdBoardPins::DC) {
+    dc = value;
+    return;
+  }
+  for (int n = 0; n < numControllers; n++) {
+    controller* c = &controllers[n];
+    if (pin == c->csPin && value == LOW) {
+      ctl = c;
+    } else if (pin == c->rstPin) {
+      if (c->rst == HIGH && value == LOW) {
+        panel.resets++;
+        c->busyUntil = 0;
+      }
+      c->rst = value;
+    }
+  }
+}
+
+void digitalWrite(int pin, int value) {
+  spendCycles(PIN_WRITE_US * CPU_MHZ);
+  pinChange(pin, value);
+}
+
+void portWrite(int pin, int value) {
+  spendCycles(PORT_WRITE_CYCLES);
+  pinChange(pin, value);
+}
+
+static int pinLevel(int pin) {
+  if (pin == PIN_SPI_MOSI && readBit > 0 && readBit <= 16) {
+    int reg = (panelTemperature * 16) << 4;  // 12 bits, left aligned
+    return (reg >> (16 - readBit)) & 1;
+  }
+  for (int n = 0; n < numControllers; n++) {
+    if (pin == controllers[n].busyPin) {
+      return now < controllers[n].busyUntil ? HIGH : LOW;
+    }
+  }
+  return LOW;
+}
+
+int digitalRead(int pin) {
+  spendCycles(PIN_WRITE_US * CPU_MHZ);
+  return pinLevel(pin);
+}
+
+int portRead(int pin) {
+  spendCycles(PORT_WRITE_CYCLES);
+  return pinLevel(pin);
+}
+
+void delay(unsigned long ms) {
+  now += ms * 1000;
+}
+
+unsigned long millis(void) {
+  return now / 1000;
+}
+
+unsigned long micros(void) {
+  return now;
+}
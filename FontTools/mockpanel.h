@@ -0,0 +1,62 @@
+/*
+  Simulated 2.9" e-paper panels for host benchmarks
+
+  Models SSD1680 controllers as far as the Waveshare driver uses them:
+  the two RAM banks, the memory window and pointer, BUSY after each
+  update, hardware reset, the temperature register and the length of
+  the partial waveform loaded. Time is virtual, SPI bytes take their
+  clock time and delay() and BUSY waits advance it, so the real
+  epd2in9_V2.cpp and epdif.cpp can be timed without hardware. Panels
+  added with panelAdd() share the bus with the first, each with its
+  own CS, reset, BUSY and update durations. DMA transfers (EPD_DMA)
+  run in the background, taking the same time per byte, while the
+  caller accounts for its own work with panelSpend(). Pin I/O costs a
+  digitalWrite(), or a port register access in builds with
+  EPD_PORT_IO, as the driver does on the Nano 33 IoT.
+*/
+
+#ifndef _MOCK_PANEL_H_
+#define _MOCK_PANEL_H_
+
+#include <stdint.h>
+
+#define PANEL_ROW_BYTES 16
+#define PANEL_ROWS 296
+#define PANEL_BYTES (PANEL_ROW_BYTES * PANEL_ROWS)
+#define PANEL_MAX 4  // Controllers on the bus, the first on EpdBoardPins
+
+// Update durations while BUSY is high, in ms
+#define PANEL_FULL_MS 2000
+#define PANEL_PARTIAL_MS 300
+#define PANEL_LOAD_MS 1     // Clock and LUT load only (0x22 0xC0)
+#define PIN_WRITE_US 1      // digitalWrite() or digitalRead() on the SAMD21 core
+#define PORT_WRITE_CYCLES 6 // A port register access at a constant address (EPD_PORT_IO)
+#define CPU_MHZ 48
+#define PANEL_PARTIAL_FRAMES 32  // Frames in the stock partial waveform, taking PANEL_PARTIAL_MS
+
+struct panelStats {
+  unsigned long spiBytes;
+  unsigned long dmaBytes;          // Of those, sent by DMA
+  unsigned long ramBytes;          // Image bytes written to 0x24 or 0x26
+  unsigned long windows;           // Memory windows set (0x44)
+  unsigned long resets;            // Hardware resets
+  unsigned long pinCycles;         // CPU cycles in pin reads and writes
+  unsigned long fullRefreshes;
+  unsigned long partialRefreshes;
+};
+
+extern panelStats panel;
+extern uint8_t panelRam[2][PANEL_BYTES];  // 0x24 then 0x26
+extern int panelTemperature;              // Read back by 0x1B, in C
+
+void panelClearStats(void);
+uint64_t panelMicros(void);  // Virtual time since start
+void panelSpend(uint64_t us);  // CPU work, DMA carries on meanwhile
+void panelPowerCycle(void);    // Power lost, the RAM banks come back as noise
+
+// Another panel on the bus, sharing DC with the first. Returns its
+// number, or -1 if there are PANEL_MAX already.
+int panelAdd(int cs, int rst, int busy, unsigned long fullMs, unsigned long partialMs);
+const uint8_t* panelRamOf(int n, int bank);
+
+#endif
@@ -0,0 +1,147 @@
+/*
+  Refresh time of several panels on one SPI bus, one by one or as a group
+
+  Up to four 2.9" panels share the bus and DC, each with its own reset,
+  CS and BUSY pins and its own refresh durations in mockpanel (one of
+  them an older, slower panel). Each round writes every panel's RAM
+  and refreshes it: a full refresh with a new screen, then a partial
+  with the timestamp strip. One by one, each panel is written and
+  refreshed before the next is touched, as the sketch does with its
+  one panel. As an EpdGroup, each refresh is started as soon as the
+  panel is written, so the refreshes run together. Every panel's RAM
+  is checked against the screen it was sent.
+
+  Usage: make multibench
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "EpdGroup.h"
+#include "epdpaint.h"
+#include "mockpanel.h"
+#include "img/flood_screens.h"
+
+#define COLORED 0
+#define UNCOLORED 1
+#define PANELS 4
+
+static Epd<Panel2in9> epd0;
+static Epd<Panel2in9, EpdPins<2, 7, 9, 3> > epd1;
+static Epd<Panel2in9, EpdPins<15, 7, 10, 16> > epd2;
+static Epd<Panel2in9, EpdPins<17, 7, 21, 20> > epd3;
+
+// Each of the above, for the writes the group does not do
+struct panelOps {
+  void (*init)(void);
+  void (*screen)(const unsigned char* image);
+  void (*strip)(const unsigned char* image, int x, int y, int width, int height);
+  EpdRefresh* refresh;
+};
+
+template <class E>
+static panelOps ops(E* epd) {
+  static E* e = epd;
+  panelOps o = {
+    [] { e->Init(); },
+    [](const unsigned char* image) { e->SetFrameMemory_Base(image); },
+    [](const unsigned char* image, int x, int y, int width, int height) {
+      e->SetFrameMemory_Partial(image, x, y, width, height);
+    },
+    epd,
+  };
+  return o;
+}
+
+static panelOps panels[PANELS];
+static unsigned char image[1024];
+static const unsigned char* screens[PANELS] = { epd_screen_warning, epd_screen_alert, epd_screen_severe,
+                                                 epd_screen_removed };
+
+static void drawStrip(Paint* paint) {
+  paint->SetRotate(ROTATE_180);
+  paint->Clear(UNCOLORED);
+  paint->DrawStringAt(0, 0, "2022-12-19 15:20", &Font12, COLORED);
+  paint->DrawStringAt(0, 14, "12 min ago", &Font12, COLORED);
+}
+
+// Write and refresh n panels, returning the wall time in ms
+static double fullRound(int n, EpdGroup* group) {
+  uint64_t start = panelMicros();
+  for (int i = 0; i < n; i++) {
+    if (group) {
+      group->wait(i);
+    }
+    panels[i].init();
+    panels[i].screen(screens[i]);
+    if (group) {
+      group->start(i, false);
+    } else {
+      panels[i].refresh->StartFrame();
+      panels[i].refresh->FinishFrame();
+    }
+  }
+  if (group) {
+    group->finish();
+  }
+  return (panelMicros() - start) / 1e3;
+}
+
+static double partialRound(int n, EpdGroup* group) {
+  Paint paint(image, 120, 40);
+  drawStrip(&paint);
+  uint64_t start = panelMicros();
+  for (int i = 0; i < n; i++) {
+    if (group) {
+      group->wait(i);
+    }
+    panels[i].strip(paint.GetImage(), 0, 20, paint.GetWidth(), paint.GetHeight());
+    if (group) {
+      group->start(i, true);
+    } else {
+      panels[i].refresh->StartFrame_Partial();
+      panels[i].refresh->FinishFrame();
+    }
+  }
+  if (group) {
+    group->finish();
+  }
+  return (panelMicros() - start) / 1e3;
+}
+
+int main() {
+  panels[0] = ops(&epd0);
+  panels[1] = ops(&epd1);
+  panels[2] = ops(&epd2);
+  panels[3] = ops(&epd3);
+  panelAdd(9, 2, 3, PANEL_FULL_MS, PANEL_PARTIAL_MS);
+  panelAdd(10, 15, 16, PANEL_FULL_MS * 3 / 2, PANEL_PARTIAL_MS * 3 / 2);  // Older panel
+  panelAdd(21, 17, 20, PANEL_FULL_MS, PANEL_PARTIAL_MS);
+
+  int bad = 0;
+  printf("Panels   full, one by one  as a group    partial, one by one  as a group\n");
+  for (int n = 1; n <= PANELS; n++) {
+    EpdGroup group;
+    for (int i = 0; i < n; i++) {
+      group.add(panels[i].refresh);
+    }
+    double fullAlone = fullRound(n, NULL);
+    double partialAlone = partialRound(n, NULL);
+    double fullGroup = fullRound(n, &group);
+    double partialGroup = partialRound(n, &group);
+    printf("%4d     %10.0f ms  %8.0f ms   %12.0f ms  %8.0f ms\n", n, fullAlone, fullGroup, partialAlone, partialGroup);
+
+    // The screen everywhere but the strip
+    for (int i = 0; i < n; i++) {
+      const uint8_t* ram = panelRamOf(i, 0);
+      for (int row = 0; row < PANEL_ROWS; row++) {
+        if ((row < 20 || row >= 60) &&
+            memcmp(&ram[row * PANEL_ROW_BYTES], &screens[i][row * PANEL_ROW_BYTES], PANEL_ROW_BYTES) != 0) {
+          bad++;
+          break;
+        }
+      }
+    }
+  }
+  printf("Panel RAM %s\n", bad ? "DIFFERS" : "matches on every panel");
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+/*
+  OTA update through otaUpdate(), with saved settings in flash
+
+  Runs the sketches' FloodOTA, PatchApplier and ConfigStore against the
+  RAM flash of shim/FlashStorage.h, with shim/WiFiNINA.h serving the
+  patch and shim/InternalStorage.h staging and installing it as
+  ArduinoOTA does. Before each update the running image is at the
+  sketch start and a config record has been saved. Patches are made and
+  signed by FloodGateway/floodpatch, as for a release.
+
+  A good patch must install the new image and leave the config record
+  loadable, including for an image of the largest size allowed. Patches
+  signed with another key, tampered with, made for another image or too
+  big must leave both the running image and the record untouched, as
+  must a device with no key.
+
+  Usage: make otatest
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <FlashStorage.h>
+#include <InternalStorage.h>
+#include <WiFiNINA.h>
+#include "ConfigStore.h"
+#include "FloodOTA.h"
+
+#define FLOODPATCH "../FloodGateway/floodpatch"
+#define IMAGE_LEN 100000
+#define KEY "00112233445566778899aabbccddeeff0123456789abcdef0123456789abcdef"
+#define OTHER_KEY "ffeeddccbbaa99887766554433221100fedcba9876543210fedcba9876543210"
+#define VERSION "0.5.2"
+
+class QuietStream : public Stream {
+public:
+  std::string last;  // Last line printed
+  void write(const char* s) {
+    if (strcmp(s, "\r\n") != 0) {
+      last = s;
+    }
+  }
+};
+
+static QuietStream console;
+Stream& Serial = console;
+InternalStorageClass InternalStorage;
+
+void delay(unsigned long ms) {}
+
+struct deviceConfig {
+  char area[24];
+  uint32_t alertInterval;
+};
+
+static const configField fields[] = {
+  CONFIG_FIELD(CFG_STR, area),
+  CONFIG_FIELD(CFG_U32, alertInterval),
+};
+
+static deviceConfig config;
+static ConfigStore configStore(&config, sizeof(config), 1, fields, sizeof(fields) / sizeof(fields[0]));
+
+typedef std::vector<uint8_t> bytes;
+
+static uint32_t rng = 2022;
+
+static uint8_t nextByte(void) {
+  rng = rng * 1103515245 + 12345;
+  return rng >> 16;
+}
+
+// Code-like bytes followed by a large block that repeats, as fonts do
+static bytes makeImage(size_t len) {
+  bytes image;
+  for (size_t i = 0; i < len; i++) {
+    image.push_back(i < len / 3 ? nextByte() : (uint8_t)(i * 7 / 5));
+  }
+  return image;
+}
+
+// A release: some code changed, some inserted
+static bytes release(const bytes& running, size_t len) {
+  bytes next(running.begin(), running.begin() + 5000);
+  for (int i = 0; i < 300; i++) {
+    next.push_back(nextByte());
+  }
+  next.insert(next.end(), running.begin() + 5000, running.end());
+  for (size_t i = 20000; i < 22000; i++) {
+    next[i] = nextByte();
+  }
+  next.resize(len, 0x11);
+  return next;
+}
+
+static std::string dir;
+
+static bool writeFile(const std::string& path, const void* data, size_t len) {
+  FILE* f = fopen(path.c_str(), "wb");
+  bool ok = f && fwrite(data, 1, len, f) == len;
+  return f && fclose(f) == 0 && ok;
+}
+
+static std::string readFile(const std::string& path) {
+  std::string data;
+  FILE* f = fopen(path.c_str(), "rb");
+  char buf[4096];
+  size_t n;
+  while (f && (n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    data.append(buf, n);
+  }
+  if (f) {
+    fclose(f);
+  }
+  return data;
+}
+
+static std::string makePatch(const bytes& from, const bytes& to, const char* key) {
+  std::string cmd = FLOODPATCH " diff " + dir + "/key " + dir + "/old.bin " + dir + "/new.bin " + dir + "/patch > /dev/null";
+  if (!writeFile(dir + "/key", key, strlen(key)) || !writeFile(dir + "/old.bin", from.data(), from.size())
+      || !writeFile(dir + "/new.bin", to.data(), to.size()) || system(cmd.c_str()) != 0) {
+    printf("FAIL floodpatch diff\n");
+    exit(1);
+  }
+  return readFile(dir + "/patch");
+}
+
+// Running image at the sketch start and a saved record
+static void boot(const bytes& running) {
+  memset(flashMemory(), 0xFF, FLASH_SIZE);
+  memcpy(flashMemory() + OTA_IMAGE_START, running.data(), running.size());
+  strcpy(config.area, "061FWF10Witney");
+  config.alertInterval = 600000;
+  configStore.save();
+  InternalStorage.applied = false;
+}
+
+static bool configKept(void) {
+  memset(&config, 0, sizeof(config));
+  return configStore.load() == 1 && strcmp(config.area, "061FWF10Witney") == 0 && config.alertInterval == 600000;
+}
+
+static bool imageIs(const bytes& image) {
+  return memcmp(flashMemory() + OTA_IMAGE_START, image.data(), image.size()) == 0;
+}
+
+static int update(const std::string& patch, const char* key) {
+  WiFiClient::response() = "HTTP/1.0 200 OK\r\nContent-Type: application/octet-stream\r\n\r\n" + patch;
+  return otaUpdate("192.168.1.10", 8000, "magnet", VERSION, key);
+}
+
+// Installed, and the record still loads
+static int installs(const char* name, const bytes& running, const bytes& next, const std::string& patch) {
+  boot(running);
+  update(patch, KEY);
+  std::string reason = console.last;
+  bool ok = InternalStorage.applied && imageIs(next) && configKept();
+  printf("%-13s %6zu byte patch, %6zu byte image, %s\n", name, patch.size(), next.size(),
+         ok ? "installed, config kept" : "FAIL");
+  if (!ok) {
+    printf("FAIL %s: %s\n", name, reason.c_str());
+  }
+  return ok ? 0 : 1;
+}
+
+// Refused, nothing changed
+static int refused(const char* name, const bytes& running, const std::string& patch, const char* key) {
+  boot(running);
+  int result = update(patch, key);
+  std::string reason = console.last;
+  bool ok = result == -1 && !InternalStorage.applied && imageIs(running) && configKept();
+  printf("%-13s refused, %s\n", name, reason.c_str());
+  if (!ok) {
+    printf("FAIL %s was installed or changed flash\n", name);
+  }
+  return ok ? 0 : 1;
+}
+
+int main() {
+  char tmp[] = "/tmp/otatestXXXXXX";
+  if (!mkdtemp(tmp)) {
+    perror("mkdtemp");
+    return 1;
+  }
+  dir = tmp;
+
+  bytes running = makeImage(IMAGE_LEN);
+  bytes next = release(running, IMAGE_LEN + 300);
+  std::string patch = makePatch(running, next, KEY);
+  int bad = installs("Update", running, next, patch);
+
+  std::string request = WiFiClient::request();
+  std::string want = "GET /firmware/magnet-" VERSION ".patch HTTP/1.0\r\n";
+  if (request.compare(0, want.size(), want) != 0) {
+    printf("FAIL request was %s\n", request.c_str());
+    bad++;
+  }
+
+  bytes largest = release(running, OTA_MAX_LEN);
+  bad += installs("Largest", running, largest, makePatch(running, largest, KEY));
+
+  bad += refused("Other key", running, makePatch(running, next, OTHER_KEY), KEY);
+  std::string tampered = patch;
+  tampered[tampered.size() / 2] ^= 0x01;
+  bad += refused("Tampered", running, tampered, KEY);
+  std::string badTag = patch;
+  badTag[badTag.size() - 1] ^= 0x80;
+  bad += refused("Bad tag", running, badTag, KEY);
+  bad += refused("Unsigned", running, patch.substr(0, patch.size() - HMAC_LEN), KEY);
+  bytes other = running;
+  other[1234] ^= 0xFF;
+  bad += refused("Other image", other, patch, KEY);
+  bytes tooBig = release(running, OTA_MAX_LEN + 1);
+  bad += refused("Too big", running, makePatch(running, tooBig, KEY), KEY);
+  bad += refused("No key", running, patch, "");
+
+  boot(running);
+  WiFiClient::response() = "HTTP/1.0 404 Not Found\r\n\r\n";
+  int result = otaUpdate("192.168.1.10", 8000, "magnet", VERSION, KEY);
+  printf("%-13s %s\n", "No release", result == 0 && imageIs(running) ? "nothing to do" : "FAIL");
+  bad += result != 0;
+
+  system(("rm -rf " + dir).c_str());
+  return bad ? 1 : 0;
+}
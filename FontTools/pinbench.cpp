@@ -0,0 +1,68 @@
+/*
+  CPU cycles in the driver's pin I/O, digitalWrite() against port writes
+
+  Runs the driver's common operations through mockpanel: Init(), a
+  full screen upload, the timestamp strip and a clear. Built twice by
+  make, once with pins written through digitalWrite() and once with
+  EPD_PORT_IO, which on the Nano 33 IoT turns each write of a pin from
+  the Epd pin map into one store to a port register. The mock charges
+  PIN_WRITE_US for a digitalWrite() and PORT_WRITE_CYCLES for a port
+  access, and each SPI byte its clock time, so the cycles are a model
+  of the SAMD21, not a measurement.
+
+  Usage: make pinbench
+*/
+
+#include <stdio.h>
+#include "epd2in9_V2.h"
+#include "epdpaint.h"
+#include "mockpanel.h"
+#include "img/flood_screens.h"
+
+#define COLORED 0
+#define UNCOLORED 1
+
+static Epd<Panel2in9> epd;
+static unsigned char image[1024];
+
+static uint64_t start;
+
+static void begin(void) {
+  panelClearStats();
+  start = panelMicros();
+}
+
+static void report(const char* name) {
+  unsigned long spiCycles = panel.spiBytes * 4 * CPU_MHZ;
+  printf("  %-8s %5lu SPI bytes, %7lu cycles in pin I/O, %4lu per byte sent, %6.1f ms\n", name, panel.spiBytes,
+         panel.pinCycles, (panel.pinCycles + spiCycles) / panel.spiBytes, (panelMicros() - start) / 1e3);
+}
+
+int main() {
+#ifdef EPD_PORT_IO
+  printf("Port writes:\n");
+#else
+  printf("digitalWrite():\n");
+#endif
+  begin();
+  epd.Init();
+  report("init");
+
+  begin();
+  epd.SetFrameMemory_Base(epd_screen_warning);
+  report("screen");
+
+  Paint paint(image, 120, 40);
+  paint.SetRotate(ROTATE_180);
+  paint.Clear(UNCOLORED);
+  paint.DrawStringAt(0, 0, "2022-12-19 15:20", &Font12, COLORED);
+  paint.DrawStringAt(0, 14, "12 min ago", &Font12, COLORED);
+  begin();
+  epd.SetFrameMemory_Partial(paint.GetImage(), 0, 20, paint.GetWidth(), paint.GetHeight());
+  report("strip");
+
+  begin();
+  epd.ClearFrameMemory(0xFF);
+  report("clear");
+  return 0;
+}
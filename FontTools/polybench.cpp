@@ -0,0 +1,281 @@
+/*
+  PolygonLocator, checked against a reference and timed
+
+  Builds a flood area GeoJSON body the way the polygon endpoint sends
+  one: a FeatureCollection with properties before the geometry, and a
+  MultiPolygon of a ragged outline with lakes cut out of it and a
+  detached island, written to 15 decimal places. It is about 3 MB. Sites
+  scattered over the bounding box are located by streaming the body
+  through PolygonLocator in the 64 byte reads checkArea() uses. Each
+  answer is checked against an even-odd test over the vertices held in
+  memory. A few sites are repeated with reads of other sizes, down to
+  one byte. Small bodies cover strings that hold "coordinates",
+  exponents and a Polygon with no MultiPolygon around it.
+
+  Reports bytes/s parsed on the host and, scaled by CPU_SCALE, on the
+  SAMD21. Peak memory is the locator and the read buffer, and the run
+  checks that nothing is allocated while parsing.
+
+  Usage: make polybench
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <new>
+#include <string>
+#include <vector>
+#include "FloodPolygon.h"
+
+#define CPU_SCALE 60
+#define READ_LEN 64           // checkArea()'s buffer
+#define SITES 200
+#define OUTLINE_POINTS 60000
+#define LAKES 40
+#define LAKE_POINTS 400
+#define ISLAND_POINTS 2000
+#define MIN_SAMD_RATE 100000  // Bytes/s, well above what the TLS link delivers
+#define MAX_LOCATOR_BYTES 128
+
+static const geoPoint CENTRE = { 51300000, -1800000 };  // Wiltshire
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+  allocations++;
+  void* p = malloc(size);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+static uint32_t rng = 12345;
+
+static uint32_t nextRandom(void) {
+  rng = rng * 1103515245 + 12345;
+  return rng >> 8;
+}
+
+typedef std::vector<geoPoint> ring;
+
+// Closed ring round a centre, radius wandering between rMin and rMax
+static ring makeRing(geoPoint centre, int points, int rMin, int rMax) {
+  ring r;
+  int radius = (rMin + rMax) / 2;
+  for (int i = 0; i < points; i++) {
+    radius += (int)(nextRandom() % 2001) - 1000;
+    radius = radius < rMin ? rMin : radius > rMax ? rMax : radius;
+    double a = i * 2 * M_PI / points;
+    r.push_back({ centre.lat + (int32_t)(radius * sin(a)), centre.lon + (int32_t)(radius * 1.6 * cos(a)) });
+  }
+  r.push_back(r[0]);
+  return r;
+}
+
+// Microdegrees as the API writes them, digits past the sixth are noise
+static void putCoord(std::string* out, int32_t v) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%s%d.%06d%09u", v < 0 ? "-" : "", abs(v) / 1000000, abs(v) % 1000000,
+           nextRandom() % 1000000000);
+  out->append(buf);
+}
+
+static void putRing(std::string* out, const ring& r) {
+  out->append("[");
+  for (size_t i = 0; i < r.size(); i++) {
+    out->append(i ? ",[" : "[");
+    putCoord(out, r[i].lon);
+    out->append(",");
+    putCoord(out, r[i].lat);
+    out->append("]");
+  }
+  out->append("]");
+}
+
+struct area {
+  std::vector<std::vector<ring> > polygons;  // Outer ring then holes
+  std::string body;
+};
+
+static area makeArea(void) {
+  area a;
+  std::vector<ring> main;
+  main.push_back(makeRing(CENTRE, OUTLINE_POINTS, 30000, 60000));
+  for (int i = 0; i < LAKES; i++) {
+    double t = i * 2 * M_PI / LAKES;
+    geoPoint c = { CENTRE.lat + (int32_t)(18000 * sin(t)), CENTRE.lon + (int32_t)(28000 * cos(t)) };
+    main.push_back(makeRing(c, LAKE_POINTS, 1500, 3000));
+  }
+  a.polygons.push_back(main);
+  std::vector<ring> island;
+  island.push_back(makeRing({ CENTRE.lat + 80000, CENTRE.lon + 90000 }, ISLAND_POINTS, 8000, 12000));
+  a.polygons.push_back(island);
+
+  a.body = "{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{"
+           "\"AREA\":\"Wessex\",\"FWS_TACODE\":\"062WAF28UpAvon\",\"LA_NAME\":\"Wiltshire\","
+           "\"DESCRIP\":\"River Avon \\\"coordinates\\\": [1,2] upper reaches\",\"QDIAL\":\"210034\","
+           "\"RIVER_SEA\":\"River Avon\",\"area_km2\":1.25e2},\"geometry\":{\"type\":\"MultiPolygon\","
+           "\"coordinates\":[";
+  for (size_t p = 0; p < a.polygons.size(); p++) {
+    a.body.append(p ? ",[" : "[");
+    for (size_t r = 0; r < a.polygons[p].size(); r++) {
+      if (r) {
+        a.body.append(",");
+      }
+      putRing(&a.body, a.polygons[p][r]);
+    }
+    a.body.append("]");
+  }
+  a.body.append("]}}]}\n");
+  return a;
+}
+
+// Even-odd over every ring, from the vertices
+static bool reference(const area& a, geoPoint s) {
+  bool inside = false;
+  for (const std::vector<ring>& polygon : a.polygons) {
+    for (const ring& r : polygon) {
+      for (size_t i = 1; i < r.size(); i++) {
+        geoPoint p = r[i - 1], q = r[i];
+        if ((p.lat > s.lat) != (q.lat > s.lat)) {
+          long double x = p.lon + (long double)(s.lat - p.lat) * (q.lon - p.lon) / (q.lat - p.lat);
+          inside ^= s.lon < x;
+        }
+      }
+    }
+  }
+  return inside;
+}
+
+static bool locate(const std::string& body, geoPoint site, size_t chunk, PolygonLocator* locator) {
+  locator->begin(site);
+  for (size_t i = 0; i < body.size(); i += chunk) {
+    locator->feed(body.data() + i, body.size() - i < chunk ? body.size() - i : chunk);
+  }
+  return locator->valid() && locator->contains();
+}
+
+struct smallCase {
+  const char* name;
+  const char* body;
+  bool valid;
+  bool inside;
+};
+
+// Site (0, 0), a 2 x 2 degree square round it
+static const smallCase smallCases[] = {
+  { "Polygon", "{\"type\":\"Polygon\",\"coordinates\":[[[-1,-1],[1,-1],[1,1],[-1,1],[-1,-1]]]}", true, true },
+  { "outside", "{\"coordinates\":[[[1,1],[3,1],[3,3],[1,3],[1,1]]]}", true, false },
+  { "hole", "{\"coordinates\":[[[-1,-1],[1,-1],[1,1],[-1,1],[-1,-1]],"
+            "[[-0.5,-0.5],[0.5,-0.5],[0.5,0.5],[-0.5,0.5],[-0.5,-0.5]]]}", true, false },
+  { "exponents", "{\"coordinates\":[[[-1.0e0,-1E0],[1.0e+0,-1],[1,1],[-1,1],[-1,-1]]]}", true, true },
+  { "spaced", "{ \"coordinates\" :\n [ [ [ -1 , -1 ] ,\r\n [ 1 , -1 ] , [ 1 , 1 ] , [ -1 , 1 ] ] ] }", true, true },
+  { "string key", "{\"name\":\"coordinates\",\"x\":[[1,1],[2,2],[3,1]]}", false, false },
+  { "escaped", "{\"name\":\"a \\\"coordinates\\\": [[[0,0],[1,0],[1,1]]]\"}", false, false },
+  { "no polygon", "{\"items\":[]}", false, false },
+};
+
+static int checkSmall(void) {
+  int n = sizeof(smallCases) / sizeof(smallCases[0]);
+  int bad = 0;
+  PolygonLocator locator;
+  for (int i = 0; i < n; i++) {
+    const smallCase& c = smallCases[i];
+    locate(c.body, { 0, 0 }, 3, &locator);
+    if (locator.valid() != c.valid || (c.valid && locator.contains() != c.inside)) {
+      printf("FAIL %s: valid %d inside %d, want %d %d\n", c.name, locator.valid(), locator.contains(), c.valid, c.inside);
+      bad++;
+    }
+  }
+  printf("Small bodies  %d cases, %d wrong\n", n, bad);
+  return bad;
+}
+
+int main() {
+  int bad = checkSmall();
+  area a = makeArea();
+  geoPoint lo = { CENTRE.lat - 70000, CENTRE.lon - 110000 };
+  geoPoint hi = { CENTRE.lat + 95000, CENTRE.lon + 110000 };
+  std::vector<geoPoint> sites;
+  for (int i = 0; i < SITES; i++) {
+    sites.push_back({ lo.lat + (int32_t)(nextRandom() % (hi.lat - lo.lat)), lo.lon + (int32_t)(nextRandom() % (hi.lon - lo.lon)) });
+  }
+
+  PolygonLocator locator;
+  int wrong = 0, inside = 0;
+  size_t before = allocations;
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (const geoPoint& s : sites) {
+    bool got = locate(a.body, s, READ_LEN, &locator);
+    inside += got;
+    wrong += got != reference(a, s);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  size_t parseAllocations = allocations - before;
+  double secs = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+  // Reference time is in there too, take it out
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  volatile int sink = 0;
+  for (const geoPoint& s : sites) {
+    sink = sink + reference(a, s);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  secs -= (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  double rate = (double)a.body.size() * SITES / secs;
+
+  static const size_t chunks[] = { 1, 7, 1000, 65536 };
+  int chunkWrong = 0;
+  for (size_t c : chunks) {
+    for (int i = 0; i < 5; i++) {
+      chunkWrong += locate(a.body, sites[i], c, &locator) != reference(a, sites[i]);
+    }
+  }
+
+  size_t points = 0;
+  for (const std::vector<ring>& polygon : a.polygons) {
+    for (const ring& r : polygon) {
+      points += r.size();
+    }
+  }
+  size_t peak = sizeof(PolygonLocator) + READ_LEN;
+  printf("Polygon       %zu bytes, %zu points in %u rings, %u points found\n", a.body.size(), points,
+         (unsigned)(a.polygons[0].size() + a.polygons[1].size()), locator.points());
+  printf("Sites         %d located, %d inside, %d wrong, %d wrong with other read sizes\n", SITES, inside, wrong,
+         chunkWrong);
+  printf("Rate          %.1f MB/s on the host, %.0f KB/s on the SAMD21, %.1f s for this polygon\n", rate / 1e6,
+         rate / CPU_SCALE / 1e3, a.body.size() * CPU_SCALE / rate);
+  printf("Memory        %zu bytes peak, locator %zu and read buffer %d, %zu allocations while parsing\n", peak,
+         sizeof(PolygonLocator), READ_LEN, parseAllocations);
+
+  if (wrong || chunkWrong) {
+    printf("FAIL %d sites located wrongly\n", wrong + chunkWrong);
+    bad++;
+  }
+  if (locator.points() != points) {
+    printf("FAIL %u points parsed, want %zu\n", locator.points(), points);
+    bad++;
+  }
+  if (!inside || inside == SITES) {
+    printf("FAIL sites all on one side\n");
+    bad++;
+  }
+  if (rate / CPU_SCALE < MIN_SAMD_RATE) {
+    printf("FAIL %.0f KB/s on the SAMD21, want at least %d\n", rate / CPU_SCALE / 1e3, MIN_SAMD_RATE / 1000);
+    bad++;
+  }
+  if (parseAllocations || sizeof(PolygonLocator) > MAX_LOCATOR_BYTES) {
+    printf("FAIL locator uses %zu bytes and %zu allocations, want at most %d and none\n", sizeof(PolygonLocator),
+           parseAllocations, MAX_LOCATOR_BYTES);
+    bad++;
+  }
+  return bad ? 1 : 0;
+}
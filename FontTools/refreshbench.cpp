@@ -0,0 +1,195 @@
+/*
+  Full against partial refreshes over a month of Magnet updates
+
+  Replays a month of flood warnings, API outages and river level
+  polls through the sketch's loop timing: a poll every 15 minutes
+  with a chart column each, the relative age ticking over, and a
+  redraw whenever the debounced warning changes or is re-issued. The
+  display calls are counted as the code did before RefreshPolicy
+  (every updateDisplay() clears the screen and refreshes it in full
+  twice, everything else is partial however long it runs) and through
+  the sketch's RefreshPolicy with the limits in magnet_config.h. Panel
+  time uses the update durations of mockpanel.
+
+  Usage: make refreshbench
+*/
+
+#include <stdio.h>
+#include "RefreshPolicy.h"
+#include "FloodTime.h"
+#include "mockpanel.h"
+#include "magnet_config.h"
+
+#define MONTH_DAYS 30
+#define POLL_MINUTES 15
+#define SCREEN_AREA (128 * 296UL)
+#define STRIP_AREA (120 * 40UL)
+#define COLUMN_AREA (8 * 24UL)   // One chart column, LevelChart::addLatest
+#define CHART_AREA (120 * 24UL)  // Whole chart when it rescales
+#define RESCALE_POLLS 32         // Polls between chart rescales
+
+// Severity levels as FloodStates.h
+enum { NONE, SEVERE_FLOOD_WARNING, FLOOD_WARNING, FLOOD_ALERT, NO_LONGER };
+
+// What the API reports from a time on, in minutes into the month.
+// A new raised time with the same severity is a re-issued warning.
+struct event {
+  int minute;
+  int severity;  // -1 for the API failing until the next event
+};
+
+#define AT(day, hour, min) (((day) * 24 + (hour)) * 60 + (min))
+
+static const event events[] = {
+  { AT(0, 0, 0), NONE },
+  { AT(3, 7, 20), FLOOD_ALERT },
+  { AT(3, 19, 5), FLOOD_ALERT },
+  { AT(4, 6, 40), FLOOD_WARNING },
+  { AT(4, 9, 0), -1 },
+  { AT(4, 10, 30), FLOOD_WARNING },
+  { AT(4, 21, 15), SEVERE_FLOOD_WARNING },
+  { AT(5, 9, 15), SEVERE_FLOOD_WARNING },
+  { AT(5, 20, 45), FLOOD_WARNING },
+  { AT(6, 8, 30), FLOOD_WARNING },
+  { AT(6, 18, 0), NO_LONGER },
+  { AT(8, 12, 0), NONE },
+  { AT(12, 2, 0), -1 },
+  { AT(12, 3, 30), NONE },
+  { AT(17, 15, 10), FLOOD_ALERT },
+  { AT(18, 3, 10), FLOOD_ALERT },
+  { AT(18, 14, 50), FLOOD_ALERT },
+  { AT(19, 16, 0), NO_LONGER },
+  { AT(21, 9, 0), NONE },
+  { AT(26, 22, 0), -1 },
+  { AT(27, 1, 0), NONE },
+};
+
+struct counts {
+  unsigned long updates;  // updateDisplay() calls
+  unsigned long full;
+  unsigned long partial;
+  unsigned long busyMs;
+};
+
+// The display as before RefreshPolicy, or with one
+class Display {
+public:
+  Display(RefreshPolicy* policy) : _policy(policy) {}
+  counts count = { 0, 0, 0, 0 };
+
+  void updateDisplay(int severity, unsigned long now) {
+    count.updates++;
+    uint32_t area = 2 * STRIP_AREA + CHART_AREA;  // Timestamp, status and chart
+    if (!_policy) {
+      count.full += 2;  // Cleared to white then the screen
+      count.busyMs += 2 * PANEL_FULL_MS + 500;
+    } else if (_policy->fullDue(severity, now)) {
+      count.full++;
+      count.busyMs += PANEL_FULL_MS;
+      _policy->fullDone(severity, now);
+    } else if (_overdrawn) {
+      area += SCREEN_AREA;
+    }
+    _overdrawn = false;
+    partial(area, now);
+  }
+
+  void updateAge(int severity, unsigned long now) {
+    if (_policy && _policy->fullDue(severity, now)) {
+      updateDisplay(severity, now);
+      return;
+    }
+    partial(STRIP_AREA, now);
+  }
+
+  void updateChart(int severity, bool rescale, unsigned long now) {
+    if (_policy && _policy->fullDue(severity, now)) {
+      updateDisplay(severity, now);
+      return;
+    }
+    partial(rescale ? CHART_AREA : COLUMN_AREA, now);
+  }
+
+  void apiError(unsigned long now) {
+    partial(3 * 120 * 32UL, now);
+    _overdrawn = true;
+  }
+
+private:
+  RefreshPolicy* _policy;
+  bool _overdrawn = false;
+
+  void partial(uint32_t area, unsigned long now) {
+    count.partial++;
+    count.busyMs += PANEL_PARTIAL_MS;
+    if (_policy) {
+      _policy->partialDone(area, now);
+    }
+  }
+};
+
+static void replay(Display* display) {
+  const int numEvents = sizeof(events) / sizeof(events[0]);
+  int next = 0;
+  int reported = NONE;
+  uint32_t reportedRaised = 0;
+  bool failing = false;
+  int shown = -1;
+  uint32_t shownRaised = 0;
+  unsigned long lastAge = 0;
+  unsigned long polls = 0;
+
+  for (int minute = 0; minute < MONTH_DAYS * 24 * 60; minute++) {
+    unsigned long now = minute * 60000UL;
+    while (next < numEvents && events[next].minute <= minute) {
+      failing = events[next].severity < 0;
+      if (!failing) {
+        reported = events[next].severity;
+        reportedRaised = events[next].minute * 60UL;
+      }
+      next++;
+    }
+
+    if (minute % POLL_MINUTES == 0) {
+      if (failing) {
+        display->apiError(now);
+      } else {
+        if (reported != shown || reportedRaised != shownRaised) {
+          shown = reported;
+          shownRaised = reportedRaised;
+          display->updateDisplay(shown, now);
+          lastAge = now;
+        }
+        display->updateChart(shown, ++polls % RESCALE_POLLS == 0, now);
+      }
+    }
+
+    uint32_t interval = ageRefreshInterval(minute * 60UL - shownRaised);
+    if (now - lastAge > interval * 1000UL) {
+      display->updateAge(shown, now);
+      lastAge = now;
+    }
+  }
+}
+
+static void report(const char* name, const counts& c) {
+  printf("%-7s %3lu redraws, %4lu full + %5lu partial refreshes, %6.0f s busy\n", name, c.updates, c.full, c.partial,
+         c.busyMs / 1e3);
+}
+
+int main() {
+  Display today(NULL);
+  replay(&today);
+
+  RefreshPolicy policy(REFRESH_MAX_PARTIALS, REFRESH_MAX_AREA, REFRESH_IDLE);
+  Display managed(&policy);
+  replay(&managed);
+
+  printf("%d days, %d warning events\n", MONTH_DAYS, (int)(sizeof(events) / sizeof(events[0])));
+  report("today", today.count);
+  report("policy", managed.count);
+  printf("policy counters: %lu full, %lu partial, %u partials and %lu px since the last full\n",
+         (unsigned long)policy.fullRefreshes(), (unsigned long)policy.partialRefreshes(), policy.partials(),
+         (unsigned long)policy.area());
+  return 0;
+}
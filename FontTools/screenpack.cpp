@@ -0,0 +1,132 @@
+/*
+  Composite the Magnet's severity screens
+
+  Each display template's background from FloodMagnetController/img
+  has its static text (the warning message and "Updated") drawn over it
+  exactly as the sketch used to at run time: the text is drawn into
+  strips with the sketch's Paint and the strips are copied into a
+  model of the panel RAM the way SetFrameMemory_Partial writes them.
+  The finished screens are written as one header, so the sketch only
+  streams a screen and patches in the timestamp, status and chart.
+
+  The SPI bytes and text rendering time each severity change no longer
+  needs are reported on stderr.
+
+  Usage: screenpack > ../FloodMagnetController/img/flood_screens.h
+
+  Copyright 2022 Peter Milne
+  Released under GNU GENERAL PUBLIC LICENSE
+  Version 3, 29 June 2007
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <avr/pgmspace.h>
+#include "epdpaint.h"
+#include "img/flood_warning_removed.h"
+#include "img/flood_warning_severe.h"
+#include "img/flood_warning.h"
+#include "img/flood_alert.h"
+
+#define EPD_WIDTH 128
+#define EPD_HEIGHT 296
+#define FRAME_BYTES (EPD_WIDTH / 8 * EPD_HEIGHT)
+#define COLORED 0
+#define UNCOLORED 1
+#define REPEATS 1000
+
+// Message area above the chart, panel rows MESSAGE_Y up to MESSAGE_Y + MESSAGE_HEIGHT
+#define MESSAGE_Y 104
+#define MESSAGE_HEIGHT 56
+#define MESSAGE_WIDTH 120
+
+// Static text of each template, see levelTemplate() in FloodAPI.h
+struct screen {
+  const char* name;
+  const unsigned char* background;
+  const char* message;  // Wrapped and centred to fit the message area
+};
+
+static const screen screens[5] = {
+  { "no_warnings", epd_flood_warning_removed, "No Flood Warnings" },
+  { "severe", epd_flood_warning_severe, "DANGER TO LIFE" },
+  { "warning", epd_flood_warning, "Flooding is Expected" },
+  { "alert", epd_flood_alert, "Flooding is Possible" },
+  { "removed", epd_flood_warning_removed, "Warning no Longer in Force" },
+};
+
+static unsigned char frame[FRAME_BYTES];
+static unsigned char image[1024];  // Same size as the sketch's strip canvas
+static long partialBytes;
+
+// SetFrameMemory_Partial into the model of panel RAM
+static void writePartial(const unsigned char* buffer, int x, int y, int width, int height) {
+  x &= 0xF8;
+  width &= 0xF8;
+  int x_end = x + width >= EPD_WIDTH ? EPD_WIDTH - 1 : x + width - 1;
+  int y_end = y + height >= EPD_HEIGHT ? EPD_HEIGHT - 1 : y + height - 1;
+  for (int j = 0; j < y_end - y + 1; j++) {
+    for (int i = 0; i < (x_end - x + 1) / 8; i++) {
+      frame[(y + j) * (EPD_WIDTH / 8) + x / 8 + i] = buffer[i + j * (width / 8)];
+    }
+  }
+  partialBytes += (x_end - x + 1) / 8 * (y_end - y + 1);
+}
+
+// The static part of FloodMagnetDisplay::updateDisplay, as it was drawn on the device
+static void drawStaticText(const screen& s) {
+  Paint paint(image, 0, 0);
+
+  // Warning message, in a band sized to its lines and centred in the area
+  int lineHeight = Font16.Height + LINE_SPACING;
+  int lines = paint.CountLines(s.message, &Font16, MESSAGE_WIDTH);
+  if (lines * lineHeight - LINE_SPACING > MESSAGE_HEIGHT) {
+    lines = (MESSAGE_HEIGHT + LINE_SPACING) / lineHeight;
+  }
+  int height = lines * lineHeight - LINE_SPACING;
+  paint.SetWidth(MESSAGE_WIDTH);
+  paint.SetHeight(height);
+  paint.SetRotate(ROTATE_180);
+  paint.Clear(UNCOLORED);
+  paint.DrawStringCentred(0, 0, MESSAGE_WIDTH, s.message, &Font16, COLORED);
+  writePartial(paint.GetImage(), 0, MESSAGE_Y + (MESSAGE_HEIGHT - height) / 2, paint.GetWidth(), paint.GetHeight());
+
+  paint.SetWidth(120);
+  paint.SetHeight(40);
+  paint.Clear(UNCOLORED);
+  paint.DrawStringAt(0, 0, "Updated", &Font16, COLORED);
+  writePartial(paint.GetImage(), 0, 40, paint.GetWidth(), paint.GetHeight());
+}
+
+static double elapsedUs(const struct timeval& start, const struct timeval& end) {
+  return (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_usec - start.tv_usec);
+}
+
+int main() {
+  printf("#ifndef _EDP_FLOOD_SCREENS_H\n#define _EDP_FLOOD_SCREENS_H\n\n");
+  printf("// Generated by FontTools/screenpack, do not edit.\n");
+  printf("// Each display template's background with its static text, 128x296px\n");
+
+  for (const screen& s : screens) {
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    for (int r = 0; r < REPEATS; r++) {
+      partialBytes = 0;
+      drawStaticText(s);
+    }
+    gettimeofday(&end, NULL);
+
+    memcpy(frame, s.background, sizeof(frame));
+    drawStaticText(s);
+    printf("\nconst unsigned char epd_screen_%s[] PROGMEM = {", s.name);
+    for (int i = 0; i < FRAME_BYTES; i++) {
+      printf("%s0x%02x,", i % 16 ? " " : "\n\t", frame[i]);
+    }
+    printf("\n};\n");
+    fprintf(stderr, "%s: \"%s\", %ld SPI bytes and %.1f us of text rendering saved per refresh\n", s.name,
+            s.message, partialBytes, elapsedUs(start, end) / REPEATS);
+  }
+  printf("\n#endif\n");
+  return 0;
+}
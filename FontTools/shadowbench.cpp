@@ -0,0 +1,176 @@
+/*
+  Check the driver's panel RAM shadow over a simulated day
+
+  Replays a day of Magnet display updates through the real driver into
+  mockpanel: full refreshes for a new screen, for a spent ghosting
+  budget and after deep sleep and a power cut, a re-issued warning
+  redrawn with partials, an hour of API errors drawn over the screen
+  at every poll, chart columns and the relative age. Every write asked
+  of the driver is also applied to a model of the panel RAM, which has
+  to match the mock panel after every update however many uploads the
+  shadow skipped. The SPI bytes sent and the image bytes skipped are
+  reported.
+
+  Usage: make shadowbench
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "epd2in9_V2.h"
+#include "epdpaint.h"
+#include "mockpanel.h"
+#include "img/flood_screens.h"
+
+#define COLORED 0
+#define UNCOLORED 1
+#define DAY_MINUTES (24 * 60)
+#define POLL_MINUTES 15
+#define CHART_Y 80
+
+static Epd<Panel2in9> epd;
+static unsigned char image[1024];
+static unsigned char chartImage[120 / 8 * 24];
+static uint8_t expected[2][PANEL_BYTES];
+static bool overdrawn;
+
+// Write a strip to the panel and the model alike
+static void strip(const unsigned char* buffer, int x, int y, int width, int height) {
+  epd.SetFrameMemory_Partial(buffer, x, y, width, height);
+  for (int j = 0; j < height && y + j < PANEL_ROWS; j++) {
+    memcpy(&expected[0][(y + j) * PANEL_ROW_BYTES + x / 8], &buffer[j * (width / 8)], width / 8);
+  }
+}
+
+static void text(int y, int height, const char* line1, const char* line2, sFONT* font) {
+  Paint paint(image, 120, height);
+  paint.SetRotate(ROTATE_180);
+  paint.Clear(UNCOLORED);
+  paint.DrawStringAt(0, 0, line1, font, COLORED);
+  if (line2) {
+    paint.DrawStringAt(0, 14, line2, font, COLORED);
+  }
+  strip(paint.GetImage(), 0, y, paint.GetWidth(), paint.GetHeight());
+}
+
+static void drawTime(int age) {
+  char ageStr[20];
+  if (age < 60) {
+    snprintf(ageStr, sizeof(ageStr), "%d min ago", age);
+  } else {
+    snprintf(ageStr, sizeof(ageStr), "%d hr ago", age / 60);
+  }
+  text(20, 40, "2022-12-19 06:00", ageStr, &Font12);
+}
+
+static int chartY(int minute) {
+  return 12 + (minute / POLL_MINUTES * 7) % 11 - 5;
+}
+
+static void drawChartColumn(Paint* paint, int minute) {
+  int col = minute / POLL_MINUTES % 119 + 1;
+  paint->DrawVerticalSpan(col, 0, 23, UNCOLORED);
+  paint->DrawVerticalSpan(col, chartY(minute - POLL_MINUTES), chartY(minute), COLORED);
+}
+
+// Timestamp, status and chart over the screen, as updateDisplay()
+static void drawFields(int minute, int age) {
+  Paint chart(chartImage, 120, 24);
+  chart.SetRotate(ROTATE_180);
+  chart.Clear(UNCOLORED);
+  for (int m = POLL_MINUTES; m <= minute; m += POLL_MINUTES) {
+    drawChartColumn(&chart, m);
+  }
+  strip(chart.GetImage(), 0, CHART_Y, chart.GetWidth(), chart.GetHeight());
+  drawTime(age);
+  text(0, 40, "Wifi", NULL, &Font16);
+  epd.DisplayFrame_Partial();
+}
+
+static void fullUpdate(const unsigned char* screen, int minute, int age) {
+  epd.Init();
+  epd.SetFrameMemory_Base(screen);
+  epd.DisplayFrame();
+  memcpy(expected[0], screen, PANEL_BYTES);
+  memcpy(expected[1], screen, PANEL_BYTES);
+  overdrawn = false;
+  drawFields(minute, age);
+}
+
+static void partialUpdate(const unsigned char* screen, int minute, int age) {
+  if (overdrawn) {
+    strip(screen, 0, 0, EPD_WIDTH, EPD_HEIGHT);
+    overdrawn = false;
+  }
+  drawFields(minute, age);
+}
+
+// Same slice upload as LevelChart::uploadColumn
+static void chartUpdate(int minute) {
+  Paint chart(chartImage, 120, 24);
+  chart.SetRotate(ROTATE_180);
+  drawChartColumn(&chart, minute);
+  int byteCol = (120 - (minute / POLL_MINUTES % 119 + 1)) / 8;
+  unsigned char slice[24];
+  for (int row = 0; row < 24; row++) {
+    slice[row] = chartImage[row * 15 + byteCol];
+  }
+  strip(slice, byteCol * 8, CHART_Y, 8, 24);
+  epd.DisplayFrame_Partial();
+}
+
+static void apiError(void) {
+  text(140, 32, "API", NULL, &Font16);
+  text(120, 32, "Error", NULL, &Font16);
+  text(100, 32, "Data stale", NULL, &Font16);
+  epd.DisplayFrame_Partial();
+  overdrawn = true;
+}
+
+int main() {
+  const unsigned char* screen = epd_screen_warning;
+  int raised = 0;
+  int updates = 0;
+  int bad = 0;
+  panelClearStats();
+  panelPowerCycle();
+  for (int minute = 0; minute < DAY_MINUTES; minute++) {
+    int age = minute - raised;
+    bool outage = minute >= 8 * 60 && minute < 9 * 60;
+    if (minute == 0) {
+      fullUpdate(screen, minute, age);
+    } else if (minute == 6 * 60 || minute == 9 * 60) {  // Re-issued, then back from the outage
+      raised = minute == 6 * 60 ? minute : raised;
+      partialUpdate(screen, minute, minute - raised);
+    } else if (minute == 10 * 60) {  // New severity
+      screen = epd_screen_alert;
+      raised = minute;
+      fullUpdate(screen, minute, 0);
+    } else if (minute == 16 * 60) {  // Ghosting budget spent, same screen
+      fullUpdate(screen, minute, age);
+    } else if (minute == 20 * 60) {  // Slept through a power cut
+      epd.Sleep();
+      panelPowerCycle();
+      fullUpdate(screen, minute, age);
+    } else if (minute % POLL_MINUTES == 0) {
+      if (outage) {
+        apiError();
+      } else {
+        chartUpdate(minute);
+      }
+    } else if (!outage && (age < 60 || age % 60 == 0)) {
+      drawTime(age);
+      epd.DisplayFrame_Partial();
+    } else {
+      continue;
+    }
+    updates++;
+    if (memcmp(expected[0], panelRam[0], PANEL_BYTES) != 0 || memcmp(expected[1], panelRam[1], PANEL_BYTES) != 0) {
+      bad++;
+    }
+  }
+  unsigned long saved = epd.ShadowSavedBytes();
+  printf("%lu SPI bytes/day, %lu image bytes skipped by the shadow (%.1f%% saved)\n", panel.spiBytes, saved,
+         100.0 * saved / (panel.spiBytes + saved));
+  printf("Panel RAM %s after %d of %d updates\n", bad ? "DIFFERS" : "matches", updates - bad, updates);
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,63 @@
+// Host stand-in for the Arduino core, pins and time are simulated by mockpanel.cpp
+#ifndef _ARDUINO_SHIM_H_
+#define _ARDUINO_SHIM_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 2
+#define PIN_SPI_MOSI 11
+#define PIN_SPI_SCK 13
+#define FLASH_SIZE 0x40000UL  // SAMD21G18, from the CMSIS device header
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+void analogWrite(int pin, int value);
+void noInterrupts(void);
+void interrupts(void);
+int digitalPinToInterrupt(int pin);
+void attachInterrupt(int interrupt, void (*isr)(void), int mode);
+void delay(unsigned long ms);
+unsigned long millis(void);
+unsigned long micros(void);
+
+// Serial monitor text, written out through write(). Input comes from
+// available() and read(), which a test overrides.
+class Stream {
+public:
+  virtual int available(void) { return 0; }
+  virtual int read(void) { return -1; }
+  virtual void write(const char* s) { fputs(s, stdout); }
+  void print(const char* s) { write(s); }
+  void print(long n) { printNumber("%ld", n); }
+  void print(unsigned long n) { printNumber("%lu", n); }
+  void print(int n) { print((long)n); }
+  void print(unsigned int n) { print((unsigned long)n); }
+  template <typename T>
+  void println(T value) {
+    print(value);
+    write("\r\n");
+  }
+  void println(void) { write("\r\n"); }
+
+private:
+  template <typename T>
+  void printNumber(const char* format, T n) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), format, n);
+    write(buf);
+  }
+};
+
+extern Stream& Serial;
+
+#endif
@@ -0,0 +1,17 @@
+// Host stand-in for the Arduino network Client interface
+#ifndef _CLIENT_SHIM_H_
+#define _CLIENT_SHIM_H_
+
+#include <Arduino.h>
+
+class Client {
+public:
+  virtual int connect(const char* host, uint16_t port) = 0;
+  virtual size_t write(const uint8_t* buf, size_t size) = 0;
+  virtual int available() = 0;
+  virtual int read(uint8_t* buf, size_t size) = 0;
+  virtual uint8_t connected() = 0;
+  virtual void stop() = 0;
+};
+
+#endif
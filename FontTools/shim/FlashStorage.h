@@ -0,0 +1,44 @@
+// Host stand-in for FlashStorage's FlashClass. Flash is a RAM array
+// indexed by address, as erased flash it reads 0xFF, and like flash a
+// write can only clear bits.
+#ifndef _FLASH_STORAGE_SHIM_H_
+#define _FLASH_STORAGE_SHIM_H_
+
+#include <Arduino.h>
+
+#define FLASH_ROW_SIZE 256
+
+inline uint8_t* flashMemory(void) {
+  static uint8_t* memory = NULL;
+  if (!memory) {
+    memory = (uint8_t*)malloc(FLASH_SIZE);
+    memset(memory, 0xFF, FLASH_SIZE);
+  }
+  return memory;
+}
+
+class FlashClass {
+public:
+  FlashClass(const void* flashAddr = NULL, uint32_t size = 0) : _addr((uintptr_t)flashAddr), _size(size){};
+  // Whole rows, as the NVM controller erases
+  void erase(void) {
+    uintptr_t start = _addr - _addr % FLASH_ROW_SIZE;
+    uintptr_t end = (_addr + _size + FLASH_ROW_SIZE - 1) / FLASH_ROW_SIZE * FLASH_ROW_SIZE;
+    memset(flashMemory() + start, 0xFF, end - start);
+  }
+  void write(const void* data) {
+    for (uint32_t i = 0; i < _size; i++) {
+      flashMemory()[_addr + i] &= ((const uint8_t*)data)[i];
+    }
+  }
+  void read(void* data) { read((const void*)_addr, data, _size); }
+  void read(const volatile void* flashPtr, void* data, uint32_t size) {
+    memcpy(data, flashMemory() + (uintptr_t)flashPtr, size);
+  }
+
+private:
+  uintptr_t _addr;
+  uint32_t _size;
+};
+
+#endif
@@ -0,0 +1,43 @@
+// Host stand-in for ArduinoOTA's InternalStorage on the RAM flash of
+// FlashStorage.h. As on the SAMD21, the new image is staged from the
+// middle of the sketch area and apply() erases the rows it needs at
+// the sketch start and copies it there. The board would then reset,
+// here applied is set and apply() returns.
+#ifndef _INTERNAL_STORAGE_SHIM_H_
+#define _INTERNAL_STORAGE_SHIM_H_
+
+#include <FlashStorage.h>
+
+#define SKETCH_START_ADDRESS 0x2000
+
+class InternalStorageClass {
+public:
+  bool applied = false;
+
+  int open(int length) {
+    FlashClass((const void*)(uintptr_t)stagingAddress(), length).erase();
+    _writeIndex = 0;
+    return 1;
+  }
+  size_t write(uint8_t b) {
+    flashMemory()[stagingAddress() + _writeIndex++] &= b;
+    return 1;
+  }
+  void close(void) {}
+  void clear(void) {}
+  void apply(void) {
+    FlashClass((const void*)SKETCH_START_ADDRESS, _writeIndex).erase();
+    memcpy(flashMemory() + SKETCH_START_ADDRESS, flashMemory() + stagingAddress(), _writeIndex);
+    applied = true;
+  }
+  long maxSize(void) { return (FLASH_SIZE - SKETCH_START_ADDRESS) / 2; }
+
+private:
+  uint32_t _writeIndex = 0;
+
+  uint32_t stagingAddress(void) { return SKETCH_START_ADDRESS + maxSize(); }
+};
+
+extern InternalStorageClass InternalStorage;
+
+#endif
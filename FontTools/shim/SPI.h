@@ -0,0 +1,25 @@
+// Host stand-in for the Arduino SPI library, bytes go to the mock panel
+#ifndef _SPI_SHIM_H_
+#define _SPI_SHIM_H_
+
+#include <stdint.h>
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+struct SPISettings {
+  SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) : clock(clock) {}
+  uint32_t clock;
+};
+
+class SPIClass {
+public:
+  void begin(void) {}
+  void end(void) {}
+  void beginTransaction(SPISettings settings);
+  uint8_t transfer(uint8_t data);
+};
+
+extern SPIClass SPI;
+
+#endif
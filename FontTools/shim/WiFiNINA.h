@@ -0,0 +1,59 @@
+// Host stand-in for WiFiNINA's client. connect() succeeds while a
+// response is set, what is printed to the client is kept as the request
+// and reads come from the response.
+#ifndef _WIFININA_SHIM_H_
+#define _WIFININA_SHIM_H_
+
+#include <Arduino.h>
+#include <string>
+
+class WiFiClient : public Stream {
+public:
+  static std::string& response(void) {
+    static std::string text;
+    return text;
+  }
+  static std::string& request(void) {
+    static std::string text;
+    return text;
+  }
+
+  int connect(const char* host, uint16_t port) {
+    request().clear();
+    _pos = 0;
+    return !response().empty();
+  }
+  int available(void) { return response().size() - _pos; }
+  int read(void) { return _pos < response().size() ? (uint8_t)response()[_pos++] : -1; }
+  void write(const char* s) { request() += s; }
+  size_t readBytes(uint8_t* buf, size_t len) {
+    size_t n = 0;
+    while (n < len && available()) {
+      buf[n++] = read();
+    }
+    return n;
+  }
+  // Up to the terminator, which is dropped
+  size_t readBytesUntil(char end, char* buf, size_t len) {
+    size_t n = 0;
+    while (n < len && available()) {
+      int c = read();
+      if (c == end) {
+        break;
+      }
+      buf[n++] = c;
+    }
+    return n;
+  }
+  bool find(const char* target) {
+    size_t at = response().find(target, _pos);
+    _pos = at == std::string::npos ? response().size() : at + strlen(target);
+    return at != std::string::npos;
+  }
+  void stop(void) {}
+
+private:
+  size_t _pos = 0;
+};
+
+#endif
@@ -0,0 +1,9 @@
+// Host stand-in for the AVR flash accessors, flash is ordinary memory
+#ifndef _PGMSPACE_SHIM_H_
+#define _PGMSPACE_SHIM_H_
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const unsigned char*)(p))
+#define pgm_read_word(p) (*(const unsigned short*)(p))
+
+#endif
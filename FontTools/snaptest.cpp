@@ -0,0 +1,266 @@
+/*
+  Rendered text against PBM snapshots
+
+  Draws the Magnet's text through the real Paint and fonts and compares
+  each image with a plain PBM in snapshots/, one row per line so a diff
+  shows what moved. Images are turned the way the panel is mounted, so
+  the text reads upright. Covered are the greeting and status strips in
+  the proportional Font16, the timestamp and age in Font12, a line of
+  Font16's kerning pairs, and the five warning messages as screenpack
+  draws them: wrapped and centred in the message area, in the screen
+  font subset, and a message with more lines than the area holds.
+  Wrapping is also drawn in narrower boxes, with a forced break and a
+  word wider than its box.
+
+  Each line of ink in a centred image must also be centred. A line may
+  be off by a column from the halving, one from the spacing column after
+  its last glyph and two from ROTATE_180 drawing one pixel over.
+
+  A snapshot that differs is written beside it as NAME.actual.pbm. After
+  a change to the text, fonts or Paint that is meant, look at those and
+  refresh the snapshots with "make snapshots".
+
+  Usage: make snaptest
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "epdpaint.h"
+#include "FloodTime.h"
+
+#define SNAPSHOTS "snapshots/"
+#define MESSAGE_WIDTH 120  // As screenpack
+#define MESSAGE_HEIGHT 56
+#define MAX_WIDTH 120
+#define MAX_HEIGHT 192
+#define MAX_OFF_CENTRE 4
+
+#define COLORED 0
+#define UNCOLORED 1
+
+extern sFONT ScreenFont16;  // screenpack's subset, renamed
+
+unsigned long millis(void) {
+  return 0;
+}
+
+static unsigned char image[MAX_WIDTH / 8 * MAX_HEIGHT];
+
+struct snapshot {
+  const char* name;
+  int width;
+  int height;
+  void (*draw)(Paint* paint, const char* text);
+  const char* text;  // For message bands, which are sized to it
+  bool centred;
+};
+
+// As FloodMagnetDisplay draws the greeting, strips stacked
+static void greeting(Paint* paint, const char*) {
+  static const char* lines[] = { "Flood", "Magnet", "Concept:", "Jude Pullen", "Code:", "Pete Milne" };
+  for (int i = 0; i < 6; i++) {
+    paint->DrawStringCentred(0, i * 32 + (i < 4 ? 4 : 0), paint->GetWidth(), lines[i], &Font16, COLORED);
+  }
+}
+
+static void status(Paint* paint, const char*) {
+  static const char* lines[] = { "Connection", "Error", "API", "Data stale", "Wifi" };
+  for (int i = 0; i < 5; i++) {
+    paint->DrawStringAt(0, i * 20 + 4, lines[i], &Font16, COLORED);
+  }
+}
+
+static void timestamp(Paint* paint, const char*) {
+  static const uint32_t ages[] = { 30, 12 * 60, 3 * 3600 + 5 * 60, 4 * 86400 };
+  char buf[TIME_STR_LEN];
+  formatTime(1671463231UL, buf);  // 2022-12-19T15:20:31Z
+  paint->DrawStringAt(0, 0, buf, &Font12, COLORED);
+  for (int i = 0; i < 4; i++) {
+    char age[AGE_STR_LEN];
+    formatAge(ages[i], age, sizeof(age));
+    paint->DrawStringAt(0, 14 * (i + 1), age, &Font12, COLORED);
+  }
+}
+
+static void kerning(Paint* paint, const char*) {
+  paint->DrawStringAt(0, 2, "Ja Ju Wi fi rA", &Font16, COLORED);
+  paint->DrawStringAt(0, 22, "y. yJ Jude Wifi", &Font16, COLORED);
+}
+
+// The message band as screenpack sizes and draws it
+static void message(Paint* paint, const char* text) {
+  paint->DrawStringCentred(0, 0, MESSAGE_WIDTH, text, &ScreenFont16, COLORED);
+}
+
+static int bandHeight(const char* text) {
+  Paint paint(image, MESSAGE_WIDTH, MAX_HEIGHT);
+  int lineHeight = ScreenFont16.Height + LINE_SPACING;
+  int lines = paint.CountLines(text, &ScreenFont16, MESSAGE_WIDTH);
+  if (lines * lineHeight - LINE_SPACING > MESSAGE_HEIGHT) {
+    lines = (MESSAGE_HEIGHT + LINE_SPACING) / lineHeight;
+  }
+  return lines * lineHeight - LINE_SPACING;
+}
+
+// Narrower boxes, a forced break and a word wider than its box
+static void wrapped(Paint* paint, const char*) {
+  paint->DrawStringCentred(0, 0, 80, "Warning no Longer in Force", &ScreenFont16, COLORED);
+  paint->DrawStringCentred(0, 80, 120, "Flooding\nis Possible", &ScreenFont16, COLORED);
+  paint->DrawStringCentred(0, 120, 40, "Flooding", &ScreenFont16, COLORED);
+}
+
+static snapshot snapshots[] = {
+  { "greeting", 120, 192, greeting, NULL, true },
+  { "status", 120, 104, status, NULL, false },
+  { "time", 120, 72, timestamp, NULL, false },
+  { "kerning", 120, 40, kerning, NULL, false },
+  { "no_warnings", MESSAGE_WIDTH, 0, message, "No Flood Warnings", true },
+  { "severe", MESSAGE_WIDTH, 0, message, "DANGER TO LIFE", true },
+  { "warning", MESSAGE_WIDTH, 0, message, "Flooding is Expected", true },
+  { "alert", MESSAGE_WIDTH, 0, message, "Flooding is Possible", true },
+  { "removed", MESSAGE_WIDTH, 0, message, "Warning no Longer in Force", true },
+  { "overflow", MESSAGE_WIDTH, 0, message, "Flood Warning Flood Warning Flood Warning Flood Warning", true },
+  { "wrapped", 120, 160, wrapped, NULL, false },
+};
+
+// As the panel shows it: ROTATE_180 buffers are mounted upside down
+static bool black(const snapshot& s, int x, int y) {
+  int ax = s.width - 1 - x;
+  int ay = s.height - 1 - y;
+  return !(image[(ax + ay * s.width) / 8] & (0x80 >> (ax % 8)));
+}
+
+static std::string render(snapshot& s) {
+  if (s.text) {
+    s.height = bandHeight(s.text);
+  }
+  Paint paint(image, s.width, s.height);
+  paint.SetRotate(ROTATE_180);
+  paint.Clear(UNCOLORED);
+  s.draw(&paint, s.text);
+
+  std::string pbm = "P1\n" + std::to_string(s.width) + " " + std::to_string(s.height) + "\n";
+  for (int y = 0; y < s.height; y++) {
+    for (int x = 0; x < s.width; x++) {
+      pbm += black(s, x, y) ? '1' : '0';
+    }
+    pbm += '\n';
+  }
+  return pbm;
+}
+
+// Each run of inked rows is a line, its margins must match
+static int offCentre(const snapshot& s) {
+  int worst = 0;
+  for (int y = 0; y < s.height;) {
+    int left = s.width, right = -1, top = y;
+    for (; y < s.height; y++) {
+      int rowLeft = s.width, rowRight = -1;
+      for (int x = 0; x < s.width; x++) {
+        if (black(s, x, y)) {
+          rowLeft = x < rowLeft ? x : rowLeft;
+          rowRight = x;
+        }
+      }
+      if (rowRight < 0) {
+        break;
+      }
+      left = rowLeft < left ? rowLeft : left;
+      right = rowRight > right ? rowRight : right;
+    }
+    if (y == top) {
+      y++;
+    } else {
+      int off = abs(left - (s.width - 1 - right));
+      worst = off > worst ? off : worst;
+    }
+  }
+  return worst;
+}
+
+static std::string readFile(const std::string& path) {
+  std::string data;
+  FILE* f = fopen(path.c_str(), "rb");
+  char buf[4096];
+  size_t n;
+  while (f && (n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    data.append(buf, n);
+  }
+  if (f) {
+    fclose(f);
+  }
+  return data;
+}
+
+static bool writeFile(const std::string& path, const std::string& data) {
+  FILE* f = fopen(path.c_str(), "wb");
+  bool ok = f && fwrite(data.data(), 1, data.size(), f) == data.size();
+  return f && fclose(f) == 0 && ok;
+}
+
+static int inked(const std::string& pbm) {
+  int n = 0;
+  for (size_t i = pbm.find('\n', 3) + 1; i < pbm.size(); i++) {
+    n += pbm[i] == '1';
+  }
+  return n;
+}
+
+static int differing(const std::string& a, const std::string& b) {
+  int n = 0;
+  for (size_t i = 0; i < a.size(); i++) {
+    n += a[i] != b[i];
+  }
+  return n;
+}
+
+int main(int argc, char* argv[]) {
+  bool update = argc == 2 && strcmp(argv[1], "-u") == 0;
+  if (argc > 1 && !update) {
+    fprintf(stderr, "Usage: %s [-u]\n", argv[0]);
+    return 1;
+  }
+
+  int bad = 0;
+  for (snapshot& s : snapshots) {
+    std::string path = SNAPSHOTS + std::string(s.name);
+    std::string pbm = render(s);
+    int off = s.centred ? offCentre(s) : 0;
+    printf("%-13s %3dx%-3d %5d pixels inked", s.name, s.width, s.height, inked(pbm));
+    if (s.centred) {
+      printf(", lines off centre by %d at most", off);
+    }
+    if (update) {
+      if (!writeFile(path + ".pbm", pbm)) {
+        printf("\nFAIL writing %s.pbm\n", path.c_str());
+        return 1;
+      }
+      remove((path + ".actual.pbm").c_str());
+      printf(", updated\n");
+    } else {
+      std::string want = readFile(path + ".pbm");
+      if (want.empty()) {
+        printf(", no snapshot\n");
+      } else if (want.size() != pbm.size()) {
+        printf(", size differs\n");
+      } else if (want != pbm) {
+        printf(", %d pixels differ\n", differing(want, pbm));
+      } else {
+        printf(", matches\n");
+        remove((path + ".actual.pbm").c_str());
+      }
+      if (want != pbm) {
+        printf("FAIL %s differs from %s.pbm, see %s.actual.pbm\n", s.name, path.c_str(), path.c_str());
+        writeFile(path + ".actual.pbm", pbm);
+        bad++;
+      }
+    }
+    if (off > MAX_OFF_CENTRE) {
+      printf("FAIL %s has a line %d pixels off centre, want at most %d\n", s.name, off, MAX_OFF_CENTRE);
+      bad++;
+    }
+  }
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+/*
+  Warning state machine, every transition checked
+
+  Walks all 36 [previous][next] cells of transitionTable against the
+  actions written out by hand below, so an edit to enterActions or
+  pickAction that changes what a device does shows up as a named cell.
+  Also checks toLevel() on API values in and out of range, and that the
+  demo cycle visits every reported level and comes back to NONE.
+  FloodStates.h carries compile-time checks of its own, this is the
+  full table.
+
+  Usage: make statebench
+*/
+
+#include <stdio.h>
+#include "FloodStates.h"
+
+static const char* const levelNames[NUM_LEVELS] = {
+  "NONE", "SEVERE", "WARNING", "ALERT", "NO_LONGER", "INIT"
+};
+
+// What each device should do on entering a level from another
+struct expected {
+  uint8_t led;
+  uint8_t buzzer;
+  uint8_t display;
+  uint8_t animation;
+};
+
+static const expected entering[NUM_LEVELS] = {
+  { LED_KEEP, BUZZ_KEEP, TPL_NO_WARNING, ANIM_BIT_VSLOW },
+  { LED_RED, BUZZ_ON, TPL_SEVERE, ANIM_LOT_VFAST },
+  { LED_RED, BUZZ_ON, TPL_WARNING, ANIM_BIT_FAST },
+  { LED_AMBER, BUZZ_ON, TPL_ALERT, ANIM_BIT_SLOW },
+  { LED_GREEN, BUZZ_KEEP, TPL_NO_LONGER, ANIM_BIT_VSLOW },
+  { LED_KEEP, BUZZ_KEEP, TPL_NO_WARNING, ANIM_START },
+};
+
+static int checkCell(int prev, int next) {
+  const stateAction& got = transition((warning_levels)prev, (warning_levels)next);
+  expected want = entering[next];
+  if (prev == next) {
+    // A repeat poll leaves the indicators alone
+    want.led = LED_KEEP;
+    want.buzzer = BUZZ_KEEP;
+  }
+  if (got.led == want.led && got.buzzer == want.buzzer && got.display == want.display &&
+      got.animation == want.animation && got.track == next) {
+    return 0;
+  }
+  printf("FAIL %-9s -> %-9s led %d/%d buzzer %d/%d display %d/%d animation %d/%d track %d/%d\n",
+         levelNames[prev], levelNames[next], got.led, want.led, got.buzzer, want.buzzer,
+         got.display, want.display, got.animation, want.animation, got.track, next);
+  return 1;
+}
+
+static int checkTable(void) {
+  int bad = 0;
+  int sounding = 0;
+  for (int prev = 0; prev < NUM_LEVELS; prev++) {
+    for (int next = 0; next < NUM_LEVELS; next++) {
+      bad += checkCell(prev, next);
+      sounding += transition((warning_levels)prev, (warning_levels)next).buzzer == BUZZ_ON;
+    }
+  }
+  printf("Transitions   %d cells, %d sound the buzzer, %d wrong\n", NUM_LEVELS * NUM_LEVELS, sounding, bad);
+  return bad;
+}
+
+struct levelCase {
+  int api;
+  warning_levels level;
+};
+
+static const levelCase levelCases[] = {
+  { 0, NONE },
+  { 1, SEVERE_FLOOD_WARNING },
+  { 2, FLOOD_WARNING },
+  { 3, FLOOD_ALERT },
+  { 4, NO_LONGER },
+  { 5, NONE },  // INIT is never reported
+  { 6, NONE },
+  { 99, NONE },
+  { -1, NONE },
+  { -2147483647 - 1, NONE },
+};
+
+static int checkToLevel(void) {
+  int n = sizeof(levelCases) / sizeof(levelCases[0]);
+  int bad = 0;
+  for (int i = 0; i < n; i++) {
+    if (toLevel(levelCases[i].api) != levelCases[i].level) {
+      printf("FAIL toLevel(%d) = %d, want %d\n", levelCases[i].api, toLevel(levelCases[i].api), levelCases[i].level);
+      bad++;
+    }
+  }
+  printf("toLevel       %d values, %d wrong\n", n, bad);
+  return bad;
+}
+
+static int checkDemo(void) {
+  static const warning_levels cycle[] = { FLOOD_ALERT, FLOOD_WARNING, SEVERE_FLOOD_WARNING, NO_LONGER, NONE };
+  warning_levels state = NONE;
+  int bad = 0;
+  for (unsigned i = 0; i < sizeof(cycle) / sizeof(cycle[0]); i++) {
+    state = demoNext[state];
+    if (state != cycle[i]) {
+      printf("FAIL demo step %u is %s, want %s\n", i + 1, levelNames[state], levelNames[cycle[i]]);
+      bad++;
+    }
+  }
+  if (demoNext[INIT] != NONE) {
+    printf("FAIL demo from INIT goes to %s\n", levelNames[demoNext[INIT]]);
+    bad++;
+  }
+  printf("Demo cycle    %d wrong\n", bad);
+  return bad;
+}
+
+int main() {
+  int bad = checkTable();
+  bad += checkToLevel();
+  bad += checkDemo();
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+/*
+  ISO 8601 and HTTP-Date parsing, checked and timed
+
+  Parses a table of timeRaised and Date header strings, good and bad,
+  against their known epochs, then formats every minute boundary from
+  a sweep of epochs across 1970-2106 and parses it back. The parse
+  time is against what getData() did per poll before, copying the raw
+  string and replacing the 'T', and the SAMD21 time is the host time
+  scaled by CPU_SCALE, as bandbench.
+
+  Usage: make timebench
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "FloodTime.h"
+
+#define CPU_SCALE 60
+#define REPEATS 200000
+#define DATESTR_LEN 17
+
+unsigned long millis(void) {
+  return 0;
+}
+
+struct isoCase {
+  const char* str;
+  bool ok;
+  uint32_t epoch;
+};
+
+static const isoCase isoCases[] = {
+  { "2022-12-19T15:20:31", true, 1671463231UL },
+  { "2022-12-19 15:20:31", true, 1671463231UL },
+  { "2022-12-19T15:20:31Z", true, 1671463231UL },
+  { "2022-12-19T15:20:31.250Z", true, 1671463231UL },
+  { "2022-12-19T16:20:31+01:00", true, 1671463231UL },
+  { "2022-12-19T09:50:31-05:30", true, 1671463231UL },
+  { "2022-12-19T16:20:31+0100", true, 1671463231UL },
+  { "1970-01-01T00:00:00", true, 0 },
+  { "2000-03-01T00:00:00", true, 951868800UL },
+  { "2024-02-29T23:59:59", true, 1709251199UL },
+  { "2106-02-07T06:28:15", true, 4294967295UL },
+  { "2023-01-01T00:01:00", true, 1672531260UL },
+  { "1969-12-31T23:59:59", false, 0 },
+  { "2022-13-19T15:20:31", false, 0 },
+  { "2022-12-32T15:20:31", false, 0 },
+  { "2022-12-19T24:00:00", false, 0 },
+  { "2022-12-19T15:60:00", false, 0 },
+  { "2022-12-19", false, 0 },
+  { "2022-12-19T15:20", false, 0 },
+  { "2022/12/19T15:20:31", false, 0 },
+  { "22-12-19T15:20:31", false, 0 },
+  { "2022-12-19T15:20:31+1", false, 0 },
+  { "", false, 0 },
+  { NULL, false, 0 },
+};
+
+static const isoCase httpCases[] = {
+  { "Sun, 06 Nov 1994 08:49:37 GMT", true, 784111777UL },
+  { "Mon, 19 Dec 2022 15:20:31 GMT", true, 1671463231UL },
+  { "Mon,  19 Dec 2022 15:20:31 GMT", true, 1671463231UL },
+  { "Mon, 19 Dex 2022 15:20:31 GMT", false, 0 },
+  { "19 Dec 2022 15:20:31 GMT", false, 0 },
+  { "Mon, 19 Dec 22 15:20:31 GMT", false, 0 },
+  { NULL, false, 0 },
+};
+
+static int check(const char* name, const isoCase* cases, int count, bool (*parse)(const char*, uint32_t*)) {
+  int bad = 0;
+  for (int i = 0; i < count; i++) {
+    uint32_t epoch = 0;
+    bool ok = parse(cases[i].str, &epoch);
+    if (ok != cases[i].ok || (ok && epoch != cases[i].epoch)) {
+      printf("  %s(\"%s\") = %s %lu, expected %s %lu\n", name, cases[i].str ? cases[i].str : "NULL", ok ? "true" : "false",
+             (unsigned long)epoch, cases[i].ok ? "true" : "false", (unsigned long)cases[i].epoch);
+      bad++;
+    }
+  }
+  printf("%-13s %2d of %2d cases as expected\n", name, count - bad, count);
+  return bad;
+}
+
+// Every formatted minute parses back to itself
+static int roundTrip(void) {
+  int bad = 0;
+  int count = 0;
+  for (uint64_t e = 0; e <= 4294967295ULL - 86400; e += 86400 * 7 + 3661) {
+    char buf[TIME_STR_LEN + 3];
+    formatTime((uint32_t)e, buf);
+    strcat(buf, ":00");
+    uint32_t back;
+    if (!parseIsoTime(buf, &back) || back != e - e % 60) {
+      bad++;
+    }
+    count++;
+  }
+  printf("Round trip    %d of %d formatted times parse back\n", count - bad, count);
+  return bad;
+}
+
+static double elapsedNs(struct timespec start, struct timespec end) {
+  return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / REPEATS;
+}
+
+static void throughput(void) {
+  static char raised[] = "2022-12-19T15:20:31";
+  volatile uint32_t sink = 0;
+  struct timespec start, end;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    uint32_t epoch;
+    raised[18] = '0' + r % 10;
+    parseIsoTime(raised, &epoch);
+    sink = sink + epoch;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double parseNs = elapsedNs(start, end);
+
+  // As getData() did: copy the string and swap the 'T' for a space
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    char timeRaised[DATESTR_LEN];
+    raised[18] = '0' + r % 10;
+    memcpy(timeRaised, raised, DATESTR_LEN - 1);
+    timeRaised[DATESTR_LEN - 1] = '\0';
+    for (int i = 0; i < DATESTR_LEN; i++) {
+      if (timeRaised[i] == 'T') {
+        timeRaised[i] = ' ';
+      }
+    }
+    sink = sink + timeRaised[15];
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double copyNs = elapsedNs(start, end);
+
+  printf("parseIsoTime  %6.1f ns on the host, %5.2f us on the SAMD21, %.1f M parses/s\n", parseNs,
+         parseNs * CPU_SCALE / 1e3, 1e3 / parseNs);
+  printf("Old copy      %6.1f ns on the host, %5.2f us on the SAMD21\n", copyNs, copyNs * CPU_SCALE / 1e3);
+}
+
+int main() {
+  int bad = check("parseIsoTime", isoCases, sizeof(isoCases) / sizeof(isoCases[0]), parseIsoTime);
+  bad += check("parseHttpDate", httpCases, sizeof(httpCases) / sizeof(httpCases[0]), parseHttpDate);
+  bad += roundTrip();
+  throughput();
+  return bad ? 1 : 0;
+}
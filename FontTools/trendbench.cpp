@@ -0,0 +1,237 @@
+/*
+  LevelTrend early warning, replayed over river level series
+
+  Replays 15 minute level series through LevelTrend and the same test
+  as checkTrend(): an early Flood Alert while the level is predicted to
+  reach the alert level within TREND_HORIZON, rising at TREND_MIN_RATE
+  or more. Reports, for each series, the lead time before the level
+  first reached the alert and any early alerts that came to nothing.
+
+  The built in series are synthetic: a slow winter flood, a flash
+  flood, a flood with a gap in the readings, a rain bump that peaks
+  under the alert, a tidal reach and a single bad reading. Recorded
+  readings can be replayed instead, as the API's CSV gives them:
+
+    curl ".../id/stations/1491TH/readings.csv?_sorted&since=..." > river.csv
+    ./trendbench 1350 river.csv
+
+  with the alert level in mm. Rows are dateTime,...,value in metres.
+
+  The run fails if a flood is reached without an early alert TREND_LEAD
+  ahead of it. It also fails if TREND_BUZZER is defined in
+  magnet_config.h while any series raised a false alert, because then
+  the buzzer would sound for nothing.
+
+  Usage: make trendbench
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "magnet_config.h"
+#include "FloodTime.h"
+#include "LevelTrend.h"
+
+#define STEP (15 * 60)
+#define TREND_LEAD (60 * 60UL)  // Least useful warning, in seconds
+#define LINE_LEN 256
+
+unsigned long millis(void) {
+  return 0;
+}
+
+struct reading {
+  uint32_t time;
+  int32_t level;  // mm
+};
+
+struct series {
+  const char* name;
+  int32_t alert;  // mm
+  std::vector<reading> readings;
+};
+
+static const uint32_t T0 = 1671408000UL;  // 2022-12-19 00:00
+
+// Smooth step from 0 to 1 centred on hour mid, over about width hours
+static double rise(double hours, double mid, double width) {
+  return 1 / (1 + exp(-(hours - mid) * 4 / width));
+}
+
+static double noise(int i) {
+  return (double)((i * 2654435761u) >> 28) - 8;  // +-8 mm
+}
+
+static series make(const char* name, int32_t alert, int days, double (*level)(double hours, int i)) {
+  series s;
+  s.name = name;
+  s.alert = alert;
+  for (int i = 0; i < days * 96; i++) {
+    double hours = i * STEP / 3600.0;
+    s.readings.push_back({ T0 + (uint32_t)i * STEP, (int32_t)lround(level(hours, i)) });
+  }
+  return s;
+}
+
+// 1.2 m over a day and a half, peaking on day 3
+static double winter(double h, int i) {
+  return 600 + 1200 * rise(h, 48, 18) * (1 - rise(h, 72, 12)) + noise(i);
+}
+
+// 0.9 m in about 3 hours
+static double flash(double h, int i) {
+  return 450 + 900 * rise(h, 30, 3) * (1 - rise(h, 40, 6)) + noise(i);
+}
+
+// Peaks 0.3 m under the alert
+static double bump(double h, int i) {
+  return 600 + 450 * rise(h, 24, 5) * (1 - rise(h, 34, 6)) + noise(i);
+}
+
+// +-0.35 m semi-diurnal tide, never near the alert
+static double tidal(double h, int i) {
+  return 700 + 350 * sin(h * 2 * M_PI / 12.42) + noise(i);
+}
+
+// Steady river with one reading 0.5 m high, still under the alert
+static double spike(double h, int i) {
+  return 600 + noise(i) + (i == 100 ? 500 : 0);
+}
+
+static void addSynthetic(std::vector<series>* all) {
+  all->push_back(make("winter flood", 1400, 4, winter));
+  all->push_back(make("flash flood", 1100, 3, flash));
+  series gap = make("flood, 4 hr gap", 1400, 4, winter);
+  gap.readings.erase(gap.readings.begin() + 40 * 4, gap.readings.begin() + 44 * 4);
+  all->push_back(gap);
+  all->push_back(make("rain bump", 1350, 3, bump));
+  all->push_back(make("tidal reach", 1350, 4, tidal));
+  all->push_back(make("bad reading", 1200, 2, spike));
+}
+
+// "2023-01-01T00:15:00Z,http://...,0.612", header and bad rows skipped
+static bool loadCsv(const char* path, int32_t alert, std::vector<series>* all) {
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  series s;
+  s.name = path;
+  s.alert = alert;
+  char line[LINE_LEN];
+  while (fgets(line, sizeof(line), f)) {
+    char* comma = strchr(line, ',');
+    char* last = strrchr(line, ',');
+    uint32_t time;
+    if (!comma) {
+      continue;
+    }
+    *comma = '\0';
+    if (!parseIsoTime(line, &time)) {
+      continue;
+    }
+    s.readings.push_back({ time, (int32_t)lround(atof(last + 1) * 1000) });
+  }
+  fclose(f);
+  // The API sorts newest first
+  if (s.readings.size() > 1 && s.readings[0].time > s.readings[1].time) {
+    std::vector<reading> oldest(s.readings.rbegin(), s.readings.rend());
+    s.readings.swap(oldest);
+  }
+  all->push_back(s);
+  return !s.readings.empty();
+}
+
+struct result {
+  int floods = 0;        // Times the level reached the alert
+  int warned = 0;        // Of those, with TREND_LEAD or more
+  long minLead = -1;     // Shortest lead, seconds
+  int falseAlerts = 0;   // Early alerts that came to nothing
+};
+
+// An early alert is false if it is withdrawn before the level reaches
+// the alert, or still waiting for it a horizon later at the end
+static result replay(const series& s) {
+  LevelTrend trend;
+  trend.reset();
+  result r;
+  bool early = false;
+  bool above = false;
+  bool flooded = false;  // During this early alert
+  uint32_t raised = 0;
+  for (const reading& rd : s.readings) {
+    trend.update(rd.time, rd.level);
+    uint32_t secs;
+    bool now = trend.timeTo(s.alert, TREND_MIN_RATE, &secs) && secs < TREND_HORIZON;
+    if (now && !early) {
+      raised = rd.time;
+      flooded = false;
+    } else if (!now && early && !flooded) {
+      r.falseAlerts++;
+    }
+    early = now;
+    if (rd.level >= s.alert && !above) {
+      long lead = early ? (long)(rd.time - raised) : 0;
+      r.floods++;
+      r.warned += lead >= (long)TREND_LEAD;
+      r.minLead = r.minLead < 0 || lead < r.minLead ? lead : r.minLead;
+      flooded = true;
+    }
+    above = rd.level >= s.alert;
+  }
+  if (early && !flooded && s.readings.back().time - raised > TREND_HORIZON) {
+    r.falseAlerts++;
+  }
+  return r;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<series> all;
+  if (argc == 3) {
+    if (!loadCsv(argv[2], atoi(argv[1]), &all)) {
+      return 1;
+    }
+  } else if (argc == 1) {
+    addSynthetic(&all);
+  } else {
+    fprintf(stderr, "Usage: %s [alert_mm readings.csv]\n", argv[0]);
+    return 1;
+  }
+
+  printf("Horizon %lu min, min rate %d mm/hr, lead wanted %lu min\n", (unsigned long)(TREND_HORIZON) / 60,
+         TREND_MIN_RATE, TREND_LEAD / 60);
+  int late = 0;
+  int falseAlerts = 0;
+  for (const series& s : all) {
+    result r = replay(s);
+    printf("%-20s %4zu readings, alert %5d mm", s.name, s.readings.size(), s.alert);
+    if (r.floods) {
+      printf(", %d flood, lead %3ld min", r.floods, r.minLead / 60);
+    } else {
+      printf(", no flood             ");
+    }
+    printf(", %d false alerts\n", r.falseAlerts);
+    late += r.floods - r.warned;
+    falseAlerts += r.falseAlerts;
+  }
+
+  int bad = 0;
+  if (late) {
+    printf("FAIL %d floods reached with less than %lu min warning\n", late, TREND_LEAD / 60);
+    bad++;
+  }
+#ifdef TREND_BUZZER
+  if (falseAlerts) {
+    printf("FAIL TREND_BUZZER is set but %d early alerts were false, the buzzer would sound for them\n", falseAlerts);
+    bad++;
+  }
+#else
+  printf("Early alerts light the LEDs only, %s\n",
+         falseAlerts ? "false alerts were raised, leave TREND_BUZZER unset"
+                     : "no false alerts, TREND_BUZZER may be set for these series");
+#endif
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+/*
+  Update latency of each waveform against panel temperature
+
+  Runs the Magnet's timestamp strip through the real driver into
+  mockpanel at a range of panel temperatures, once with the standard
+  partial waveform and once with the fast one updateAge() uses, and
+  prints what Epd::UpdateMs() reports for each along with a full
+  refresh. The mock drives a partial update for as many frames as the
+  loaded waveform holds, so the stretch in the cold shows up here.
+
+  Usage: make wavebench
+*/
+
+#include <stdio.h>
+#include "epd2in9_V2.h"
+#include "epdpaint.h"
+#include "mockpanel.h"
+
+#define COLORED 0
+#define UNCOLORED 1
+
+static const int temperatures[] = { 0, 10, 22, 35 };
+
+static Epd<Panel2in9> epd;
+static unsigned char image[1024];
+
+static unsigned long partialUpdate(Paint* paint, int waveform) {
+  epd.SetWaveform(waveform);
+  epd.SetFrameMemory_Partial(paint->GetImage(), 0, 20, paint->GetWidth(), paint->GetHeight());
+  epd.DisplayFrame_Partial();
+  return epd.UpdateMs(waveform);
+}
+
+int main() {
+  Paint paint(image, 120, 40);
+  paint.SetRotate(ROTATE_180);
+  paint.Clear(UNCOLORED);
+  paint.DrawStringAt(0, 0, "2022-12-19 15:20", &Font12, COLORED);
+  paint.DrawStringAt(0, 14, "12 min ago", &Font12, COLORED);
+
+  printf("Panel    partial      fast      full\n");
+  for (int t : temperatures) {
+    panelTemperature = t;
+    epd.Init();  // Reads the temperature
+    epd.DisplayFrame();
+    unsigned long partial = partialUpdate(&paint, WAVEFORM_PARTIAL);
+    unsigned long fast = partialUpdate(&paint, WAVEFORM_FAST);
+    printf("%3d C  %6lu ms  %5lu ms  %5lu ms\n", t, partial, fast, epd.UpdateMs(WAVEFORM_FULL));
+  }
+  return 0;
+}